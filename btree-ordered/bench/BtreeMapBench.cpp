@@ -0,0 +1,96 @@
+#include <proposed/btree_map>
+#include <proposed/map>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// The 100M-key runs need tens of gigabytes (mostly for proposed::map); skip
+// them with --benchmark_filter='/[0-9]{1,7}$' on smaller machines.
+
+namespace {
+std::vector<std::uint64_t> makeKeys(std::size_t count) {
+  std::mt19937_64 rng{count};
+  std::vector<std::uint64_t> result(count);
+  for (auto& key : result) {
+    key = rng();
+  }
+  return result;
+}
+
+template <typename Map>
+Map makeMap(std::vector<std::uint64_t> const& keys) {
+  Map result;
+  for (auto key : keys) {
+    result.try_emplace(key, key);
+  }
+  return result;
+}
+
+template <typename Map>
+void BM_Find(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  auto const map = makeMap<Map>(keys);
+  std::mt19937_64 rng{1};
+  std::uniform_int_distribution<std::size_t> pick{0, keys.size() - 1};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(keys[pick(rng)]));
+  }
+}
+
+template <typename Map>
+void BM_RandomInsert(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  for (auto _ : state) {
+    auto map = makeMap<Map>(keys);
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+void BM_SortedHintedInsert(benchmark::State& state) {
+  auto keys = makeKeys(state.range(0));
+  std::sort(keys.begin(), keys.end());
+  for (auto _ : state) {
+    Map map;
+    for (auto key : keys) {
+      map.try_emplace(map.end(), key, key);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+void BM_Iterate(benchmark::State& state) {
+  auto const map = makeMap<Map>(makeKeys(state.range(0)));
+  for (auto _ : state) {
+    std::uint64_t total = 0;
+    for (auto const& entry : map) {
+      total += entry.second;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void keyCounts(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Arg(1 << 10)->Arg(1 << 20)->Arg(100000000);
+}
+
+using StdMap = proposed::map<std::uint64_t, std::uint64_t>;
+using BtreeMap = proposed::btree_map<std::uint64_t, std::uint64_t>;
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Find, StdMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_Find, BtreeMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_RandomInsert, StdMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_RandomInsert, BtreeMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_SortedHintedInsert, StdMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_SortedHintedInsert, BtreeMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_Iterate, StdMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_Iterate, BtreeMap)->Apply(keyCounts);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,1101 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <proposed/adaptor>
+#include <proposed/iterator>
+
+namespace proposed {
+namespace detail {
+// Raw storage for `N` objects of type `T`, constructed and destroyed by hand
+template <typename T, std::size_t N>
+struct btree_slots {
+  T* at(std::size_t i) {
+    return std::launder(reinterpret_cast<T*>(storage_) + i);
+  }
+  T const* at(std::size_t i) const {
+    return std::launder(reinterpret_cast<T const*>(storage_) + i);
+  }
+  alignas(T) unsigned char storage_[N * sizeof(T)];
+};
+template <std::size_t N>
+struct btree_slots<void, N> {};
+
+// In-memory B-tree shared by the btree containers. Values are kept in key
+// order in every node, not only in the leaves; an internal node holding n
+// values has n + 1 children. Nodes are sized to a few cache lines, so a lookup
+// touches O(log n / log kMaxValues) of them rather than one node per level of
+// a binary tree.
+//
+// `Mapped` is void for the sets. For the maps keys and mapped values are
+// stored in separate arrays within each node, so that searching a node only
+// touches keys. When `Unique` no two keys are equivalent.
+//
+// Keys and mapped values move between and within nodes as the tree changes,
+// so they must be nothrow move constructible, and any insertion or erasure
+// invalidates iterators.
+template <class Key, class Mapped, class Compare, class Allocator, bool Unique>
+struct btree {
+ private:
+  static constexpr bool kIsMap = !std::is_void<Mapped>::value;
+  using mapped_slot_type = std::conditional_t<kIsMap, Mapped, char>;
+  using aTraits = std::allocator_traits<Allocator>;
+
+  struct node_header {
+    void* parent;
+    std::uint8_t position;
+    std::uint8_t count;
+    bool leaf;
+  };
+  static constexpr std::size_t kTargetNodeBytes = 256;
+  static constexpr std::size_t kSlotBytes =
+      sizeof(Key) + (kIsMap ? sizeof(mapped_slot_type) : 0);
+  static constexpr int kMaxValues = static_cast<int>(std::min<std::size_t>(
+      255,
+      std::max<std::size_t>(
+          3, (kTargetNodeBytes - sizeof(node_header)) / kSlotBytes)));
+  static constexpr int kMinValues = kMaxValues / 2;
+
+  static_assert(std::is_nothrow_move_constructible<Key>::value,
+                "btree keys are moved between nodes");
+  static_assert(!kIsMap ||
+                    std::is_nothrow_move_constructible<mapped_slot_type>::value,
+                "btree mapped values are moved between nodes");
+
+  struct internal_node;
+  struct node {
+    internal_node* parent;
+    // Index of this node in parent->children
+    std::uint8_t position;
+    std::uint8_t count;
+    bool leaf;
+    btree_slots<Key, kMaxValues> keys;
+    btree_slots<Mapped, kMaxValues> mapped;
+
+    Key* key(std::size_t i) { return keys.at(i); }
+    Key const* key(std::size_t i) const { return keys.at(i); }
+  };
+  struct internal_node : node {
+    node* children[kMaxValues + 1];
+  };
+
+  static internal_node* as_internal(node* n) {
+    return static_cast<internal_node*>(n);
+  }
+
+  using leaf_allocator = typename aTraits::template rebind_alloc<node>;
+  using internal_allocator =
+      typename aTraits::template rebind_alloc<internal_node>;
+  using key_allocator = typename aTraits::template rebind_alloc<Key>;
+  using mapped_allocator =
+      typename aTraits::template rebind_alloc<mapped_slot_type>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Mapped;
+  using value_type =
+      std::conditional_t<kIsMap, std::pair<Key, mapped_slot_type>, Key>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::conditional_t<kIsMap,
+                                       std::pair<Key const&, mapped_slot_type&>,
+                                       Key const&>;
+  using const_reference =
+      std::conditional_t<kIsMap,
+                         std::pair<Key const&, mapped_slot_type const&>,
+                         Key const&>;
+
+  struct value_compare {
+    bool operator()(const_reference lhs, const_reference rhs) const {
+      if constexpr (kIsMap) {
+        return compare_(lhs.first, rhs.first);
+      } else {
+        return compare_(lhs, rhs);
+      }
+    }
+
+   private:
+    friend struct btree;
+    explicit value_compare(Compare compare) : compare_(compare) {}
+    Compare compare_;
+  };
+
+  template <bool Const>
+  struct iterator_impl {
+    using difference_type = std::ptrdiff_t;
+    using value_type = btree::value_type;
+    using reference =
+        std::conditional_t<Const, btree::const_reference, btree::reference>;
+    using pointer =
+        std::conditional_t<kIsMap, arrow_proxy<reference>, Key const*>;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    iterator_impl() = default;
+    template <bool OtherConst,
+              typename = std::enable_if_t<Const && !OtherConst>>
+    iterator_impl(iterator_impl<OtherConst> other)
+        : node_(other.node_), position_(other.position_) {}
+
+    reference operator*() const {
+      if constexpr (kIsMap) {
+        return {*node_->key(position_), *node_->mapped.at(position_)};
+      } else {
+        return *node_->key(position_);
+      }
+    }
+    pointer operator->() const {
+      if constexpr (kIsMap) {
+        return {**this};
+      } else {
+        return node_->key(position_);
+      }
+    }
+
+    iterator_impl& operator++() {
+      if (!node_->leaf) {
+        node_ = as_internal(node_)->children[position_ + 1];
+        while (!node_->leaf) {
+          node_ = as_internal(node_)->children[0];
+        }
+        position_ = 0;
+        return *this;
+      }
+      if (++position_ < node_->count) {
+        return *this;
+      }
+      // Past the end of a leaf: the next value is in the nearest ancestor we
+      // are left of. If there isn't one this is the end() position, which is
+      // the one-past-the-end slot of the rightmost leaf.
+      auto save = *this;
+      while (position_ == node_->count && node_->parent) {
+        position_ = node_->position;
+        node_ = node_->parent;
+      }
+      if (position_ == node_->count) {
+        *this = save;
+      }
+      return *this;
+    }
+    iterator_impl operator++(int) {
+      auto result = *this;
+      ++*this;
+      return result;
+    }
+    iterator_impl& operator--() {
+      if (!node_->leaf) {
+        node_ = as_internal(node_)->children[position_];
+        while (!node_->leaf) {
+          node_ = as_internal(node_)->children[node_->count];
+        }
+        position_ = node_->count - 1;
+        return *this;
+      }
+      while (position_ == 0 && node_->parent) {
+        position_ = node_->position;
+        node_ = node_->parent;
+      }
+      --position_;
+      return *this;
+    }
+    iterator_impl operator--(int) {
+      auto result = *this;
+      --*this;
+      return result;
+    }
+
+    friend bool operator==(iterator_impl const& lhs, iterator_impl const& rhs) {
+      return lhs.node_ == rhs.node_ && lhs.position_ == rhs.position_;
+    }
+    friend bool operator!=(iterator_impl const& lhs, iterator_impl const& rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    friend struct btree;
+    friend struct iterator_impl<!Const>;
+    iterator_impl(node* n, int position) : node_(n), position_(position) {}
+
+    node* node_{nullptr};
+    int position_{0};
+  };
+
+  using iterator = iterator_impl<!kIsMap>;
+  using const_iterator = iterator_impl<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  btree() = default;
+  explicit btree(Compare const& compare, Allocator const& alloc = Allocator())
+      : compare_(compare), alloc_(alloc) {}
+  explicit btree(Allocator const& alloc) : alloc_(alloc) {}
+  template <class InputIt>
+  btree(InputIt first,
+        InputIt last,
+        Compare const& compare = Compare(),
+        Allocator const& alloc = Allocator())
+      : btree(compare, alloc) {
+    for (; first != last; ++first) {
+      insert_value(end(), *first);
+    }
+  }
+  btree(std::initializer_list<value_type> init,
+        Compare const& compare = Compare(),
+        Allocator const& alloc = Allocator())
+      : btree(init.begin(), init.end(), compare, alloc) {}
+
+  btree(btree const& other)
+      : btree(other,
+              aTraits::select_on_container_copy_construction(other.alloc_)) {}
+  btree(btree const& other, Allocator const& alloc)
+      : btree(other.compare_, alloc) {
+    // The source is already in order, so every value is appended to the
+    // rightmost leaf; splitting a full rightmost leaf leaves it full.
+    for (auto it = other.begin(); it != other.end(); ++it) {
+      if constexpr (kIsMap) {
+        append_back(it->first, it->second);
+      } else {
+        append_back(*it);
+      }
+    }
+  }
+  btree(btree&& other) noexcept
+      : root_(std::exchange(other.root_, nullptr)),
+        leftmost_(std::exchange(other.leftmost_, nullptr)),
+        rightmost_(std::exchange(other.rightmost_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        compare_(std::move(other.compare_)),
+        alloc_(std::move(other.alloc_)) {}
+  ~btree() { clear(); }
+
+  btree& operator=(btree const& other) {
+    if (this != &other) {
+      btree copy{other,
+                 aTraits::propagate_on_container_copy_assignment::value
+                     ? other.alloc_
+                     : alloc_};
+      swap(copy);
+    }
+    return *this;
+  }
+  btree& operator=(btree&& other) noexcept(
+      aTraits::propagate_on_container_move_assignment::value ||
+      aTraits::is_always_equal::value) {
+    if (this != &other) {
+      if constexpr (!aTraits::propagate_on_container_move_assignment::value) {
+        if (!(alloc_ == other.alloc_)) {
+          // The nodes can't change hands, so the values are copied
+          return *this = static_cast<btree const&>(other);
+        }
+      }
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+  btree& operator=(std::initializer_list<value_type> ilist) {
+    btree copy{ilist, compare_, alloc_};
+    swap(copy);
+    return *this;
+  }
+
+  allocator_type get_allocator() const { return alloc_; }
+
+  iterator begin() noexcept { return {leftmost_, 0}; }
+  const_iterator begin() const noexcept { return {leftmost_, 0}; }
+  iterator end() noexcept {
+    return {rightmost_, rightmost_ ? rightmost_->count : 0};
+  }
+  const_iterator end() const noexcept {
+    return {rightmost_, rightmost_ ? rightmost_->count : 0};
+  }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator{end()};
+  }
+  reverse_iterator rend() noexcept { return reverse_iterator{begin()}; }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator{begin()};
+  }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<difference_type>::max();
+  }
+
+  void clear() noexcept {
+    if (root_) {
+      destroy_subtree(root_);
+    }
+    root_ = leftmost_ = rightmost_ = nullptr;
+    size_ = 0;
+  }
+
+  iterator erase(const_iterator pos) {
+    return erase_at(pos.node_, pos.position_);
+  }
+  template <bool IsMap = kIsMap, typename = std::enable_if_t<IsMap>>
+  iterator erase(iterator pos) {
+    return erase_at(pos.node_, pos.position_);
+  }
+  // Every erasure can move values between nodes, so walk by count from
+  // `first` using the iterator each erasure hands back.
+  iterator erase(const_iterator first, const_iterator last) {
+    auto count = std::distance(first, last);
+    iterator result{first.node_, first.position_};
+    while (count-- > 0) {
+      result = erase_at(result.node_, result.position_);
+    }
+    return result;
+  }
+  size_type erase(key_type const& key) { return erase_range(key); }
+
+  void swap(btree& other) noexcept {
+    using std::swap;
+    swap(root_, other.root_);
+    swap(leftmost_, other.leftmost_);
+    swap(rightmost_, other.rightmost_);
+    swap(size_, other.size_);
+    swap(compare_, other.compare_);
+    if constexpr (aTraits::propagate_on_container_swap::value) {
+      swap(alloc_, other.alloc_);
+    }
+  }
+
+  size_type count(key_type const& key) const { return count_impl(key); }
+  iterator find(key_type const& key) { return find_impl(key); }
+  const_iterator find(key_type const& key) const { return find_impl(key); }
+  bool contains(key_type const& key) const { return find(key) != end(); }
+  std::pair<iterator, iterator> equal_range(key_type const& key) {
+    return equal_range_impl(key);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      key_type const& key) const {
+    return equal_range_impl(key);
+  }
+  iterator lower_bound(key_type const& key) { return lower_bound_impl(key); }
+  const_iterator lower_bound(key_type const& key) const {
+    return lower_bound_impl(key);
+  }
+  iterator upper_bound(key_type const& key) { return upper_bound_impl(key); }
+  const_iterator upper_bound(key_type const& key) const {
+    return upper_bound_impl(key);
+  }
+
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, size_type>::type count(
+      K const& key) const {
+    return count_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, iterator>::type find(
+      K const& key) {
+    return find_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, const_iterator>::type
+  find(K const& key) const {
+    return find_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, bool>::type contains(
+      K const& key) const {
+    return find(key) != end();
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value,
+                          std::pair<iterator, iterator>>::type
+  equal_range(K const& key) {
+    return equal_range_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value,
+                          std::pair<const_iterator, const_iterator>>::type
+  equal_range(K const& key) const {
+    return equal_range_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, iterator>::type
+  lower_bound(K const& key) {
+    return lower_bound_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, const_iterator>::type
+  lower_bound(K const& key) const {
+    return lower_bound_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, iterator>::type
+  upper_bound(K const& key) {
+    return upper_bound_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, const_iterator>::type
+  upper_bound(K const& key) const {
+    return upper_bound_impl(key);
+  }
+
+  key_compare key_comp() const { return compare_; }
+  value_compare value_comp() const { return value_compare{compare_}; }
+
+  friend bool operator==(btree const& lhs, btree const& rhs) {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    auto r = rhs.begin();
+    for (auto l = lhs.begin(); l != lhs.end(); ++l, ++r) {
+      if constexpr (kIsMap) {
+        if (!(l->first == r->first) || !(l->second == r->second)) {
+          return false;
+        }
+      } else {
+        if (!(*l == *r)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+  friend bool operator!=(btree const& lhs, btree const& rhs) {
+    return !(lhs == rhs);
+  }
+
+ protected:
+  template <typename K>
+  iterator find_impl(K const& key) const {
+    if (!root_) {
+      return end_position();
+    }
+    node* n = root_;
+    for (;;) {
+      int i = lower_index(n, key);
+      if constexpr (Unique) {
+        // With unique keys a match in an internal node is the match
+        if (i < n->count && !compare_(key, *n->key(i))) {
+          return {n, i};
+        }
+        if (n->leaf) {
+          return end_position();
+        }
+      } else if (n->leaf) {
+        auto found = normalize(n, i);
+        if (found == end_position() || compare_(key, key_at(found))) {
+          return end_position();
+        }
+        return found;
+      }
+      n = as_internal(n)->children[i];
+    }
+  }
+
+  template <typename K>
+  iterator lower_bound_impl(K const& key) const {
+    if (!root_) {
+      return end_position();
+    }
+    auto leaf = descend_lower(key);
+    return normalize(leaf.first, leaf.second);
+  }
+
+  template <typename K>
+  iterator upper_bound_impl(K const& key) const {
+    if (!root_) {
+      return end_position();
+    }
+    auto leaf = descend_upper(key);
+    return normalize(leaf.first, leaf.second);
+  }
+
+  template <typename K>
+  std::pair<iterator, iterator> equal_range_impl(K const& key) const {
+    if constexpr (Unique) {
+      auto found = find_impl(key);
+      if (found == end_position()) {
+        return {found, found};
+      }
+      return {found, std::next(found)};
+    } else {
+      return {lower_bound_impl(key), upper_bound_impl(key)};
+    }
+  }
+
+  template <typename K>
+  size_type count_impl(K const& key) const {
+    if constexpr (Unique) {
+      return find_impl(key) == end_position() ? 0 : 1;
+    } else {
+      auto range = equal_range_impl(key);
+      return static_cast<size_type>(std::distance(range.first, range.second));
+    }
+  }
+
+  template <typename K>
+  size_type erase_range(K const& key) {
+    auto range = equal_range_impl(key);
+    auto result =
+        static_cast<size_type>(std::distance(range.first, range.second));
+    erase(range.first, range.second);
+    return result;
+  }
+
+  // Inserts a new element unless one with a key equivalent to `key` is
+  // present. `make_key` is only called if the key is absent, and converts the
+  // lookup key into a `key_type` (by forwarding or adapting it); `args`
+  // construct the mapped value.
+  template <typename K, typename MakeKey, typename... Args>
+  std::pair<iterator, bool> emplace_unique(K const& key,
+                                           MakeKey&& make_key,
+                                           Args&&... args) {
+    if (!root_) {
+      return {insert_at(nullptr, 0, make_key, std::forward<Args>(args)...),
+              true};
+    }
+    auto leaf = descend_lower(key);
+    auto next = normalize(leaf.first, leaf.second);
+    if (next != end_position() && !compare_(key, key_at(next))) {
+      return {next, false};
+    }
+    return {insert_at(leaf.first, leaf.second, make_key,
+                      std::forward<Args>(args)...),
+            true};
+  }
+
+  // As `emplace_unique`, but checks `hint` first: if the key belongs
+  // immediately before `hint` this costs two comparisons and no search.
+  template <typename K, typename MakeKey, typename... Args>
+  iterator emplace_hint_unique(const_iterator hint,
+                               K const& key,
+                               MakeKey&& make_key,
+                               Args&&... args) {
+    if (root_) {
+      iterator pos{hint.node_, hint.position_};
+      if (pos == end_position() || compare_(key, key_at(pos))) {
+        if (pos == begin_position() || compare_(key_at(std::prev(pos)), key)) {
+          auto leaf = leaf_position(pos);
+          return insert_at(leaf.first, leaf.second, make_key,
+                           std::forward<Args>(args)...);
+        }
+      } else if (!compare_(key_at(pos), key)) {
+        return pos;
+      }
+    }
+    return emplace_unique(key, make_key, std::forward<Args>(args)...).first;
+  }
+
+  // Inserts after any elements with equivalent keys
+  template <typename K, typename MakeKey, typename... Args>
+  iterator emplace_multi(K const& key, MakeKey&& make_key, Args&&... args) {
+    if (!root_) {
+      return insert_at(nullptr, 0, make_key, std::forward<Args>(args)...);
+    }
+    auto leaf = descend_upper(key);
+    return insert_at(leaf.first, leaf.second, make_key,
+                     std::forward<Args>(args)...);
+  }
+
+  // Inserts as close before `hint` as ordering allows
+  template <typename K, typename MakeKey, typename... Args>
+  iterator emplace_hint_multi(const_iterator hint,
+                              K const& key,
+                              MakeKey&& make_key,
+                              Args&&... args) {
+    if (!root_) {
+      return insert_at(nullptr, 0, make_key, std::forward<Args>(args)...);
+    }
+    iterator pos{hint.node_, hint.position_};
+    std::pair<node*, int> leaf;
+    if (pos != begin_position() && compare_(key, key_at(std::prev(pos)))) {
+      leaf = descend_upper(key);
+    } else if (pos != end_position() && compare_(key_at(pos), key)) {
+      leaf = descend_lower(key);
+    } else {
+      leaf = leaf_position(pos);
+    }
+    return insert_at(leaf.first, leaf.second, make_key,
+                     std::forward<Args>(args)...);
+  }
+
+  // Inserts a `value_type`, from a range or initializer list
+  template <typename V>
+  iterator insert_value(const_iterator hint, V&& value) {
+    if constexpr (kIsMap) {
+      auto make_key = [&]() -> decltype(auto) {
+        return (std::forward<V>(value).first);
+      };
+      if constexpr (Unique) {
+        return emplace_hint_unique(hint, value.first, make_key,
+                                   std::forward<V>(value).second);
+      } else {
+        return emplace_hint_multi(hint, value.first, make_key,
+                                  std::forward<V>(value).second);
+      }
+    } else {
+      auto make_key = [&]() -> V&& { return std::forward<V>(value); };
+      if constexpr (Unique) {
+        return emplace_hint_unique(hint, value, make_key);
+      } else {
+        return emplace_hint_multi(hint, value, make_key);
+      }
+    }
+  }
+
+  static Key const& key_at(const_iterator pos) {
+    return *pos.node_->key(pos.position_);
+  }
+  static mapped_slot_type& mapped_at(iterator pos) {
+    return *pos.node_->mapped.at(pos.position_);
+  }
+
+ private:
+  iterator begin_position() const { return {leftmost_, 0}; }
+  iterator end_position() const {
+    return {rightmost_, rightmost_ ? rightmost_->count : 0};
+  }
+
+  // First slot in `n` whose key is not less than `key`
+  template <typename K>
+  int lower_index(node const* n, K const& key) const {
+    int lo = 0;
+    int hi = n->count;
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (compare_(*n->key(mid), key)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  // First slot in `n` whose key is greater than `key`
+  template <typename K>
+  int upper_index(node const* n, K const& key) const {
+    int lo = 0;
+    int hi = n->count;
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (compare_(key, *n->key(mid))) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    return lo;
+  }
+
+  // The leaf slot at which `key` would be inserted before/after any
+  // equivalent elements
+  template <typename K>
+  std::pair<node*, int> descend_lower(K const& key) const {
+    node* n = root_;
+    for (;;) {
+      int i = lower_index(n, key);
+      if (n->leaf) {
+        return {n, i};
+      }
+      n = as_internal(n)->children[i];
+    }
+  }
+  template <typename K>
+  std::pair<node*, int> descend_upper(K const& key) const {
+    node* n = root_;
+    for (;;) {
+      int i = upper_index(n, key);
+      if (n->leaf) {
+        return {n, i};
+      }
+      n = as_internal(n)->children[i];
+    }
+  }
+
+  // Turns a slot that may be one past the end of its node into an iterator
+  // to the next element (or end())
+  iterator normalize(node* n, int i) const {
+    if (!n) {
+      return end_position();
+    }
+    while (i == n->count && n->parent) {
+      i = n->position;
+      n = n->parent;
+    }
+    if (i == n->count) {
+      return end_position();
+    }
+    return {n, i};
+  }
+
+  // The leaf slot at which a value goes to end up immediately before `pos`
+  static std::pair<node*, int> leaf_position(iterator pos) {
+    if (pos.node_->leaf) {
+      return {pos.node_, pos.position_};
+    }
+    --pos;
+    return {pos.node_, pos.position_ + 1};
+  }
+
+  template <typename... Args>
+  void construct_slot(node* n, int i, Key&& key, Args&&... args) {
+    key_allocator keyAlloc{alloc_};
+    std::allocator_traits<key_allocator>::construct(keyAlloc, n->key(i),
+                                                    std::move(key));
+    if constexpr (kIsMap) {
+      mapped_allocator mappedAlloc{alloc_};
+      std::allocator_traits<mapped_allocator>::construct(
+          mappedAlloc, n->mapped.at(i), std::forward<Args>(args)...);
+    }
+  }
+
+  void destroy_slot(node* n, int i) noexcept {
+    key_allocator keyAlloc{alloc_};
+    std::allocator_traits<key_allocator>::destroy(keyAlloc, n->key(i));
+    if constexpr (kIsMap) {
+      mapped_allocator mappedAlloc{alloc_};
+      std::allocator_traits<mapped_allocator>::destroy(mappedAlloc,
+                                                       n->mapped.at(i));
+    }
+  }
+
+  // Moves the value in slot `si` of `src` into the empty slot `di` of `dst`,
+  // leaving `si` empty
+  void move_slot(node* dst, int di, node* src, int si) noexcept {
+    if constexpr (kIsMap) {
+      construct_slot(dst, di, std::move(*src->key(si)),
+                     std::move(*src->mapped.at(si)));
+    } else {
+      construct_slot(dst, di, std::move(*src->key(si)));
+    }
+    destroy_slot(src, si);
+  }
+
+  static void set_child(internal_node* parent, int i, node* child) noexcept {
+    parent->children[i] = child;
+    child->parent = parent;
+    child->position = static_cast<std::uint8_t>(i);
+  }
+
+  node* new_leaf(internal_node* parent) {
+    leaf_allocator alloc{alloc_};
+    node* n = std::allocator_traits<leaf_allocator>::allocate(alloc, 1);
+    ::new (static_cast<void*>(n)) node;
+    n->parent = parent;
+    n->position = 0;
+    n->count = 0;
+    n->leaf = true;
+    return n;
+  }
+
+  internal_node* new_internal(internal_node* parent) {
+    internal_allocator alloc{alloc_};
+    internal_node* n =
+        std::allocator_traits<internal_allocator>::allocate(alloc, 1);
+    ::new (static_cast<void*>(n)) internal_node;
+    n->parent = parent;
+    n->position = 0;
+    n->count = 0;
+    n->leaf = false;
+    return n;
+  }
+
+  void free_node(node* n) noexcept {
+    if (n->leaf) {
+      leaf_allocator alloc{alloc_};
+      n->~node();
+      std::allocator_traits<leaf_allocator>::deallocate(alloc, n, 1);
+    } else {
+      internal_allocator alloc{alloc_};
+      auto internal = as_internal(n);
+      internal->~internal_node();
+      std::allocator_traits<internal_allocator>::deallocate(alloc, internal,
+                                                            1);
+    }
+  }
+
+  void destroy_subtree(node* n) noexcept {
+    if (!n->leaf) {
+      for (int i = 0; i <= n->count; ++i) {
+        destroy_subtree(as_internal(n)->children[i]);
+      }
+    }
+    for (int i = 0; i < n->count; ++i) {
+      destroy_slot(n, i);
+    }
+    free_node(n);
+  }
+
+  // Inserts a new element at slot `i` of leaf `n` (or into a new root if the
+  // tree is empty). The key and mapped value are built before anything is
+  // moved, so that a throwing constructor leaves the tree untouched and
+  // arguments referring to elements of this container stay valid.
+  template <typename MakeKey, typename... Args>
+  iterator insert_at(node* n, int i, MakeKey& make_key, Args&&... args) {
+    Key key(make_key());
+    if constexpr (kIsMap) {
+      mapped_slot_type mapped(std::forward<Args>(args)...);
+      return insert_at_built(n, i, std::move(key), std::move(mapped));
+    } else {
+      return insert_at_built(n, i, std::move(key));
+    }
+  }
+
+  template <typename... MappedArgs>
+  iterator insert_at_built(node* n, int i, Key&& key, MappedArgs&&... mapped) {
+    if (!root_) {
+      root_ = leftmost_ = rightmost_ = n = new_leaf(nullptr);
+      i = 0;
+    } else if (n->count == kMaxValues) {
+      auto split_position = split(n, i);
+      n = split_position.first;
+      i = split_position.second;
+    }
+    for (int j = n->count; j > i; --j) {
+      move_slot(n, j, n, j - 1);
+    }
+    construct_slot(n, i, std::move(key), std::move(mapped)...);
+    ++n->count;
+    ++size_;
+    return {n, i};
+  }
+
+  template <typename... MappedArgs>
+  void append_back(Key const& key, MappedArgs const&... mapped) {
+    Key keyCopy(key);
+    if constexpr (kIsMap) {
+      mapped_slot_type mappedCopy(mapped...);
+      insert_at_built(rightmost_, rightmost_ ? rightmost_->count : 0,
+                      std::move(keyCopy), std::move(mappedCopy));
+    } else {
+      insert_at_built(rightmost_, rightmost_ ? rightmost_->count : 0,
+                      std::move(keyCopy));
+    }
+  }
+
+  // Splits the full node `n` in two, pushing the separating value up into the
+  // parent (splitting that first if it is also full). Returns where slot `i`
+  // of `n` now is. The split is biased by where the next value is going:
+  // appending to the end leaves `n` full, so ascending insertion produces
+  // full nodes.
+  std::pair<node*, int> split(node* n, int i) {
+    internal_node* parent = n->parent;
+    if (!parent) {
+      parent = new_internal(nullptr);
+      set_child(parent, 0, n);
+      root_ = parent;
+    } else if (parent->count == kMaxValues) {
+      split(parent, n->position);
+      parent = n->parent;
+    }
+    node* dest = n->leaf ? new_leaf(parent) : new_internal(parent);
+    int moved;
+    if (i == 0) {
+      moved = n->count - 1;
+    } else if (i == kMaxValues) {
+      moved = 0;
+    } else {
+      moved = n->count / 2;
+    }
+    int separator = n->count - moved - 1;
+    for (int j = 0; j < moved; ++j) {
+      move_slot(dest, j, n, separator + 1 + j);
+    }
+    if (!n->leaf) {
+      for (int j = 0; j <= moved; ++j) {
+        set_child(as_internal(dest), j,
+                  as_internal(n)->children[separator + 1 + j]);
+      }
+    }
+    dest->count = static_cast<std::uint8_t>(moved);
+
+    int p = n->position;
+    for (int j = parent->count; j > p; --j) {
+      move_slot(parent, j, parent, j - 1);
+    }
+    for (int j = parent->count + 1; j > p + 1; --j) {
+      set_child(parent, j, parent->children[j - 1]);
+    }
+    move_slot(parent, p, n, separator);
+    set_child(parent, p + 1, dest);
+    ++parent->count;
+    n->count = static_cast<std::uint8_t>(separator);
+
+    if (n == rightmost_) {
+      rightmost_ = dest;
+    }
+    if (i > separator) {
+      return {dest, i - separator - 1};
+    }
+    return {n, i};
+  }
+
+  iterator erase_at(node* n, int i) {
+    bool internalErase = !n->leaf;
+    if (internalErase) {
+      // Replace the value with its predecessor, which is the last value of a
+      // leaf, and remove that instead
+      auto predecessor = std::prev(iterator{n, i});
+      destroy_slot(n, i);
+      move_slot(n, i, predecessor.node_, predecessor.position_);
+      n = predecessor.node_;
+      i = predecessor.position_;
+    } else {
+      destroy_slot(n, i);
+    }
+    for (int j = i; j + 1 < n->count; ++j) {
+      move_slot(n, j, n, j + 1);
+    }
+    --n->count;
+    --size_;
+    auto next = rebalance_after_erase(n, i);
+    auto result = normalize(next.first, next.second);
+    if (internalErase) {
+      // `result` is the predecessor, now in the erased value's place
+      ++result;
+    }
+    return result;
+  }
+
+  // Restores the minimum occupancy of `n` and its ancestors after an erasure,
+  // merging with or borrowing from siblings. Returns where slot `i` of `n`
+  // now is.
+  std::pair<node*, int> rebalance_after_erase(node* n, int i) {
+    node* tracked = n;
+    node* current = n;
+    while (current != root_ && current->count < kMinValues) {
+      internal_node* parent = current->parent;
+      int p = current->position;
+      node* left = p > 0 ? parent->children[p - 1] : nullptr;
+      node* right = p < parent->count ? parent->children[p + 1] : nullptr;
+      if (left && left->count + 1 + current->count <= kMaxValues) {
+        if (tracked == current) {
+          tracked = left;
+          i += left->count + 1;
+        }
+        merge(left, current);
+      } else if (right && current->count + 1 + right->count <= kMaxValues) {
+        merge(current, right);
+      } else if (right) {
+        rotate_left(current, right);
+        break;
+      } else {
+        rotate_right(left, current);
+        if (tracked == current) {
+          ++i;
+        }
+        break;
+      }
+      current = parent;
+    }
+    if (root_->count == 0) {
+      node* oldRoot = root_;
+      if (oldRoot->leaf) {
+        root_ = leftmost_ = rightmost_ = nullptr;
+        tracked = nullptr;
+        i = 0;
+      } else {
+        root_ = as_internal(oldRoot)->children[0];
+        root_->parent = nullptr;
+        root_->position = 0;
+      }
+      free_node(oldRoot);
+    }
+    return {tracked, i};
+  }
+
+  // Moves the separator between `left` and `right`, then everything in
+  // `right`, onto the end of `left`, and frees `right`
+  void merge(node* left, node* right) noexcept {
+    internal_node* parent = left->parent;
+    int p = left->position;
+    int base = left->count;
+    move_slot(left, base, parent, p);
+    for (int j = 0; j < right->count; ++j) {
+      move_slot(left, base + 1 + j, right, j);
+    }
+    if (!left->leaf) {
+      for (int j = 0; j <= right->count; ++j) {
+        set_child(as_internal(left), base + 1 + j,
+                  as_internal(right)->children[j]);
+      }
+    }
+    left->count = static_cast<std::uint8_t>(base + 1 + right->count);
+    for (int j = p; j + 1 < parent->count; ++j) {
+      move_slot(parent, j, parent, j + 1);
+    }
+    for (int j = p + 1; j < parent->count; ++j) {
+      set_child(parent, j, parent->children[j + 1]);
+    }
+    --parent->count;
+    if (right == rightmost_) {
+      rightmost_ = left;
+    }
+    right->count = 0;
+    free_node(right);
+  }
+
+  // Moves one value from `right` to `n` through their separator
+  void rotate_left(node* n, node* right) noexcept {
+    internal_node* parent = n->parent;
+    int p = n->position;
+    int rightCount = right->count;
+    move_slot(n, n->count, parent, p);
+    move_slot(parent, p, right, 0);
+    if (!n->leaf) {
+      set_child(as_internal(n), n->count + 1, as_internal(right)->children[0]);
+    }
+    ++n->count;
+    for (int j = 0; j + 1 < rightCount; ++j) {
+      move_slot(right, j, right, j + 1);
+    }
+    if (!right->leaf) {
+      for (int j = 0; j < rightCount; ++j) {
+        set_child(as_internal(right), j, as_internal(right)->children[j + 1]);
+      }
+    }
+    --right->count;
+  }
+
+  // Moves one value from `left` to `n` through their separator
+  void rotate_right(node* left, node* n) noexcept {
+    internal_node* parent = n->parent;
+    int p = left->position;
+    for (int j = n->count; j > 0; --j) {
+      move_slot(n, j, n, j - 1);
+    }
+    if (!n->leaf) {
+      for (int j = n->count + 1; j > 0; --j) {
+        set_child(as_internal(n), j, as_internal(n)->children[j - 1]);
+      }
+    }
+    move_slot(n, 0, parent, p);
+    move_slot(parent, p, left, left->count - 1);
+    if (!n->leaf) {
+      set_child(as_internal(n), 0, as_internal(left)->children[left->count]);
+    }
+    --left->count;
+    ++n->count;
+  }
+
+  node* root_{nullptr};
+  node* leftmost_{nullptr};
+  node* rightmost_{nullptr};
+  size_type size_{0};
+  Compare compare_;
+  Allocator alloc_;
+};
+}  // namespace detail
+}  // namespace proposed
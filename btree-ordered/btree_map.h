@@ -0,0 +1,299 @@
+#pragma once
+
+#include <memory_resource>
+#include <stdexcept>
+#include "btree-base.h"
+
+namespace proposed {
+template <class Key,
+          class T,
+          class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>,
+          class KeyAdaptor = no_adaptor,
+          class ValueAdaptor = no_adaptor>
+struct btree_map : detail::btree<Key, T, Compare, Allocator, true> {
+ private:
+  using base_type = detail::btree<Key, T, Compare, Allocator, true>;
+  using key_adaptor = KeyAdaptor;
+  using value_adaptor = ValueAdaptor;
+
+ public:
+  using typename base_type::const_iterator;
+  using typename base_type::iterator;
+  using typename base_type::key_type;
+  using typename base_type::size_type;
+  using typename base_type::value_type;
+
+  using base_type::btree;
+  using base_type::erase;
+
+  T& operator[](key_type const& key) { return try_emplace(key).first->second; }
+  T& operator[](key_type&& key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  T& at(key_type const& key) { return at_helper(*this, key); }
+  T const& at(key_type const& key) const { return at_helper(*this, key); }
+
+  std::pair<iterator, bool> insert(value_type const& value) {
+    return try_emplace(value.first, value.second);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+  iterator insert(const_iterator hint, value_type const& value) {
+    return try_emplace(hint, value.first, value.second);
+  }
+  iterator insert(const_iterator hint, value_type&& value) {
+    return try_emplace(hint, std::move(value.first), std::move(value.second));
+  }
+  // Sorted input is inserted in amortised constant time per element
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    detail::for_each_adapted_batch(
+        first, last, this->get_allocator(), [this](auto from, auto to) {
+          for (; from != to; ++from) {
+            this->insert_value(this->end(), *from);
+          }
+        });
+  }
+  void insert(std::initializer_list<value_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return insert(hint, value_type(std::forward<Args>(args)...));
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type const& key, Args&&... args) {
+    return try_emplace_helper(key, std::forward<Args>(args)...);
+  }
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+    return try_emplace_helper(std::move(key), std::forward<Args>(args)...);
+  }
+  template <class... Args>
+  iterator try_emplace(const_iterator hint,
+                       key_type const& key,
+                       Args&&... args) {
+    return try_emplace_hint_helper(hint, key, std::forward<Args>(args)...);
+  }
+  template <class... Args>
+  iterator try_emplace(const_iterator hint, key_type&& key, Args&&... args) {
+    return try_emplace_hint_helper(hint, std::move(key),
+                                   std::forward<Args>(args)...);
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(key_type const& key, M&& obj) {
+    return insert_or_assign_helper(key, std::forward<M>(obj));
+  }
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+    return insert_or_assign_helper(std::move(key), std::forward<M>(obj));
+  }
+  template <class M>
+  iterator insert_or_assign(const_iterator hint,
+                            key_type const& key,
+                            M&& obj) {
+    return insert_or_assign_hint_helper(hint, key, std::forward<M>(obj));
+  }
+  template <class M>
+  iterator insert_or_assign(const_iterator hint, key_type&& key, M&& obj) {
+    return insert_or_assign_hint_helper(hint, std::move(key),
+                                        std::forward<M>(obj));
+  }
+
+ private:
+  key_adaptor keyAdaptor_;
+  static_assert(!adaptor_traits<key_adaptor>::is_adaptor ||
+                std::is_same_v<key_type, typename key_adaptor::target_type>);
+  static_assert(
+      !adaptor_traits<value_adaptor>::is_adaptor ||
+      std::is_same_v<value_type, typename value_adaptor::target_type>);
+
+  template <typename AdaptableType>
+  static bool constexpr is_write_adaptable() {
+    return detail::is_write_adaptable_v<Key, iterator, const_iterator,
+                                        key_adaptor, AdaptableType>;
+  }
+
+  template <typename Self, typename K>
+  static auto& at_helper(Self& self, K const& key) {
+    auto found = self.find_impl(key);
+    if (found == self.end()) {
+      throw std::out_of_range{"No such key in map"};
+    }
+    return found->second;
+  }
+
+  template <typename KT, typename... Args>
+  std::pair<iterator, bool> try_emplace_helper(KT&& key, Args&&... args) {
+    return this->emplace_unique(
+        key, [&]() -> KT&& { return std::forward<KT>(key); },
+        std::forward<Args>(args)...);
+  }
+
+  template <typename KT, typename... Args>
+  iterator try_emplace_hint_helper(const_iterator hint,
+                                   KT&& key,
+                                   Args&&... args) {
+    return this->emplace_hint_unique(
+        hint, key, [&]() -> KT&& { return std::forward<KT>(key); },
+        std::forward<Args>(args)...);
+  }
+
+  // `make_key` is only called if the key is absent, and converts the lookup
+  // key into a `key_type` (by forwarding or adapting it).
+  template <typename K, typename MakeKey, typename M>
+  std::pair<iterator, bool> insert_or_assign_impl(K const& key,
+                                                  MakeKey&& make_key,
+                                                  M&& obj) {
+    // `obj` is only consumed by emplace_unique when it inserts
+    auto result = this->emplace_unique(key, make_key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename K, typename MakeKey, typename M>
+  iterator insert_or_assign_hint_impl(const_iterator hint,
+                                      K const& key,
+                                      MakeKey&& make_key,
+                                      M&& obj) {
+    bool inserted = false;
+    auto result = this->emplace_hint_unique(
+        hint, key,
+        [&]() -> decltype(auto) {
+          inserted = true;
+          return make_key();
+        },
+        std::forward<M>(obj));
+    if (!inserted) {
+      result->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename KT, typename M>
+  std::pair<iterator, bool> insert_or_assign_helper(KT&& key, M&& obj) {
+    return insert_or_assign_impl(
+        key, [&]() -> KT&& { return std::forward<KT>(key); },
+        std::forward<M>(obj));
+  }
+
+  template <typename KT, typename M>
+  iterator insert_or_assign_hint_helper(const_iterator hint,
+                                        KT&& key,
+                                        M&& obj) {
+    return insert_or_assign_hint_impl(
+        hint, key, [&]() -> KT&& { return std::forward<KT>(key); },
+        std::forward<M>(obj));
+  }
+
+ public:
+  template <typename AdaptableType, typename M>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(),
+                          std::pair<iterator, bool>>::type
+  insert_or_assign(AdaptableType&& key, M&& obj) {
+    return insert_or_assign_impl(
+        key,
+        [&] {
+          return detail::adapt_to<key_type>(keyAdaptor_,
+                                            std::forward<AdaptableType>(key),
+                                            this->get_allocator());
+        },
+        std::forward<M>(obj));
+  }
+
+  template <typename AdaptableType, typename M>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(), iterator>::type
+  insert_or_assign(const_iterator hint, AdaptableType&& key, M&& obj) {
+    return insert_or_assign_hint_impl(
+        hint, key,
+        [&] {
+          return detail::adapt_to<key_type>(keyAdaptor_,
+                                            std::forward<AdaptableType>(key),
+                                            this->get_allocator());
+        },
+        std::forward<M>(obj));
+  }
+
+  template <typename AdaptableType, typename... Args>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(),
+                          std::pair<iterator, bool>>::type
+  try_emplace(AdaptableType&& key, Args&&... args) {
+    return this->emplace_unique(
+        key,
+        [&] {
+          return detail::adapt_to<key_type>(keyAdaptor_,
+                                            std::forward<AdaptableType>(key),
+                                            this->get_allocator());
+        },
+        std::forward<Args>(args)...);
+  }
+
+  template <typename AdaptableType, typename... Args>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(), iterator>::type
+  try_emplace(const_iterator hint, AdaptableType&& key, Args&&... args) {
+    return this->emplace_hint_unique(
+        hint, key,
+        [&] {
+          return detail::adapt_to<key_type>(keyAdaptor_,
+                                            std::forward<AdaptableType>(key),
+                                            this->get_allocator());
+        },
+        std::forward<Args>(args)...);
+  }
+
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType const&>(),
+                          size_type>::type
+  erase(AdaptableType const& key) {
+    return this->erase_range(key);
+  }
+
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType const&>(), T&>::type
+  at(AdaptableType const& key) {
+    return at_helper(*this, key);
+  }
+
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType const&>(),
+                          T const&>::type
+  at(AdaptableType const& key) const {
+    return at_helper(*this, key);
+  }
+
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(), T&>::type
+  operator[](AdaptableType&& key) {
+    return try_emplace(std::forward<AdaptableType>(key)).first->second;
+  }
+
+  // Can't do emplace or emplace_hint - Ambiguity
+};
+
+namespace pmr {
+template <class Key,
+          class T,
+          class Compare = std::less<Key>,
+          class KeyAdaptor = no_adaptor,
+          class ValueAdaptor = no_adaptor>
+using btree_map = proposed::btree_map<
+    Key,
+    T,
+    Compare,
+    std::pmr::polymorphic_allocator<std::pair<const Key, T>>,
+    KeyAdaptor,
+    ValueAdaptor>;
+}  // namespace pmr
+}  // namespace proposed
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <memory_resource>
+#include "btree-base.h"
+
+namespace proposed {
+template <class Key,
+          class T,
+          class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>,
+          class KeyAdaptor = no_adaptor,
+          class ValueAdaptor = no_adaptor>
+struct btree_multimap : detail::btree<Key, T, Compare, Allocator, false> {
+ private:
+  using base_type = detail::btree<Key, T, Compare, Allocator, false>;
+  using key_adaptor = KeyAdaptor;
+  using value_adaptor = ValueAdaptor;
+
+ public:
+  using typename base_type::const_iterator;
+  using typename base_type::iterator;
+  using typename base_type::key_type;
+  using typename base_type::size_type;
+  using typename base_type::value_type;
+
+  using base_type::btree;
+  using base_type::erase;
+
+  iterator insert(value_type const& value) {
+    return this->emplace_multi(
+        value.first, [&]() -> key_type const& { return value.first; },
+        value.second);
+  }
+  iterator insert(value_type&& value) {
+    return this->emplace_multi(
+        value.first, [&]() -> key_type&& { return std::move(value.first); },
+        std::move(value.second));
+  }
+  iterator insert(const_iterator hint, value_type const& value) {
+    return this->emplace_hint_multi(
+        hint, value.first, [&]() -> key_type const& { return value.first; },
+        value.second);
+  }
+  iterator insert(const_iterator hint, value_type&& value) {
+    return this->emplace_hint_multi(
+        hint, value.first,
+        [&]() -> key_type&& { return std::move(value.first); },
+        std::move(value.second));
+  }
+  // Sorted input is inserted in amortised constant time per element
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    detail::for_each_adapted_batch(
+        first, last, this->get_allocator(), [this](auto from, auto to) {
+          for (; from != to; ++from) {
+            this->insert_value(this->end(), *from);
+          }
+        });
+  }
+  void insert(std::initializer_list<value_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  template <class... Args>
+  iterator emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return insert(hint, value_type(std::forward<Args>(args)...));
+  }
+
+ private:
+  key_adaptor keyAdaptor_;
+  static_assert(!adaptor_traits<key_adaptor>::is_adaptor ||
+                std::is_same_v<key_type, typename key_adaptor::target_type>);
+  static_assert(
+      !adaptor_traits<value_adaptor>::is_adaptor ||
+      std::is_same_v<value_type, typename value_adaptor::target_type>);
+
+  template <typename AdaptableType>
+  static bool constexpr is_write_adaptable() {
+    return detail::is_write_adaptable_v<Key, iterator, const_iterator,
+                                        key_adaptor, AdaptableType>;
+  }
+
+ public:
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType const&>(),
+                          size_type>::type
+  erase(const AdaptableType& key) {
+    return this->erase_range(key);
+  }
+
+  // Can't do insert, emplace or emplace_hint - Ambiguity
+};
+
+namespace pmr {
+template <class Key,
+          class T,
+          class Compare = std::less<Key>,
+          class KeyAdaptor = no_adaptor,
+          class ValueAdaptor = no_adaptor>
+using btree_multimap = proposed::btree_multimap<
+    Key,
+    T,
+    Compare,
+    std::pmr::polymorphic_allocator<std::pair<const Key, T>>,
+    KeyAdaptor,
+    ValueAdaptor>;
+}  // namespace pmr
+}  // namespace proposed
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <memory_resource>
+#include "btree-base.h"
+
+namespace proposed {
+template <class Key,
+          class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>,
+          class Adaptor = no_adaptor>
+struct btree_multiset : detail::btree<Key, void, Compare, Allocator, false> {
+ private:
+  using base_type = detail::btree<Key, void, Compare, Allocator, false>;
+  using key_adaptor = Adaptor;
+  using value_adaptor = Adaptor;
+
+ public:
+  using typename base_type::const_iterator;
+  using typename base_type::iterator;
+  using typename base_type::key_type;
+  using typename base_type::size_type;
+  using typename base_type::value_type;
+
+  using base_type::btree;
+  using base_type::erase;
+
+  iterator insert(value_type const& value) { return insert_helper(value); }
+  iterator insert(value_type&& value) {
+    return insert_helper(std::move(value));
+  }
+  iterator insert(const_iterator hint, value_type const& value) {
+    return insert_helper(hint, value);
+  }
+  iterator insert(const_iterator hint, value_type&& value) {
+    return insert_helper(hint, std::move(value));
+  }
+  // Sorted input is inserted in amortised constant time per element
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    detail::for_each_adapted_batch(
+        first, last, this->get_allocator(), [this](auto from, auto to) {
+          for (; from != to; ++from) {
+            this->insert_value(this->end(), *from);
+          }
+        });
+  }
+  void insert(std::initializer_list<value_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  template <class... Args>
+  iterator emplace(Args&&... args) {
+    return insert_helper(value_type(std::forward<Args>(args)...));
+  }
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return insert_helper(hint, value_type(std::forward<Args>(args)...));
+  }
+
+ private:
+  key_adaptor keyAdaptor_;
+  static_assert(!adaptor_traits<key_adaptor>::is_adaptor ||
+                std::is_same_v<key_type, typename key_adaptor::target_type>);
+
+  template <typename AdaptableType>
+  static bool constexpr is_write_adaptable() {
+    return detail::is_write_adaptable_v<Key, iterator, const_iterator,
+                                        key_adaptor, AdaptableType>;
+  }
+
+  template <typename VT>
+  iterator insert_helper(VT&& value) {
+    return this->emplace_multi(
+        value, [&]() -> VT&& { return std::forward<VT>(value); });
+  }
+
+  template <typename VT>
+  iterator insert_helper(const_iterator hint, VT&& value) {
+    return this->emplace_hint_multi(
+        hint, value, [&]() -> VT&& { return std::forward<VT>(value); });
+  }
+
+ public:
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(), iterator>::type
+  insert(AdaptableType&& value) {
+    return this->emplace_multi(value, [&] {
+      return detail::adapt_to<key_type>(keyAdaptor_,
+                                        std::forward<AdaptableType>(value),
+                                        this->get_allocator());
+    });
+  }
+
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(), iterator>::type
+  insert(const_iterator hint, AdaptableType&& value) {
+    return this->emplace_hint_multi(hint, value, [&] {
+      return detail::adapt_to<key_type>(keyAdaptor_,
+                                        std::forward<AdaptableType>(value),
+                                        this->get_allocator());
+    });
+  }
+
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType const&>()>::type
+  insert(std::initializer_list<AdaptableType> ilist) {
+    for (auto const& elem : ilist) {
+      insert(this->end(), elem);
+    }
+  }
+
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType const&>(),
+                          size_type>::type
+  erase(const AdaptableType& key) {
+    return this->erase_range(key);
+  }
+
+  // Can't do emplace or emplace_hint - Ambiguity
+};
+
+namespace pmr {
+template <class Key, class Compare = std::less<Key>, class Adaptor = no_adaptor>
+using btree_multiset = proposed::btree_multiset<
+    Key,
+    Compare,
+    std::pmr::polymorphic_allocator<Key>,
+    Adaptor>;
+}  // namespace pmr
+}  // namespace proposed
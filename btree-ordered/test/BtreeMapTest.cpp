@@ -0,0 +1,231 @@
+#include <proposed/btree_map>
+#include <proposed/string>
+#include <gtest/gtest.h>
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+#include <test-utils/copy.h>
+
+using MapType =
+    proposed::btree_map<std::string,
+                       int,
+                       std::less<>,
+                       std::allocator<std::pair<const std::string, int>>,
+                       proposed::string_adaptor>;
+
+using namespace std::literals;
+using namespace test_utils;
+
+TEST(ProposedBtreeMap, ExactKeyType) {
+  auto const kHello = "Hello"s;
+  auto const kGoodbye = "Goodbye"s;
+  auto const kAdios = "Adios"s;
+  MapType testMap{};
+  testMap[kHello] = 1;
+  EXPECT_EQ(1, testMap.at(kHello));
+  auto x = testMap.insert_or_assign(kHello, 2);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(kHello));
+  x = testMap.try_emplace(kHello, 3);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(kHello));
+  x = testMap.insert_or_assign(kGoodbye, 4);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(4, x.first->second);
+  EXPECT_EQ(4, testMap.at(kGoodbye));
+  x = testMap.try_emplace(kAdios, 3);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(3, x.first->second);
+  EXPECT_EQ(3, testMap.at(kAdios));
+  EXPECT_EQ(1U, testMap.erase(kAdios));
+  EXPECT_EQ(0U, testMap.erase(kAdios));
+  testMap.clear();
+  // And again, with rvalues
+  testMap[copy(kHello)] = 1;
+  EXPECT_EQ(1, testMap.at(copy(kHello)));
+  x = testMap.insert_or_assign(copy(kHello), 2);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(copy(kHello)));
+  x = testMap.try_emplace(copy(kHello), 3);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(copy(kHello)));
+  x = testMap.insert_or_assign(copy(kGoodbye), 4);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(4, x.first->second);
+  EXPECT_EQ(4, testMap.at(copy(kGoodbye)));
+  x = testMap.try_emplace(copy(kAdios), 3);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(3, x.first->second);
+  EXPECT_EQ(3, testMap.at(copy(kAdios)));
+  EXPECT_EQ(1U, testMap.erase(copy(kAdios)));
+  EXPECT_EQ(0U, testMap.erase(copy(kAdios)));
+}
+
+TEST(ProposedBtreeMap, ImplicitlyConstructible) {
+  MapType testMap{};
+  testMap["Hello"] = 1;
+  EXPECT_EQ(1, testMap.at("Hello"));
+  auto x = testMap.insert_or_assign("Hello", 2);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at("Hello"));
+  x = testMap.try_emplace("Hello", 3);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at("Hello"));
+  x = testMap.insert_or_assign("Goodbye", 4);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(4, x.first->second);
+  EXPECT_EQ(4, testMap.at("Goodbye"));
+  x = testMap.try_emplace("Adios", 3);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(3, x.first->second);
+  EXPECT_EQ(3, testMap.at("Adios"));
+  EXPECT_EQ(1U, testMap.erase("Adios"));
+  EXPECT_EQ(0U, testMap.erase("Adios"));
+}
+
+TEST(ProposedBtreeMap, Adaptable) {
+  auto const kHello = "Hello"sv;
+  auto const kGoodbye = "Goodbye"sv;
+  auto const kAdios = "Adios"sv;
+  MapType testMap{};
+  testMap[kHello] = 1;
+  EXPECT_EQ(1, testMap.at(kHello));
+  auto x = testMap.insert_or_assign(kHello, 2);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(kHello));
+  x = testMap.try_emplace(kHello, 3);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(kHello));
+  x = testMap.insert_or_assign(kGoodbye, 4);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(4, x.first->second);
+  EXPECT_EQ(4, testMap.at(kGoodbye));
+  x = testMap.try_emplace(kAdios, 3);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(3, x.first->second);
+  EXPECT_EQ(3, testMap.at(kAdios));
+  EXPECT_EQ(1U, testMap.erase(kAdios));
+  EXPECT_EQ(0U, testMap.erase(kAdios));
+  testMap.clear();
+  // And again, with rvalues
+  testMap[copy(kHello)] = 1;
+  EXPECT_EQ(1, testMap.at(copy(kHello)));
+  x = testMap.insert_or_assign(copy(kHello), 2);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(copy(kHello)));
+  x = testMap.try_emplace(copy(kHello), 3);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(copy(kHello)));
+  x = testMap.insert_or_assign(copy(kGoodbye), 4);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(4, x.first->second);
+  EXPECT_EQ(4, testMap.at(copy(kGoodbye)));
+  x = testMap.try_emplace(copy(kAdios), 3);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(3, x.first->second);
+  EXPECT_EQ(3, testMap.at(copy(kAdios)));
+  EXPECT_EQ(1U, testMap.erase(copy(kAdios)));
+  EXPECT_EQ(0U, testMap.erase(copy(kAdios)));
+}
+
+TEST(ProposedBtreeMap, BulkConstruction) {
+  std::vector<std::pair<std::string, int>> const kInput = {
+      {"World", 1}, {"Hello", 2}, {"Map", 3}, {"Hello", 4}};
+  MapType testMap{kInput.begin(), kInput.end()};
+  std::vector<std::string> keys;
+  std::vector<int> values;
+  for (auto entry : testMap) {
+    keys.push_back(entry.first);
+    values.push_back(entry.second);
+  }
+  EXPECT_EQ((std::vector<std::string>{"Hello", "Map", "World"}), keys);
+  EXPECT_EQ((std::vector<int>{2, 3, 1}), values);
+  testMap.insert({{"Apple", 5}, {"World", 6}});
+  EXPECT_EQ(4U, testMap.size());
+  EXPECT_EQ(5, testMap.at("Apple"sv));
+  EXPECT_EQ(1, testMap.at("World"sv));
+  int total = 0;
+  for (auto entry : testMap) {
+    total += entry.second;
+  }
+  EXPECT_EQ(11, total);
+}
+
+TEST(ProposedBtreeMap, Hints) {
+  MapType testMap{};
+  auto last = testMap.end();
+  for (auto word : {"a"sv, "b"sv, "c"sv}) {
+    last = testMap.try_emplace(testMap.end(), word, 1);
+  }
+  EXPECT_EQ("c", last->first);
+  auto found = testMap.insert_or_assign(testMap.begin(), "b"sv, 7);
+  EXPECT_EQ(7, found->second);
+  EXPECT_EQ(3U, testMap.size());
+}
+
+TEST(ProposedBtreeMap, HintsExactKeyType) {
+  MapType testMap{};
+  testMap.try_emplace(testMap.end(), "b"s, 1);
+  testMap.insert_or_assign(testMap.end(), "c"s, 2);
+  auto found = testMap.try_emplace(testMap.end(), "b"s, 3);
+  EXPECT_EQ(1, found->second);
+  found = testMap.insert_or_assign(testMap.begin(), "c"s, 4);
+  EXPECT_EQ(4, found->second);
+  testMap.insert(testMap.begin(), {"a"s, 5});
+  EXPECT_EQ("a", testMap.begin()->first);
+  EXPECT_EQ(3U, testMap.size());
+}
+
+TEST(ProposedBtreeMap, ManyKeys) {
+  proposed::btree_map<int, int> testMap{};
+  std::map<int, int> expected{};
+  std::mt19937 rng{42};
+  std::uniform_int_distribution<int> keys{0, 20000};
+  for (int i = 0; i < 20000; ++i) {
+    auto key = keys(rng);
+    testMap[key] += i;
+    expected[key] += i;
+  }
+  for (int i = 0; i < 20000; ++i) {
+    auto key = keys(rng);
+    EXPECT_EQ(expected.erase(key), testMap.erase(key));
+  }
+  ASSERT_EQ(expected.size(), testMap.size());
+  EXPECT_TRUE(std::equal(
+      expected.begin(), expected.end(), testMap.begin(), testMap.end(),
+      [](auto const& lhs, auto rhs) {
+        return lhs.first == rhs.first && lhs.second == rhs.second;
+      }));
+  EXPECT_TRUE(std::equal(
+      expected.rbegin(), expected.rend(), testMap.rbegin(), testMap.rend(),
+      [](auto const& lhs, auto rhs) { return lhs.first == rhs.first; }));
+  for (int key = -1; key <= 20001; key += 7) {
+    auto found = testMap.lower_bound(key);
+    auto want = expected.lower_bound(key);
+    if (want == expected.end()) {
+      EXPECT_TRUE(found == testMap.end());
+    } else {
+      EXPECT_EQ(want->first, found->first);
+    }
+  }
+  auto copied = testMap;
+  EXPECT_TRUE(copied == testMap);
+  // Erasing through iterators walks everything exactly once
+  std::size_t erased = 0;
+  for (auto it = copied.begin(); it != copied.end(); ++erased) {
+    it = copied.erase(it);
+  }
+  EXPECT_EQ(expected.size(), erased);
+  EXPECT_TRUE(copied.empty());
+}
@@ -0,0 +1,113 @@
+#include <proposed/btree_multiset>
+#include <proposed/string>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <vector>
+#include <test-utils/copy.h>
+
+using MultiSetType = proposed::btree_multiset<std::string,
+                                             std::less<>,
+                                             std::allocator<std::string>,
+                                             proposed::string_adaptor>;
+
+using namespace std::literals;
+using namespace test_utils;
+
+TEST(ProposedBtreeMultiSet, ExactValueType) {
+  auto const kHello = "Hello"s;
+  auto const kMultiSet = "MultiSet"s;
+  auto const kWorld = "World"s;
+  std::initializer_list<std::string> kList = {kHello, kMultiSet, kWorld};
+  MultiSetType testMultiSet{};
+  testMultiSet.insert(kHello);
+  EXPECT_EQ(1U, testMultiSet.count(kHello));
+  testMultiSet.insert(kList);
+  EXPECT_EQ(2U, testMultiSet.count(kHello));
+  EXPECT_EQ(1U, testMultiSet.count(kMultiSet));
+  EXPECT_EQ(1U, testMultiSet.count(kWorld));
+  EXPECT_EQ(2U, testMultiSet.erase(kHello));
+  EXPECT_EQ(0U, testMultiSet.erase(kHello));
+  testMultiSet.clear();
+  // And again, with rvalues
+  testMultiSet.insert(copy(kHello));
+  EXPECT_EQ(1U, testMultiSet.count(copy(kHello)));
+  testMultiSet.insert(copy(kList));
+  EXPECT_EQ(2U, testMultiSet.count(copy(kHello)));
+  EXPECT_EQ(1U, testMultiSet.count(copy(kMultiSet)));
+  EXPECT_EQ(1U, testMultiSet.count(copy(kWorld)));
+  EXPECT_EQ(2U, testMultiSet.erase(copy(kHello)));
+  EXPECT_EQ(0U, testMultiSet.erase(copy(kHello)));
+}
+
+TEST(ProposedBtreeMultiSet, ImplicitlyConstructible) {
+  MultiSetType testMultiSet{};
+  testMultiSet.insert("Hello");
+  EXPECT_EQ(1U, testMultiSet.count("Hello"));
+  testMultiSet.insert({"Hello", "MultiSet", "World"});
+  EXPECT_EQ(2U, testMultiSet.count("Hello"));
+  EXPECT_EQ(1U, testMultiSet.count("MultiSet"));
+  EXPECT_EQ(1U, testMultiSet.count("World"));
+  EXPECT_EQ(2U, testMultiSet.erase("Hello"));
+  EXPECT_EQ(0U, testMultiSet.erase("Hello"));
+}
+
+TEST(ProposedBtreeMultiSet, Adaptable) {
+  auto const kHello = "Hello"sv;
+  auto const kMultiSet = "MultiSet"sv;
+  auto const kWorld = "World"sv;
+  std::initializer_list<std::string_view> kList = {kHello, kMultiSet, kWorld};
+  MultiSetType testMultiSet{};
+  testMultiSet.insert(kHello);
+  EXPECT_EQ(1U, testMultiSet.count(kHello));
+  testMultiSet.insert(kList);
+  EXPECT_EQ(2U, testMultiSet.count(kHello));
+  EXPECT_EQ(1U, testMultiSet.count(kMultiSet));
+  EXPECT_EQ(1U, testMultiSet.count(kWorld));
+  EXPECT_EQ(2U, testMultiSet.erase(kHello));
+  EXPECT_EQ(0U, testMultiSet.erase(kHello));
+  testMultiSet.clear();
+  // And again, with rvalues
+  testMultiSet.insert(copy(kHello));
+  EXPECT_EQ(1U, testMultiSet.count(copy(kHello)));
+  testMultiSet.insert(copy(kList));
+  EXPECT_EQ(2U, testMultiSet.count(copy(kHello)));
+  EXPECT_EQ(1U, testMultiSet.count(copy(kMultiSet)));
+  EXPECT_EQ(1U, testMultiSet.count(copy(kWorld)));
+  EXPECT_EQ(2U, testMultiSet.erase(copy(kHello)));
+  EXPECT_EQ(0U, testMultiSet.erase(copy(kHello)));
+}
+
+TEST(ProposedBtreeMultiSet, BulkConstruction) {
+  std::vector<std::string> const kInput = {"World", "Hello", "Set", "Hello"};
+  MultiSetType testMultiSet{kInput.begin(), kInput.end()};
+  EXPECT_EQ((std::vector<std::string>{"Hello", "Hello", "Set", "World"}),
+            std::vector<std::string>(testMultiSet.begin(), testMultiSet.end()));
+  testMultiSet.insert(testMultiSet.end(), "Hello"sv);
+  EXPECT_EQ(3U, testMultiSet.count("Hello"sv));
+}
+
+TEST(ProposedBtreeMultiSet, MatchesStdMultiSet) {
+  proposed::btree_multiset<int> testMultiSet{};
+  std::multiset<int> expected{};
+  std::mt19937 rng{11};
+  std::uniform_int_distribution<int> values{0, 500};
+  for (int i = 0; i < 20000; ++i) {
+    auto value = values(rng);
+    if (i % 3 == 0) {
+      testMultiSet.erase(value);
+      expected.erase(value);
+    } else {
+      testMultiSet.insert(testMultiSet.end(), value);
+      expected.insert(value);
+    }
+  }
+  ASSERT_EQ(expected.size(), testMultiSet.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(),
+                         testMultiSet.begin(), testMultiSet.end()));
+  for (int value = 0; value <= 500; ++value) {
+    EXPECT_EQ(expected.count(value), testMultiSet.count(value));
+  }
+}
@@ -0,0 +1,154 @@
+#include <proposed/btree_set>
+#include <proposed/string>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <vector>
+#include <test-utils/copy.h>
+
+using SetType = proposed::btree_set<std::string,
+                                   std::less<>,
+                                   std::allocator<std::string>,
+                                   proposed::string_adaptor>;
+
+using namespace std::literals;
+using namespace test_utils;
+
+TEST(ProposedBtreeSet, ExactValueType) {
+  auto const kHello = "Hello"s;
+  auto const kSet = "Set"s;
+  auto const kWorld = "World"s;
+  std::initializer_list<std::string> kList = {kHello, kSet, kWorld};
+  SetType testSet{};
+  testSet.insert(kHello);
+  EXPECT_EQ(1U, testSet.count(kHello));
+  testSet.insert(kList);
+  EXPECT_EQ(1U, testSet.count(kHello));
+  EXPECT_EQ(1U, testSet.count(kSet));
+  EXPECT_EQ(1U, testSet.count(kWorld));
+  EXPECT_EQ(1U, testSet.erase(kHello));
+  EXPECT_EQ(0U, testSet.erase(kHello));
+  testSet.clear();
+  // And again, with rvalues
+  testSet.insert(copy(kHello));
+  EXPECT_EQ(1U, testSet.count(copy(kHello)));
+  testSet.insert(copy(kList));
+  EXPECT_EQ(1U, testSet.count(copy(kHello)));
+  EXPECT_EQ(1U, testSet.count(copy(kSet)));
+  EXPECT_EQ(1U, testSet.count(copy(kWorld)));
+  EXPECT_EQ(1U, testSet.erase(copy(kHello)));
+  EXPECT_EQ(0U, testSet.erase(copy(kHello)));
+}
+
+TEST(ProposedBtreeSet, ImplicitlyConstructible) {
+  SetType testSet{};
+  testSet.insert("Hello");
+  EXPECT_EQ(1U, testSet.count("Hello"));
+  testSet.insert({"Hello", "Set", "World"});
+  EXPECT_EQ(1U, testSet.count("Hello"));
+  EXPECT_EQ(1U, testSet.count("Set"));
+  EXPECT_EQ(1U, testSet.count("World"));
+  EXPECT_EQ(1U, testSet.erase("Hello"));
+  EXPECT_EQ(0U, testSet.erase("Hello"));
+}
+
+TEST(ProposedBtreeSet, Adaptable) {
+  auto const kHello = "Hello"sv;
+  auto const kSet = "Set"sv;
+  auto const kWorld = "World"sv;
+  std::initializer_list<std::string_view> kList = {kHello, kSet, kWorld};
+  SetType testSet{};
+  testSet.insert(kHello);
+  EXPECT_EQ(1U, testSet.count(kHello));
+  testSet.insert(kList);
+  EXPECT_EQ(1U, testSet.count(kHello));
+  EXPECT_EQ(1U, testSet.count(kSet));
+  EXPECT_EQ(1U, testSet.count(kWorld));
+  EXPECT_EQ(1U, testSet.erase(kHello));
+  EXPECT_EQ(0U, testSet.erase(kHello));
+  testSet.clear();
+  // And again, with rvalues
+  testSet.insert(copy(kHello));
+  EXPECT_EQ(1U, testSet.count(copy(kHello)));
+  testSet.insert(copy(kList));
+  EXPECT_EQ(1U, testSet.count(copy(kHello)));
+  EXPECT_EQ(1U, testSet.count(copy(kSet)));
+  EXPECT_EQ(1U, testSet.count(copy(kWorld)));
+  EXPECT_EQ(1U, testSet.erase(copy(kHello)));
+  EXPECT_EQ(0U, testSet.erase(copy(kHello)));
+}
+
+TEST(ProposedBtreeSet, BulkConstruction) {
+  std::vector<std::string> const kInput = {"World", "Hello", "Set", "Hello"};
+  SetType testSet{kInput.begin(), kInput.end()};
+  EXPECT_EQ((std::vector<std::string>{"Hello", "Set", "World"}),
+            std::vector<std::string>(testSet.begin(), testSet.end()));
+  testSet.insert({"Apple"s, "World"s, "Zebra"s});
+  EXPECT_EQ((std::vector<std::string>{"Apple", "Hello", "Set", "World",
+                                      "Zebra"}),
+            std::vector<std::string>(testSet.begin(), testSet.end()));
+}
+
+TEST(ProposedBtreeSet, Hints) {
+  SetType testSet{};
+  for (auto word : {"a"sv, "b"sv, "c"sv, "d"sv}) {
+    testSet.insert(testSet.end(), word);
+  }
+  auto found = testSet.insert(testSet.begin(), "c"sv);
+  EXPECT_EQ("c", *found);
+  EXPECT_EQ(4U, testSet.size());
+  testSet.insert(testSet.begin(), "bb"sv);
+  EXPECT_EQ((std::vector<std::string>{"a", "b", "bb", "c", "d"}),
+            std::vector<std::string>(testSet.begin(), testSet.end()));
+}
+
+TEST(ProposedBtreeSet, MatchesStdSet) {
+  proposed::btree_set<int> testSet{};
+  std::set<int> expected{};
+  std::mt19937 rng{7};
+  std::uniform_int_distribution<int> values{0, 5000};
+  for (int round = 0; round < 4; ++round) {
+    for (int i = 0; i < 5000; ++i) {
+      auto value = values(rng);
+      // Alternate between good and bad hints
+      auto hint = i % 2 ? testSet.lower_bound(value) : testSet.begin();
+      testSet.insert(hint, value);
+      expected.insert(value);
+    }
+    for (int i = 0; i < 4000; ++i) {
+      auto value = values(rng);
+      auto found = testSet.find(value);
+      if (found != testSet.end()) {
+        auto next = testSet.erase(found);
+        auto expectedNext = expected.upper_bound(value);
+        if (expectedNext == expected.end()) {
+          EXPECT_TRUE(next == testSet.end());
+        } else {
+          EXPECT_EQ(*expectedNext, *next);
+        }
+      }
+      expected.erase(value);
+    }
+    ASSERT_EQ(expected.size(), testSet.size());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), testSet.begin(),
+                           testSet.end()));
+  }
+  testSet.erase(testSet.begin(), testSet.end());
+  EXPECT_TRUE(testSet.empty());
+  EXPECT_TRUE(testSet.begin() == testSet.end());
+}
+
+TEST(ProposedBtreeSet, AscendingHintedInsertion) {
+  proposed::btree_set<int> testSet{};
+  for (int i = 0; i < 10000; ++i) {
+    testSet.insert(testSet.end(), i);
+  }
+  EXPECT_EQ(10000U, testSet.size());
+  int expected = 0;
+  for (auto value : testSet) {
+    EXPECT_EQ(expected++, value);
+  }
+  EXPECT_EQ(9999, *testSet.rbegin());
+}
@@ -0,0 +1,115 @@
+#include <proposed/concurrent_map>
+#include <proposed/map>
+#include <proposed/string>
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Threads sharing one ordered index, with the given percentage of the
+// operations being insert_or_assign and the rest find. Half the key pool
+// is loaded beforehand. The baseline is a proposed::map behind a
+// reader-writer lock.
+
+namespace {
+using ConcurrentMap =
+    proposed::concurrent_map<std::string,
+                             std::uint64_t,
+                             std::less<>,
+                             std::allocator<std::pair<const std::string,
+                                                      std::uint64_t>>,
+                             proposed::string_adaptor>;
+using Map = proposed::map<std::string,
+                          std::uint64_t,
+                          std::less<>,
+                          std::allocator<std::pair<const std::string,
+                                                   std::uint64_t>>,
+                          proposed::string_adaptor>;
+
+constexpr std::size_t kKeys = 1 << 17;
+
+std::vector<std::string> const& keyPool() {
+  static auto const keys = [] {
+    std::vector<std::string> result;
+    char buffer[40];
+    for (std::size_t i = 0; i < kKeys; ++i) {
+      std::snprintf(buffer, sizeof(buffer), "a-longish-key-%012zu",
+                    (i * 2654435761U) % kKeys);
+      result.emplace_back(buffer);
+    }
+    return result;
+  }();
+  return keys;
+}
+
+struct LockedMap {
+  Map map;
+  mutable std::shared_mutex mutex;
+
+  bool find(std::string_view key) const {
+    std::shared_lock<std::shared_mutex> lock{mutex};
+    return map.find(key) != map.end();
+  }
+  void insert_or_assign(std::string_view key, std::uint64_t value) {
+    std::unique_lock<std::shared_mutex> lock{mutex};
+    map.insert_or_assign(key, value);
+  }
+};
+
+struct SharedConcurrentMap {
+  ConcurrentMap map;
+
+  bool find(std::string_view key) const {
+    return map.find(key) != map.end();
+  }
+  void insert_or_assign(std::string_view key, std::uint64_t value) {
+    map.insert_or_assign(key, value);
+  }
+};
+
+template <typename Shared>
+void BM_Mixed(benchmark::State& state) {
+  static std::unique_ptr<Shared> shared;
+  auto const& keys = keyPool();
+  if (state.thread_index() == 0) {
+    shared = std::make_unique<Shared>();
+    for (std::size_t i = 0; i < kKeys / 2; ++i) {
+      shared->insert_or_assign(keys[i], i);
+    }
+  }
+  auto const writePercent = static_cast<unsigned>(state.range(0));
+  std::mt19937_64 rng{static_cast<std::uint64_t>(state.thread_index())};
+  std::size_t hits = 0;
+  for (auto _ : state) {
+    auto const r = rng();
+    std::string_view key = keys[r % kKeys];
+    if ((r >> 32) % 100 < writePercent) {
+      shared->insert_or_assign(key, r);
+    } else {
+      hits += shared->find(key);
+    }
+  }
+  benchmark::DoNotOptimize(hits);
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    shared.reset();
+  }
+}
+
+void mixes(benchmark::internal::Benchmark* benchmark) {
+  for (auto writePercent : {0, 10, 50}) {
+    benchmark->Arg(writePercent);
+  }
+  benchmark->ThreadRange(1, 64)->UseRealTime();
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Mixed, LockedMap)->Apply(mixes);
+BENCHMARK_TEMPLATE(BM_Mixed, SharedConcurrentMap)->Apply(mixes);
+
+BENCHMARK_MAIN();
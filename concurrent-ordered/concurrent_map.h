@@ -0,0 +1,150 @@
+#pragma once
+
+#include <initializer_list>
+#include <memory_resource>
+#include "skiplist-base.h"
+
+namespace proposed {
+// An ordered map that can be searched, inserted into, assigned to and
+// iterated over by many threads at once. It has no erase; see
+// `detail::skiplist`. Mapped values are read and written under a per-element
+// lock, so iterators give copies of them. The adaptor may be called by
+// several threads at once.
+template <class Key,
+          class T,
+          class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>,
+          class KeyAdaptor = no_adaptor>
+struct concurrent_map : detail::skiplist<Key, T, Compare, Allocator> {
+ private:
+  using base_type = detail::skiplist<Key, T, Compare, Allocator>;
+  using key_adaptor = KeyAdaptor;
+
+ public:
+  using typename base_type::const_iterator;
+  using typename base_type::iterator;
+  using typename base_type::key_type;
+  using typename base_type::size_type;
+  using typename base_type::value_type;
+  using mapped_type = T;
+
+  using base_type::skiplist;
+
+  std::pair<iterator, bool> insert(value_type const& value) {
+    return try_emplace(value.first, value.second);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    detail::for_each_adapted_batch(
+        first, last, this->get_allocator(), [this](auto from, auto to) {
+          for (; from != to; ++from) {
+            insert(*from);
+          }
+        });
+  }
+  void insert(std::initializer_list<value_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  // As for std::map, except that the arguments may be used up even though
+  // nothing is inserted, if another thread inserts the key at the same time
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type const& key, Args&&... args) {
+    return try_emplace_helper(key, std::forward<Args>(args)...);
+  }
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+    return try_emplace_helper(std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(key_type const& key, M&& obj) {
+    return insert_or_assign_helper(key, std::forward<M>(obj));
+  }
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+    return insert_or_assign_helper(std::move(key), std::forward<M>(obj));
+  }
+
+ private:
+  key_adaptor keyAdaptor_;
+  static_assert(!adaptor_traits<key_adaptor>::is_adaptor ||
+                std::is_same_v<key_type, typename key_adaptor::target_type>);
+
+  template <typename AdaptableType>
+  static bool constexpr is_write_adaptable() {
+    return detail::is_write_adaptable_v<Key, iterator, const_iterator,
+                                        key_adaptor, AdaptableType>;
+  }
+
+  template <typename KT, typename... Args>
+  std::pair<iterator, bool> try_emplace_helper(KT&& key, Args&&... args) {
+    return this->emplace_unique(
+        key,
+        [&](key_type* p) {
+          ::new (static_cast<void*>(p)) key_type(std::forward<KT>(key));
+        },
+        std::forward<Args>(args)...);
+  }
+
+  template <typename KT, typename M>
+  std::pair<iterator, bool> insert_or_assign_helper(KT&& key, M&& obj) {
+    return this->template emplace_unique<true>(
+        key,
+        [&](key_type* p) {
+          ::new (static_cast<void*>(p)) key_type(std::forward<KT>(key));
+        },
+        std::forward<M>(obj));
+  }
+
+ public:
+  template <typename AdaptableType, typename... Args>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(),
+                          std::pair<iterator, bool>>::type
+  try_emplace(AdaptableType&& key, Args&&... args) {
+    return this->emplace_unique(
+        key,
+        [&](key_type* p) {
+          detail::adapt_using_allocator(keyAdaptor_,
+                                        p,
+                                        std::forward<AdaptableType>(key),
+                                        this->get_allocator());
+        },
+        std::forward<Args>(args)...);
+  }
+
+  template <typename AdaptableType, typename M>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(),
+                          std::pair<iterator, bool>>::type
+  insert_or_assign(AdaptableType&& key, M&& obj) {
+    return this->template emplace_unique<true>(
+        key,
+        [&](key_type* p) {
+          detail::adapt_using_allocator(keyAdaptor_,
+                                        p,
+                                        std::forward<AdaptableType>(key),
+                                        this->get_allocator());
+        },
+        std::forward<M>(obj));
+  }
+
+  // No operator[] or at(): they would hand out references to mapped values
+  // that other threads may be assigning to
+};
+
+namespace pmr {
+template <class Key,
+          class T,
+          class Compare = std::less<Key>,
+          class KeyAdaptor = no_adaptor>
+using concurrent_map = proposed::concurrent_map<
+    Key,
+    T,
+    Compare,
+    std::pmr::polymorphic_allocator<std::pair<const Key, T>>,
+    KeyAdaptor>;
+}  // namespace pmr
+}  // namespace proposed
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <initializer_list>
+#include <memory_resource>
+#include "skiplist-base.h"
+
+namespace proposed {
+// An ordered set that can be searched, inserted into and iterated over by
+// many threads at once. It has no erase; see `detail::skiplist`. The
+// adaptor may be called by several threads at once.
+template <class Key,
+          class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>,
+          class Adaptor = no_adaptor>
+struct concurrent_set : detail::skiplist<Key, void, Compare, Allocator> {
+ private:
+  using base_type = detail::skiplist<Key, void, Compare, Allocator>;
+  using key_adaptor = Adaptor;
+
+ public:
+  using typename base_type::const_iterator;
+  using typename base_type::iterator;
+  using typename base_type::key_type;
+  using typename base_type::size_type;
+  using typename base_type::value_type;
+
+  using base_type::skiplist;
+
+  std::pair<iterator, bool> insert(value_type const& value) {
+    return insert_helper(value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return insert_helper(std::move(value));
+  }
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    detail::for_each_adapted_batch(
+        first, last, this->get_allocator(), [this](auto from, auto to) {
+          for (; from != to; ++from) {
+            insert(*from);
+          }
+        });
+  }
+  void insert(std::initializer_list<value_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+ private:
+  key_adaptor keyAdaptor_;
+  static_assert(!adaptor_traits<key_adaptor>::is_adaptor ||
+                std::is_same_v<key_type, typename key_adaptor::target_type>);
+
+  template <typename AdaptableType>
+  static bool constexpr is_write_adaptable() {
+    return detail::is_write_adaptable_v<Key, iterator, const_iterator,
+                                        key_adaptor, AdaptableType>;
+  }
+
+  template <typename VT>
+  std::pair<iterator, bool> insert_helper(VT&& value) {
+    return this->emplace_unique(value, [&](key_type* p) {
+      ::new (static_cast<void*>(p)) key_type(std::forward<VT>(value));
+    });
+  }
+
+ public:
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(),
+                          std::pair<iterator, bool>>::type
+  insert(AdaptableType&& value) {
+    return this->emplace_unique(value, [&](key_type* p) {
+      detail::adapt_using_allocator(keyAdaptor_,
+                                    p,
+                                    std::forward<AdaptableType>(value),
+                                    this->get_allocator());
+    });
+  }
+
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType const&>()>::type
+  insert(std::initializer_list<AdaptableType> ilist) {
+    for (auto const& elem : ilist) {
+      insert(elem);
+    }
+  }
+};
+
+namespace pmr {
+template <class Key, class Compare = std::less<Key>, class Adaptor = no_adaptor>
+using concurrent_set = proposed::concurrent_set<
+    Key,
+    Compare,
+    std::pmr::polymorphic_allocator<Key>,
+    Adaptor>;
+}  // namespace pmr
+}  // namespace proposed
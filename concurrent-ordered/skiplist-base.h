@@ -0,0 +1,413 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <proposed/adaptor>
+#include <proposed/iterator>
+
+namespace proposed {
+namespace detail {
+// Guards a mapped value: writers assign it and readers copy it under the
+// lock, so nobody sees a value half-written.
+struct skiplist_spinlock {
+  void lock() noexcept {
+    while (locked_.exchange(true, std::memory_order_acquire)) {
+      while (locked_.load(std::memory_order_relaxed)) {
+        std::this_thread::yield();
+      }
+    }
+  }
+  void unlock() noexcept { locked_.store(false, std::memory_order_release); }
+
+ private:
+  std::atomic<bool> locked_{false};
+};
+
+// The mapped half of a node, built and destroyed by the skip list
+template <class Mapped>
+struct skiplist_mapped {
+  skiplist_mapped() {}
+  ~skiplist_mapped() {}
+  union {
+    Mapped mapped;
+  };
+  mutable skiplist_spinlock lock;
+};
+
+template <>
+struct skiplist_mapped<void> {};
+
+// A node is followed, in the same allocation, by its tower: one forward
+// pointer per level it is linked into.
+template <class Key, class Mapped>
+struct alignas(std::atomic<void*>) skiplist_node : skiplist_mapped<Mapped> {
+  using link = std::atomic<skiplist_node*>;
+
+  explicit skiplist_node(std::uint8_t height) : height(height) {}
+  ~skiplist_node() {}
+
+  link* tower() noexcept {
+    return reinterpret_cast<link*>(reinterpret_cast<unsigned char*>(this) +
+                                   sizeof(skiplist_node));
+  }
+
+  union {
+    Key key;
+  };
+  std::uint8_t const height;
+};
+
+// Skip list shared by `concurrent_map` (`Mapped` is the mapped type) and
+// `concurrent_set` (`Mapped` is void).
+//
+// Lookups, insertions and iteration may all run concurrently. Lookups take
+// no locks and write nothing. An insertion builds its node completely, then
+// publishes it with a compare-and-swap on the bottom level, which is the
+// list proper; the levels above are shortcuts, linked afterwards in the
+// same way. Nothing is ever unlinked, so a node found by one thread stays
+// valid however the others proceed, and there is no erase. Iterators walk
+// the bottom level and are weakly consistent: they see every element
+// present when they were created that they have not yet passed, and may or
+// may not see elements inserted since.
+//
+// Construction, destruction, assignment and swap are not concurrent.
+template <class Key, class Mapped, class Compare, class Allocator>
+struct skiplist {
+ private:
+  static constexpr bool kIsMap = !std::is_void<Mapped>::value;
+  using node = skiplist_node<Key, Mapped>;
+  using link = typename node::link;
+
+  // Each level keeps about a quarter of the nodes of the level below, which
+  // makes for short towers and still supports far more elements than fit in
+  // memory
+  static constexpr int kMaxHeight = 24;
+
+  struct alignas(node) block {
+    unsigned char bytes[alignof(node)];
+  };
+  using block_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<block>;
+  using block_traits = std::allocator_traits<block_allocator>;
+
+ public:
+  using key_type = Key;
+  using value_type =
+      std::conditional_t<kIsMap, std::pair<Key const, Mapped>, Key>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // Both iterator types are const: elements are only changed through the
+  // container, where the mapped value's lock can be taken. For maps,
+  // dereferencing gives the key and a copy of the mapped value.
+  struct const_iterator {
+    using difference_type = std::ptrdiff_t;
+    using value_type = typename skiplist::value_type;
+    using reference =
+        std::conditional_t<kIsMap, std::pair<Key const&, Mapped>, Key const&>;
+    using pointer =
+        std::conditional_t<kIsMap, arrow_proxy<reference>, Key const*>;
+    using iterator_category = std::forward_iterator_tag;
+
+    const_iterator() = default;
+
+    reference operator*() const {
+      if constexpr (kIsMap) {
+        std::lock_guard<skiplist_spinlock> guard{node_->lock};
+        return {node_->key, node_->mapped};
+      } else {
+        return node_->key;
+      }
+    }
+    pointer operator->() const {
+      if constexpr (kIsMap) {
+        return {**this};
+      } else {
+        return std::addressof(node_->key);
+      }
+    }
+
+    const_iterator& operator++() {
+      node_ = node_->tower()[0].load(std::memory_order_acquire);
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto result = *this;
+      ++*this;
+      return result;
+    }
+
+    friend bool operator==(const_iterator lhs, const_iterator rhs) {
+      return lhs.node_ == rhs.node_;
+    }
+    friend bool operator!=(const_iterator lhs, const_iterator rhs) {
+      return lhs.node_ != rhs.node_;
+    }
+
+   private:
+    friend struct skiplist;
+    explicit const_iterator(node* n) : node_(n) {}
+    node* node_ = nullptr;
+  };
+  using iterator = const_iterator;
+
+  skiplist() : skiplist(Compare{}) {}
+  explicit skiplist(Compare const& compare,
+                    Allocator const& alloc = Allocator{})
+      : compare_(compare), alloc_(alloc) {}
+  explicit skiplist(Allocator const& alloc) : skiplist(Compare{}, alloc) {}
+  skiplist(skiplist const&) = delete;
+  skiplist& operator=(skiplist const&) = delete;
+  ~skiplist() {
+    auto* current = head_[0].load(std::memory_order_relaxed);
+    while (current) {
+      auto* next = current->tower()[0].load(std::memory_order_relaxed);
+      destroy_node(current);
+      current = next;
+    }
+  }
+
+  const_iterator begin() const noexcept {
+    return const_iterator{head_[0].load(std::memory_order_acquire)};
+  }
+  const_iterator end() const noexcept { return const_iterator{}; }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  // Exact when no insertion is in progress
+  size_type size() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+  key_compare key_comp() const { return compare_; }
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+  const_iterator find(key_type const& key) const { return find_impl(key); }
+  template <typename K,
+            typename C = Compare,
+            typename = std::enable_if_t<is_transparent<C>::value>>
+  const_iterator find(K const& key) const {
+    return find_impl(key);
+  }
+
+  const_iterator lower_bound(key_type const& key) const {
+    return const_iterator{lower_bound_node(key)};
+  }
+  template <typename K,
+            typename C = Compare,
+            typename = std::enable_if_t<is_transparent<C>::value>>
+  const_iterator lower_bound(K const& key) const {
+    return const_iterator{lower_bound_node(key)};
+  }
+
+  size_type count(key_type const& key) const {
+    return find_impl(key) != end() ? 1 : 0;
+  }
+  template <typename K,
+            typename C = Compare,
+            typename = std::enable_if_t<is_transparent<C>::value>>
+  size_type count(K const& key) const {
+    return find_impl(key) != end() ? 1 : 0;
+  }
+
+ protected:
+  // Inserts a node unless one with an equivalent key is already present.
+  // `make_key(p)` constructs the key at `p`, and the mapped value is
+  // constructed from `args`. Neither is used if the key is found straight
+  // away; if it turns up while the node is being linked in, the node is
+  // thrown away. With `Assign`, the single argument is assigned to the
+  // mapped value of the element found instead.
+  template <bool Assign = false,
+            typename K,
+            typename MakeKey,
+            typename... Args>
+  std::pair<const_iterator, bool> emplace_unique(K const& key,
+                                                 MakeKey&& make_key,
+                                                 Args&&... args) {
+    link* preds[kMaxHeight];
+    node* succs[kMaxHeight];
+    if (find_position(key, preds, succs)) {
+      if constexpr (Assign) {
+        assign_mapped(const_iterator{succs[0]}, std::forward<Args>(args)...);
+      }
+      return {const_iterator{succs[0]}, false};
+    }
+    node* n = create_node(std::forward<MakeKey>(make_key),
+                          std::forward<Args>(args)...);
+    int const height = n->height;
+    auto* tower = n->tower();
+    // Publish on the bottom level, which makes the node part of the list
+    while (true) {
+      for (int level = 0; level < height; ++level) {
+        tower[level].store(succs[level], std::memory_order_relaxed);
+      }
+      if (preds[0][0].compare_exchange_strong(succs[0], n,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed)) {
+        break;
+      }
+      // Something was linked in next to us: look again
+      if (find_position(n->key, preds, succs)) {
+        if constexpr (Assign) {
+          assign_mapped(const_iterator{succs[0]}, std::move(n->mapped));
+        }
+        destroy_node(n);
+        return {const_iterator{succs[0]}, false};
+      }
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    // Then the shortcuts above it
+    for (int level = 1; level < height; ++level) {
+      while (true) {
+        tower[level].store(succs[level], std::memory_order_relaxed);
+        if (preds[level][level].compare_exchange_strong(
+                succs[level], n, std::memory_order_release,
+                std::memory_order_relaxed)) {
+          break;
+        }
+        find_position(n->key, preds, succs);
+      }
+    }
+    return {const_iterator{n}, true};
+  }
+
+  template <typename M>
+  static void assign_mapped(const_iterator position, M&& obj) {
+    std::lock_guard<skiplist_spinlock> guard{position.node_->lock};
+    position.node_->mapped = std::forward<M>(obj);
+  }
+
+ private:
+  template <typename K>
+  const_iterator find_impl(K const& key) const {
+    auto* n = lower_bound_node(key);
+    if (!n || compare_(key, n->key)) {
+      return end();
+    }
+    return const_iterator{n};
+  }
+
+  template <typename K>
+  node* lower_bound_node(K const& key) const {
+    link const* tower = head_;
+    node* current = nullptr;
+    // Known not to be before `key`: often where the level below stops too
+    node* bound = nullptr;
+    for (int level = kMaxHeight - 1; level >= 0; --level) {
+      current = tower[level].load(std::memory_order_acquire);
+      while (current != bound && compare_(current->key, key)) {
+        tower = current->tower();
+        current = tower[level].load(std::memory_order_acquire);
+      }
+      bound = current;
+    }
+    return current;
+  }
+
+  // Fills in, for each level, the tower holding the last link before `key`
+  // and the node that link points at. True if that node on the bottom
+  // level is equivalent to `key`.
+  template <typename K>
+  bool find_position(K const& key, link** preds, node** succs) {
+    link* tower = head_;
+    node* bound = nullptr;
+    for (int level = kMaxHeight - 1; level >= 0; --level) {
+      auto* current = tower[level].load(std::memory_order_acquire);
+      while (current != bound && compare_(current->key, key)) {
+        tower = current->tower();
+        current = tower[level].load(std::memory_order_acquire);
+      }
+      preds[level] = tower;
+      succs[level] = bound = current;
+    }
+    return succs[0] && !compare_(key, succs[0]->key);
+  }
+
+  static int random_height() noexcept {
+    // xorshift64*, one generator per thread
+    thread_local std::uint64_t state =
+        0x9E3779B97F4A7C15ULL ^
+        reinterpret_cast<std::uintptr_t>(&state);
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    auto const bits = state * 0x2545F4914F6CDD1DULL;
+    // Two bits per level: each level is reached with probability 1/4
+#if defined(__GNUC__)
+    int const height =
+        1 + __builtin_ctzll(bits | (std::uint64_t{1} << 62)) / 2;
+#else
+    int height = 1;
+    for (auto rest = bits; height < kMaxHeight && (rest & 3) == 0; rest >>= 2) {
+      ++height;
+    }
+#endif
+    return height < kMaxHeight ? height : kMaxHeight;
+  }
+
+  static size_type blocks_for(int height) noexcept {
+    return (sizeof(node) + height * sizeof(link) + sizeof(block) - 1) /
+           sizeof(block);
+  }
+
+  template <typename MakeKey, typename... Args>
+  node* create_node(MakeKey&& make_key, Args&&... args) {
+    int const height = random_height();
+    auto* storage = block_traits::allocate(alloc_, blocks_for(height));
+    auto* n = ::new (static_cast<void*>(storage))
+        node(static_cast<std::uint8_t>(height));
+    try {
+      make_key(std::addressof(n->key));
+    } catch (...) {
+      n->~node();
+      block_traits::deallocate(alloc_, storage, blocks_for(height));
+      throw;
+    }
+    if constexpr (kIsMap) {
+      try {
+        detail::construct_using_allocator(
+            std::addressof(n->mapped), alloc_, std::forward<Args>(args)...);
+      } catch (...) {
+        n->key.~Key();
+        n->~node();
+        block_traits::deallocate(alloc_, storage, blocks_for(height));
+        throw;
+      }
+    }
+    auto* tower = n->tower();
+    for (int level = 0; level < height; ++level) {
+      ::new (static_cast<void*>(tower + level)) link(nullptr);
+    }
+    return n;
+  }
+
+  void destroy_node(node* n) noexcept {
+    int const height = n->height;
+    if constexpr (kIsMap) {
+      n->mapped.~Mapped();
+    }
+    n->key.~Key();
+    n->~node();
+    block_traits::deallocate(alloc_, reinterpret_cast<block*>(n),
+                             blocks_for(height));
+  }
+
+  link head_[kMaxHeight] = {};
+  std::atomic<size_type> size_{0};
+  Compare compare_;
+  block_allocator alloc_;
+};
+}  // namespace detail
+}  // namespace proposed
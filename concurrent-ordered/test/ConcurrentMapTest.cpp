@@ -0,0 +1,66 @@
+#include <proposed/concurrent_map>
+#include <proposed/string>
+#include <gtest/gtest.h>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using MapType =
+    proposed::concurrent_map<std::string,
+                             int,
+                             std::less<>,
+                             std::allocator<std::pair<const std::string, int>>,
+                             proposed::string_adaptor>;
+
+using namespace std::literals;
+
+TEST(ProposedConcurrentMap, Basics) {
+  MapType testMap{};
+  EXPECT_TRUE(testMap.try_emplace("Hello"s, 1).second);
+  EXPECT_TRUE(testMap.try_emplace("World"sv, 2).second);
+  EXPECT_FALSE(testMap.try_emplace("Hello"sv, 3).second);
+  EXPECT_EQ(1, testMap.find("Hello"sv)->second);
+  auto result = testMap.insert_or_assign("Hello"sv, 4);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(4, result.first->second);
+  EXPECT_TRUE(testMap.insert_or_assign("Adios"sv, 5).second);
+  EXPECT_TRUE(testMap.insert({"Goodbye", 6}).second);
+  EXPECT_EQ(4U, testMap.size());
+  EXPECT_EQ("Goodbye", testMap.lower_bound("B"sv)->first);
+  std::vector<std::pair<std::string, int>> seen;
+  for (auto entry : testMap) {
+    seen.emplace_back(entry.first, entry.second);
+  }
+  EXPECT_EQ((std::vector<std::pair<std::string, int>>{
+                {"Adios", 5}, {"Goodbye", 6}, {"Hello", 4}, {"World", 2}}),
+            seen);
+}
+
+TEST(ProposedConcurrentMap, ConcurrentAssign) {
+  constexpr int kThreads = 8;
+  constexpr int kKeys = 500;
+  MapType testMap{};
+  std::vector<std::string> keys;
+  for (int i = 0; i < kKeys; ++i) {
+    keys.push_back(std::to_string(i));
+  }
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int round = 0; round < 4; ++round) {
+        for (auto const& key : keys) {
+          testMap.insert_or_assign(std::string_view{key}, t);
+          auto found = testMap.find(std::string_view{key});
+          // Whatever it is now, it must be one thread's value
+          auto value = found->second;
+          EXPECT_TRUE(value >= 0 && value < kThreads);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(static_cast<std::size_t>(kKeys), testMap.size());
+}
@@ -0,0 +1,76 @@
+#include <proposed/concurrent_set>
+#include <proposed/string>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using SetType = proposed::concurrent_set<std::string,
+                                         std::less<>,
+                                         std::allocator<std::string>,
+                                         proposed::string_adaptor>;
+
+using namespace std::literals;
+
+TEST(ProposedConcurrentSet, Basics) {
+  SetType testSet{};
+  EXPECT_TRUE(testSet.empty());
+  EXPECT_TRUE(testSet.insert("Hello"s).second);
+  EXPECT_TRUE(testSet.insert("World"sv).second);
+  EXPECT_FALSE(testSet.insert("Hello"sv).second);
+  testSet.insert({"Set"sv, "A"sv});
+  EXPECT_EQ(4U, testSet.size());
+  EXPECT_EQ(1U, testSet.count("Set"sv));
+  EXPECT_EQ(0U, testSet.count("Nope"));
+  EXPECT_EQ("Hello", *testSet.find("Hello"sv));
+  EXPECT_EQ(testSet.end(), testSet.find("B"sv));
+  EXPECT_EQ("Hello", *testSet.lower_bound("B"sv));
+  EXPECT_EQ(testSet.end(), testSet.lower_bound("Z"sv));
+  std::vector<std::string> const kExpected = {"A", "Hello", "Set", "World"};
+  EXPECT_TRUE(std::equal(testSet.begin(), testSet.end(), kExpected.begin(),
+                         kExpected.end()));
+}
+
+TEST(ProposedConcurrentSet, ConcurrentInsertAndIterate) {
+  constexpr int kThreads = 8;
+  constexpr int kPerThread = 2000;
+  proposed::concurrent_set<int> testSet{};
+  std::atomic<bool> done{false};
+  // Readers check that what they see is always in order
+  std::atomic<int> disorder{0};
+  std::thread reader{[&] {
+    while (!done.load()) {
+      int previous = -1;
+      for (int value : testSet) {
+        if (value <= previous) {
+          ++disorder;
+        }
+        previous = value;
+      }
+    }
+  }};
+  std::vector<std::thread> writers;
+  for (int t = 0; t < kThreads; ++t) {
+    writers.emplace_back([&, t] {
+      // Every value is inserted by two threads
+      for (int i = 0; i < kPerThread; ++i) {
+        testSet.insert((i * kThreads + t) / 2);
+      }
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+  done = true;
+  reader.join();
+  EXPECT_EQ(0, disorder.load());
+  EXPECT_EQ(static_cast<std::size_t>(kThreads * kPerThread / 2),
+            testSet.size());
+  int expected = 0;
+  for (int value : testSet) {
+    EXPECT_EQ(expected++, value);
+  }
+}
@@ -5,7 +5,7 @@ using size_type = typename base_type::size_type;
 using difference_type = typename base_type::difference_type;
 using key_compare = typename base_type::key_compare;
 using value_compare = typename base_type::value_compare;
-using allocator_type = typename base_type::allocator_type;
+using allocator_type = Allocator;
 using reference = typename base_type::reference;
 using const_reference = typename base_type::const_reference;
 using pointer = typename base_type::pointer;
@@ -16,7 +16,9 @@ using reverse_iterator = typename base_type::reverse_iterator;
 using const_reverse_iterator = typename base_type::const_reverse_iterator;
 
 using base_type::operator=;
-using base_type::get_allocator;
+allocator_type get_allocator() const noexcept {
+  return base_type::get_allocator();
+}
 
 using base_type::begin;
 using base_type::end;
@@ -47,9 +49,6 @@ using base_type::upper_bound;
 using base_type::key_comp;
 using base_type::value_comp;
 
-/*
-  using base_type::extract;
-  using base_type::merge;
-  using node_type = typename base_type::node_type;
-  using insert_return_type = typename base_type::insert_return_type;
-  */
+using base_type::extract;
+using base_type::merge;
+using node_type = typename base_type::node_type;
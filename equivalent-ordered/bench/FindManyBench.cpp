@@ -0,0 +1,101 @@
+#include <proposed/map>
+#include <proposed/string>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Resolving a batch of 10K keys against a map, one find at a time and with
+// find_many. Random batches are spread over the whole map; clustered ones
+// come from a window twice the size of the batch.
+
+namespace {
+using MapType = proposed::map<std::string,
+                              int,
+                              std::less<>,
+                              std::allocator<std::pair<const std::string, int>>,
+                              proposed::string_adaptor>;
+
+constexpr std::size_t kBatch = 10000;
+
+struct Fixture {
+  std::vector<std::string> keys;
+  MapType map;
+  std::vector<std::string_view> probes;
+
+  explicit Fixture(benchmark::State const& state) {
+    auto const count = static_cast<std::size_t>(state.range(0));
+    bool const clustered = state.range(1) != 0;
+    char buffer[40];
+    for (std::size_t i = 0; i < count; ++i) {
+      std::snprintf(buffer, sizeof(buffer), "a-longish-key-%012zu", i);
+      keys.emplace_back(buffer);
+    }
+    std::vector<std::pair<std::string_view, int>> entries;
+    for (auto const& key : keys) {
+      entries.emplace_back(key, 0);
+    }
+    map.assign_sorted(entries.begin(), entries.end());
+    std::mt19937_64 rng{count};
+    std::size_t const window = clustered ? 2 * kBatch : count;
+    std::size_t const start = std::uniform_int_distribution<std::size_t>{
+        0, count - window}(rng);
+    std::uniform_int_distribution<std::size_t> pick{start, start + window - 1};
+    for (std::size_t i = 0; i < kBatch; ++i) {
+      probes.push_back(keys[pick(rng)]);
+    }
+  }
+};
+
+void BM_FindEach(benchmark::State& state) {
+  Fixture fixture{state};
+  std::vector<MapType::iterator> found(kBatch);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kBatch; ++i) {
+      found[i] = fixture.map.find(fixture.probes[i]);
+    }
+    benchmark::DoNotOptimize(found.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+void BM_FindMany(benchmark::State& state) {
+  Fixture fixture{state};
+  std::vector<MapType::iterator> found(kBatch);
+  for (auto _ : state) {
+    fixture.map.find_many(fixture.probes.begin(), fixture.probes.end(),
+                          found.begin());
+    benchmark::DoNotOptimize(found.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+void BM_FindManySorted(benchmark::State& state) {
+  Fixture fixture{state};
+  std::sort(fixture.probes.begin(), fixture.probes.end());
+  std::vector<MapType::iterator> found(kBatch);
+  for (auto _ : state) {
+    fixture.map.find_many(fixture.probes.begin(), fixture.probes.end(),
+                          found.begin());
+    benchmark::DoNotOptimize(found.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+void batches(benchmark::internal::Benchmark* benchmark) {
+  for (auto count : {1 << 16, 1 << 20}) {
+    for (auto clustered : {0, 1}) {
+      benchmark->Args({count, clustered});
+    }
+  }
+}
+}  // namespace
+
+BENCHMARK(BM_FindEach)->Apply(batches);
+BENCHMARK(BM_FindMany)->Apply(batches);
+BENCHMARK(BM_FindManySorted)->Apply(batches);
+
+BENCHMARK_MAIN();
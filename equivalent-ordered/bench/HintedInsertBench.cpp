@@ -0,0 +1,159 @@
+#include <proposed/map>
+#include <proposed/set>
+#include <proposed/string>
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Adapting inserts of sorted input with a good hint, and `assign_sorted`,
+// should cost the same per item however big the container is; the unhinted
+// inserts are there for comparison. Keys are longer than the small-string
+// buffer, so any stray key copy shows up as an allocation.
+
+namespace {
+using SetType = proposed::set<std::string,
+                              std::less<>,
+                              std::allocator<std::string>,
+                              proposed::string_adaptor>;
+using MapType = proposed::map<std::string,
+                              int,
+                              std::less<>,
+                              std::allocator<std::pair<const std::string, int>>,
+                              proposed::string_adaptor>;
+
+std::vector<std::string> makeKeys(std::size_t count) {
+  std::vector<std::string> result;
+  result.reserve(count);
+  char buffer[40];
+  for (std::size_t i = 0; i < count; ++i) {
+    std::snprintf(buffer, sizeof(buffer), "a-longish-key-%012zu", i);
+    result.emplace_back(buffer);
+  }
+  return result;
+}
+
+void BM_SetSortedInsert(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  for (auto _ : state) {
+    SetType set;
+    for (auto const& key : keys) {
+      set.insert(std::string_view{key});
+    }
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SetSortedHintedInsert(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  for (auto _ : state) {
+    SetType set;
+    for (auto const& key : keys) {
+      set.insert(set.end(), std::string_view{key});
+    }
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SetAssignSorted(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  std::vector<std::string_view> const views(keys.begin(), keys.end());
+  for (auto _ : state) {
+    SetType set;
+    set.assign_sorted(views.begin(), views.end());
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Every key is already present and the hint is its position
+void BM_SetSortedHintedHit(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  SetType set;
+  for (auto const& key : keys) {
+    set.insert(set.end(), std::string_view{key});
+  }
+  for (auto _ : state) {
+    auto hint = set.begin();
+    for (auto const& key : keys) {
+      hint = set.insert(hint, std::string_view{key});
+      ++hint;
+    }
+    benchmark::DoNotOptimize(hint);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MapSortedInsert(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  for (auto _ : state) {
+    MapType map;
+    for (auto const& key : keys) {
+      map.try_emplace(std::string_view{key}, 1);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MapSortedHintedInsert(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  for (auto _ : state) {
+    MapType map;
+    for (auto const& key : keys) {
+      map.try_emplace(map.end(), std::string_view{key}, 1);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MapAssignSorted(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  std::vector<std::pair<std::string_view, int>> entries;
+  for (auto const& key : keys) {
+    entries.emplace_back(key, 1);
+  }
+  for (auto _ : state) {
+    MapType map;
+    map.assign_sorted(entries.begin(), entries.end());
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MapSortedHintedHit(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  MapType map;
+  for (auto const& key : keys) {
+    map.try_emplace(map.end(), std::string_view{key}, 1);
+  }
+  for (auto _ : state) {
+    auto hint = map.begin();
+    for (auto const& key : keys) {
+      hint = map.insert_or_assign(hint, std::string_view{key}, 2);
+      ++hint;
+    }
+    benchmark::DoNotOptimize(hint);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void keyCounts(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Arg(1 << 10)->Arg(1 << 15)->Arg(1 << 20);
+}
+}  // namespace
+
+BENCHMARK(BM_SetSortedInsert)->Apply(keyCounts);
+BENCHMARK(BM_SetSortedHintedInsert)->Apply(keyCounts);
+BENCHMARK(BM_SetAssignSorted)->Apply(keyCounts);
+BENCHMARK(BM_SetSortedHintedHit)->Apply(keyCounts);
+BENCHMARK(BM_MapSortedInsert)->Apply(keyCounts);
+BENCHMARK(BM_MapSortedHintedInsert)->Apply(keyCounts);
+BENCHMARK(BM_MapAssignSorted)->Apply(keyCounts);
+BENCHMARK(BM_MapSortedHintedHit)->Apply(keyCounts);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,70 @@
+#include <proposed/set>
+#include <proposed/string>
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// An eviction queue ordered by key: each step drops the oldest entry and
+// adds a new newest one. Keys are longer than the small-string buffer.
+
+namespace {
+using SetType = proposed::set<std::string,
+                              std::less<>,
+                              std::allocator<std::string>,
+                              proposed::string_adaptor>;
+
+std::vector<std::string> makeKeys(std::size_t count) {
+  std::vector<std::string> result;
+  result.reserve(count);
+  char buffer[40];
+  for (std::size_t i = 0; i < count; ++i) {
+    std::snprintf(buffer, sizeof(buffer), "a-longish-key-%012zu", i);
+    result.emplace_back(buffer);
+  }
+  return result;
+}
+
+template <typename Step>
+void runQueue(benchmark::State& state, Step&& step) {
+  auto const count = static_cast<std::size_t>(state.range(0));
+  auto const keys = makeKeys(2 * count);
+  SetType set;
+  set.assign_sorted(keys.begin(), keys.begin() + count);
+  std::size_t next = count;
+  for (auto _ : state) {
+    step(set, std::string_view{keys[next]});
+    if (++next == keys.size()) {
+      state.PauseTiming();
+      set.assign_sorted(keys.begin(), keys.begin() + count);
+      next = count;
+      state.ResumeTiming();
+    }
+  }
+}
+
+void BM_EraseInsert(benchmark::State& state) {
+  runQueue(state, [](SetType& set, std::string_view key) {
+    set.erase(set.begin());
+    set.insert(set.end(), key);
+  });
+}
+
+void BM_ExtractRekey(benchmark::State& state) {
+  runQueue(state, [](SetType& set, std::string_view key) {
+    auto node = set.extract(set.begin());
+    set.rekey(node, key);
+    set.insert(set.end(), std::move(node));
+  });
+}
+
+void keyCounts(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Arg(1 << 10)->Arg(1 << 15)->Arg(1 << 20);
+}
+}  // namespace
+
+BENCHMARK(BM_EraseInsert)->Apply(keyCounts);
+BENCHMARK(BM_ExtractRekey)->Apply(keyCounts);
+
+BENCHMARK_MAIN();
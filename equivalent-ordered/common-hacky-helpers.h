@@ -15,20 +15,6 @@ static bool constexpr is_write_adaptable() {
          adaptor_traits<A>::template adapts<AdaptableType>;
 }
 
-template <typename A, typename AdaptableType>
-typename std::enable_if_t<is_write_adaptable<A, AdaptableType>(), key_type>
-adapt(A adaptor, AdaptableType&& adaptee) {
-  // Hack to avoid calling the default constructor
-  union X {
-    X() : x(0) {}
-    ~X() noexcept {}
-    char x;
-    key_type result;
-  } x;
-  adaptor.adapt(&x.result, std::forward<AdaptableType>(adaptee));
-  return std::move(x.result);
-}
-
 // The bool is false if the element is already present
 template <typename AdaptableType>
 std::pair<iterator, bool> findHint(AdaptableType const& value) {
@@ -50,13 +36,15 @@ template <typename AdaptableType>
 std::pair<const_iterator, bool> findHint(const_iterator hint,
                                          AdaptableType const& value) const {
   Compare compare{};
+  // A good hint is the lower bound: it is not ordered before `value`, and the
+  // element before it is
   if (hint != end() && compare(value_from_iterator(hint), value)) {
     // Bad initial hint
     hint = lower_bound(value);
   } else if (hint != begin()) {
     const_iterator prev = hint;
     --prev;
-    if (!compare(value_from_iterator(hint), value)) {
+    if (!compare(value_from_iterator(prev), value)) {
       // Bad initial hint
       hint = lower_bound(value);
     }
@@ -64,9 +52,184 @@ std::pair<const_iterator, bool> findHint(const_iterator hint,
   return {hint, hint == end() || compare(value, value_from_iterator(hint))};
 }
 
+// Erasing an empty range hands back a mutable iterator to the same element
+// in constant time, without touching the element.
 iterator get_iterator(const_iterator in) {
-  if (in == cend()) {
-    return end();
+  return this->base_type::erase(in, in);
+}
+
+// Where an element equivalent to `value` goes after any already present,
+// using `hint` when it is that place
+template <typename AdaptableType>
+const_iterator findUpperHint(const_iterator hint,
+                             AdaptableType const& value) const {
+  Compare compare{};
+  if (hint != end() && !compare(value, value_from_iterator(hint))) {
+    // Bad initial hint
+    return upper_bound(value);
+  } else if (hint != begin()) {
+    const_iterator prev = hint;
+    --prev;
+    if (compare(value, value_from_iterator(prev))) {
+      // Bad initial hint
+      return upper_bound(value);
+    }
+  }
+  return hint;
+}
+
+// How far a batched search steps forward from the previous result before it
+// falls back to a search from the root
+static constexpr int kFingerSteps = 4;
+
+template <typename AdaptableType>
+const_iterator fingerLowerBound(const_iterator finger,
+                                AdaptableType const& value) const {
+  Compare compare{};
+  for (int step = 0; step < kFingerSteps; ++step) {
+    if (finger == end() || !compare(value_from_iterator(finger), value)) {
+      return finger;
+    }
+    ++finger;
+  }
+  return lower_bound(value);
+}
+
+// Calls `visit(i, lower_bound(first[i]))` for each key, taking the keys in
+// sorted order so that each search starts from the result of the last
+template <typename RandomIt, typename Visit>
+void visitLowerBounds(RandomIt first, RandomIt last, Visit&& visit) const {
+  Compare compare{};
+  auto const count = static_cast<std::size_t>(last - first);
+  auto finger = cbegin();
+  if (std::is_sorted(first, last, compare)) {
+    for (std::size_t i = 0; i < count; ++i) {
+      finger = fingerLowerBound(finger, first[i]);
+      visit(i, finger);
+    }
+    return;
+  }
+  std::vector<std::size_t> order(count);
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+    return compare(first[lhs], first[rhs]);
+  });
+  for (auto i : order) {
+    finger = fingerLowerBound(finger, first[i]);
+    visit(i, finger);
   }
-  return insert(in, *in);
 }
+
+public:
+// As the std container's range insert, except that a range from
+// `adapt_input_iterator` is adapted with this container's allocator, and in
+// batches if its adaptor has `adapt_n`
+template <typename InputIt>
+void insert(InputIt first, InputIt last) {
+  detail::for_each_adapted_batch(
+      first, last, get_allocator(), [this](auto from, auto to) {
+        this->base_type::insert(from, to);
+      });
+}
+
+// Inserts a range sorted by `key_comp()`, whose elements may be keys (or
+// values, for maps) or adaptable. Each element is placed just after the
+// one before it, which costs a comparison or two while the input stays
+// sorted; an element out of order costs an ordinary insert, so the check
+// that the input is sorted is built in. Loading sorted input into an empty
+// container is linear.
+template <typename InputIt>
+void insert_sorted(InputIt first, InputIt last) {
+  const_iterator hint = cend();
+  for (; first != last; ++first) {
+    auto&& element = *first;
+    auto const& key = sorted_key(element);
+    if constexpr (kUniqueKeys) {
+      auto found = findHint(hint, key);
+      if (!found.second) {
+        hint = std::next(found.first);
+        continue;
+      }
+      hint = found.first;
+    } else {
+      hint = findUpperHint(hint, key);
+    }
+    // The new element goes just before `hint`, which is then where the next
+    // one should go. (Stepping past the new element instead would climb the
+    // tree whenever it is the last.)
+    emplace_sorted(hint, std::forward<decltype(element)>(element));
+  }
+}
+
+// Replaces the contents with a sorted range, as `insert_sorted`
+template <typename InputIt>
+void assign_sorted(InputIt first, InputIt last) {
+  clear();
+  insert_sorted(first, last);
+}
+
+// Extracts the first element equivalent to `key`, if there is one
+template <typename AdaptableType>
+typename std::enable_if_t<
+    is_write_adaptable<key_adaptor, AdaptableType const&>(),
+    node_type>
+extract(AdaptableType const& key) {
+  auto found = findHint(key);
+  if (found.second) {
+    return {};
+  }
+  return extract(found.first);
+}
+
+// Gives an extracted node a new key adapted from `key`, so that it can be
+// inserted again without allocating a node. The key is built by the key
+// adaptor, as inserting `key` would build it, and moved into the node.
+template <typename AdaptableType>
+typename std::enable_if_t<is_write_adaptable<key_adaptor, AdaptableType>()>
+rekey(node_type& node, AdaptableType&& key) {
+  node_key(node) = detail::adapt_to<key_type>(
+      keyAdaptor_, std::forward<AdaptableType>(key), get_allocator());
+}
+
+// Batched lookups: the result for `first[i]` is written to `out[i]`. The
+// keys may be in any order, but are searched in sorted order, each search
+// starting from the last result; sorted keys are not sorted again.
+template <typename RandomIt, typename OutputIt>
+OutputIt lower_bound_many(RandomIt first, RandomIt last, OutputIt out) {
+  visitLowerBounds(first, last, [&](std::size_t i, const_iterator found) {
+    out[i] = get_iterator(found);
+  });
+  return out + (last - first);
+}
+
+template <typename RandomIt, typename OutputIt>
+OutputIt lower_bound_many(RandomIt first, RandomIt last, OutputIt out) const {
+  visitLowerBounds(first, last, [&](std::size_t i, const_iterator found) {
+    out[i] = found;
+  });
+  return out + (last - first);
+}
+
+template <typename RandomIt, typename OutputIt>
+OutputIt find_many(RandomIt first, RandomIt last, OutputIt out) {
+  Compare compare{};
+  visitLowerBounds(first, last, [&](std::size_t i, const_iterator found) {
+    out[i] = found == end() || compare(first[i], value_from_iterator(found))
+                 ? end()
+                 : get_iterator(found);
+  });
+  return out + (last - first);
+}
+
+template <typename RandomIt, typename OutputIt>
+OutputIt find_many(RandomIt first, RandomIt last, OutputIt out) const {
+  Compare compare{};
+  visitLowerBounds(first, last, [&](std::size_t i, const_iterator found) {
+    out[i] = found == end() || compare(first[i], value_from_iterator(found))
+                 ? end()
+                 : found;
+  });
+  return out + (last - first);
+}
+
+private:
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <map>
+#include <memory_resource>
+#include <numeric>
+#include <vector>
 #include <proposed/adaptor>
+#include "node-allocator.h"
 
 namespace proposed {
 template <class Key,
@@ -10,10 +16,12 @@ template <class Key,
           class Allocator = std::allocator<std::pair<const Key, T>>,
           class KeyAdaptor = no_adaptor,
           class ValueAdaptor = no_adaptor>
-struct map : std::map<Key, T, Compare, Allocator> {
+struct map
+    : std::map<Key, T, Compare, detail::node_allocator<Allocator>> {
  private:
   using this_type = map<Key, T, Compare, Allocator>;
-  using base_type = std::map<Key, T, Compare, Allocator>;
+  using base_type =
+      std::map<Key, T, Compare, detail::node_allocator<Allocator>>;
   using key_adaptor = KeyAdaptor;
   using value_adaptor = ValueAdaptor;
 
@@ -24,11 +32,41 @@ struct map : std::map<Key, T, Compare, Allocator> {
   using base_type::insert_or_assign;
   using base_type::try_emplace;
 #include "base-hack.h"
+  using insert_return_type = typename base_type::insert_return_type;
  private:
   static inline key_type const& value_from_iterator(const_iterator in) {
     return in->first;
   }
+  static inline key_type& node_key(node_type& node) { return node.key(); }
+  static constexpr bool kUniqueKeys = true;
+  template <typename P>
+  static auto const& sorted_key(P const& value) {
+    return value.first;
+  }
+  template <typename P>
+  iterator emplace_sorted(const_iterator hint, P&& value) {
+    if constexpr (is_write_adaptable<key_adaptor, decltype(value.first)>()) {
+      return emplace_adapted(hint, std::forward<P>(value).first,
+                             std::forward<P>(value).second);
+    } else {
+      return this->base_type::emplace_hint(hint, std::forward<P>(value).first,
+                                           std::forward<P>(value).second);
+    }
+  }
 #include "common-hacky-helpers.h"
+  // Builds the key in the new node with the key adaptor; the hint must be
+  // where the key belongs
+  template <typename AdaptableType, typename... Args>
+  iterator emplace_adapted(const_iterator hint,
+                           AdaptableType&& key,
+                           Args&&... args) {
+    return this->base_type::emplace_hint(
+        hint, std::piecewise_construct,
+        std::forward_as_tuple(detail::make_adapt_in_place(
+            keyAdaptor_, std::forward<AdaptableType>(key))),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
  public:
   template <typename AdaptableType, typename M>
   typename std::enable_if<is_write_adaptable<key_adaptor, AdaptableType>(),
@@ -39,10 +77,8 @@ struct map : std::map<Key, T, Compare, Allocator> {
       found.first->second = std::forward<M>(obj);
       return found;
     }
-    return {this->base_type::insert_or_assign(
-                found.first, adapt<KeyAdaptor>(
-                                 keyAdaptor_, std::forward<AdaptableType>(key)),
-                std::forward<M>(obj)),
+    return {emplace_adapted(found.first, std::forward<AdaptableType>(key),
+                            std::forward<M>(obj)),
             true};
   }
 
@@ -56,10 +92,8 @@ struct map : std::map<Key, T, Compare, Allocator> {
       result->second = std::forward<M>(obj);
       return result;
     }
-    return this->base_type::insert_or_assign(
-        found.first,
-        adapt<KeyAdaptor>(keyAdaptor_, std::forward<AdaptableType>(key)),
-        std::forward<M>(obj));
+    return emplace_adapted(found.first, std::forward<AdaptableType>(key),
+                           std::forward<M>(obj));
   }
 
   template <typename AdaptableType, typename... Args>
@@ -70,10 +104,8 @@ struct map : std::map<Key, T, Compare, Allocator> {
     if (!found.second) {
       return found;
     }
-    return {this->base_type::try_emplace(
-                found.first, adapt<KeyAdaptor>(
-                                 keyAdaptor_, std::forward<AdaptableType>(key)),
-                std::forward<Args>(args)...),
+    return {emplace_adapted(found.first, std::forward<AdaptableType>(key),
+                            std::forward<Args>(args)...),
             true};
   }
 
@@ -85,10 +117,8 @@ struct map : std::map<Key, T, Compare, Allocator> {
     if (!found.second) {
       return get_iterator(found.first);
     }
-    return this->base_type::try_emplace(
-        found.first,
-        adapt<KeyAdaptor>(keyAdaptor_, std::forward<AdaptableType>(key)),
-        std::forward<Args>(args)...);
+    return emplace_adapted(found.first, std::forward<AdaptableType>(key),
+                           std::forward<Args>(args)...);
   }
 
   template <typename AdaptableType>
@@ -132,16 +162,20 @@ struct map : std::map<Key, T, Compare, Allocator> {
   }
 
   // Can't do emplace or emplace_hint - Ambiguity
-
-  // template <typename AdaptableType>
-  // typename std::enable_if<is_write_adaptable<key_adaptor, AdaptableType,0>(),
-  //                         node_type>::type
-  // extract(const AdaptableType& key) {
-  //   auto found = findHint(key);
-  //   if (found.second) {
-  //     return {};
-  //   }
-  //   return extract(found.first);
-  // }
 };
+
+namespace pmr {
+template <class Key,
+          class T,
+          class Compare = std::less<Key>,
+          class KeyAdaptor = no_adaptor,
+          class ValueAdaptor = no_adaptor>
+using map = proposed::map<
+    Key,
+    T,
+    Compare,
+    std::pmr::polymorphic_allocator<std::pair<const Key, T>>,
+    KeyAdaptor,
+    ValueAdaptor>;
+}  // namespace pmr
 }
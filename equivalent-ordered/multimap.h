@@ -1,7 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <map>
+#include <memory_resource>
+#include <numeric>
+#include <vector>
 #include <proposed/adaptor>
+#include "node-allocator.h"
 
 namespace proposed {
 template <class Key,
@@ -10,10 +16,12 @@ template <class Key,
           class Allocator = std::allocator<std::pair<const Key, T>>,
           class KeyAdaptor = no_adaptor,
           class ValueAdaptor = no_adaptor>
-struct multimap : std::multimap<Key, T, Compare, Allocator> {
+struct multimap
+    : std::multimap<Key, T, Compare, detail::node_allocator<Allocator>> {
  private:
   using this_type = multimap<Key, T, Compare, Allocator>;
-  using base_type = std::multimap<Key, T, Compare, Allocator>;
+  using base_type =
+      std::multimap<Key, T, Compare, detail::node_allocator<Allocator>>;
   using key_adaptor = KeyAdaptor;
   using value_adaptor = ValueAdaptor;
 
@@ -24,6 +32,25 @@ struct multimap : std::multimap<Key, T, Compare, Allocator> {
   static inline key_type const& value_from_iterator(const_iterator in) {
     return in->first;
   }
+  static inline key_type& node_key(node_type& node) { return node.key(); }
+  static constexpr bool kUniqueKeys = false;
+  template <typename P>
+  static auto const& sorted_key(P const& value) {
+    return value.first;
+  }
+  template <typename P>
+  iterator emplace_sorted(const_iterator hint, P&& value) {
+    if constexpr (is_write_adaptable<key_adaptor, decltype(value.first)>()) {
+      return this->base_type::emplace_hint(
+          hint, std::piecewise_construct,
+          std::forward_as_tuple(detail::make_adapt_in_place(
+              keyAdaptor_, std::forward<P>(value).first)),
+          std::forward_as_tuple(std::forward<P>(value).second));
+    } else {
+      return this->base_type::emplace_hint(hint, std::forward<P>(value).first,
+                                           std::forward<P>(value).second);
+    }
+  }
 #include "common-hacky-helpers.h"
  public:
   template <typename AdaptableType>
@@ -43,17 +70,20 @@ struct multimap : std::multimap<Key, T, Compare, Allocator> {
   }
 
   // Can't do insert, emplace or emplace_hint - Ambiguity
-
-  // template <typename AdaptableType>
-  // typename std::enable_if<is_write_adaptable<key_adaptor, AdaptableType
-  // const&>(),
-  //                         node_type>::type
-  // extract(const AdaptableType& key) {
-  //   auto found = findHint(key);
-  //   if (found.second) {
-  //     return {};
-  //   }
-  //   return extract(found.first);
-  // }
 };
+
+namespace pmr {
+template <class Key,
+          class T,
+          class Compare = std::less<Key>,
+          class KeyAdaptor = no_adaptor,
+          class ValueAdaptor = no_adaptor>
+using multimap = proposed::multimap<
+    Key,
+    T,
+    Compare,
+    std::pmr::polymorphic_allocator<std::pair<const Key, T>>,
+    KeyAdaptor,
+    ValueAdaptor>;
+}  // namespace pmr
 }
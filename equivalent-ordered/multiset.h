@@ -1,17 +1,25 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
 #include <set>
+#include <numeric>
+#include <vector>
 #include <proposed/adaptor>
+#include "node-allocator.h"
 
 namespace proposed {
 template <class Key,
           class Compare = std::less<Key>,
           class Allocator = std::allocator<Key>,
           class Adaptor = no_adaptor>
-struct multiset : std::multiset<Key, Compare, Allocator> {
+struct multiset
+    : std::multiset<Key, Compare, detail::node_allocator<Allocator>> {
  private:
   using this_type = multiset<Key, Compare, Allocator>;
-  using base_type = std::multiset<Key, Compare, Allocator>;
+  using base_type =
+      std::multiset<Key, Compare, detail::node_allocator<Allocator>>;
   using key_adaptor = Adaptor;
   using value_adaptor = Adaptor;
 
@@ -22,6 +30,21 @@ struct multiset : std::multiset<Key, Compare, Allocator> {
   static inline key_type const& value_from_iterator(const_iterator in) {
     return *in;
   }
+  static inline key_type& node_key(node_type& node) { return node.value(); }
+  static constexpr bool kUniqueKeys = false;
+  template <typename X>
+  static X const& sorted_key(X const& value) {
+    return value;
+  }
+  template <typename X>
+  iterator emplace_sorted(const_iterator hint, X&& value) {
+    if constexpr (is_write_adaptable<key_adaptor, X>()) {
+      return emplace_hint(hint, detail::make_adapt_in_place(
+                                    keyAdaptor_, std::forward<X>(value)));
+    } else {
+      return emplace_hint(hint, std::forward<X>(value));
+    }
+  }
 #include "common-hacky-helpers.h"
  public:
   template <typename AdaptableType>
@@ -29,16 +52,18 @@ struct multiset : std::multiset<Key, Compare, Allocator> {
                           iterator>::type
   insert(AdaptableType&& value) {
     auto found = upper_bound(value);
-    return insert(found, adapt<key_adaptor>(
-                             keyAdaptor_, std::forward<AdaptableType>(value)));
+    return emplace_hint(found,
+                        detail::make_adapt_in_place(
+                            keyAdaptor_, std::forward<AdaptableType>(value)));
   }
 
   template <typename AdaptableType>
   typename std::enable_if<is_write_adaptable<key_adaptor, AdaptableType>(),
                           iterator>::type
   insert(const_iterator hint, AdaptableType&& value) {
-    return insert(hint, adapt<key_adaptor>(keyAdaptor_,
-                                           std::forward<AdaptableType>(value)));
+    return emplace_hint(hint,
+                        detail::make_adapt_in_place(
+                            keyAdaptor_, std::forward<AdaptableType>(value)));
   }
 
   template <typename AdaptableType>
@@ -68,17 +93,14 @@ struct multiset : std::multiset<Key, Compare, Allocator> {
   }
 
   // Can't do emplace or emplace_hint - Ambiguity
-
-  // template <typename AdaptableType>
-  // typename std::enable_if<is_write_adaptable<key_adaptor, AdaptableType
-  // const&>(),
-  //                         node_type>::type
-  // extract(const AdaptableType& key) {
-  //   auto found = findHint(key);
-  //   if (found.second) {
-  //     return {};
-  //   }
-  //   return extract(found.first);
-  // }
 };
+
+namespace pmr {
+template <class Key, class Compare = std::less<Key>, class Adaptor = no_adaptor>
+using multiset = proposed::multiset<
+    Key,
+    Compare,
+    std::pmr::polymorphic_allocator<Key>,
+    Adaptor>;
+}  // namespace pmr
 }
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <proposed/adaptor>
+
+namespace proposed {
+namespace detail {
+// Asks `node_allocator` to construct a key by running `adaptor` over `input`
+// straight into the node being built, rather than moving in a key that was
+// adapted somewhere else first.
+template <typename Adaptor, typename X>
+struct adapt_in_place {
+  Adaptor& adaptor;
+  X&& input;
+};
+
+template <typename Adaptor, typename X>
+adapt_in_place<Adaptor, X> make_adapt_in_place(Adaptor& adaptor, X&& input) {
+  return {adaptor, std::forward<X>(input)};
+}
+
+template <typename T>
+struct is_adapt_in_place : std::false_type {};
+template <typename Adaptor, typename X>
+struct is_adapt_in_place<adapt_in_place<Adaptor, X>> : std::true_type {};
+
+// The allocator the equivalent-ordered containers hand to their std base.
+// It behaves exactly like `Allocator`, except that it recognises
+// `adapt_in_place` among the construction arguments: the node-based
+// containers only say where an element lives when they ask their allocator
+// to construct it, so this is the one place an adaptor can write into the
+// node itself.
+template <typename Allocator>
+struct node_allocator : Allocator {
+ private:
+  using traits = std::allocator_traits<Allocator>;
+
+ public:
+  template <typename U>
+  struct rebind {
+    using other =
+        node_allocator<typename traits::template rebind_alloc<U>>;
+  };
+
+  // So that, for example, a `pmr` container can be built from just a
+  // `std::pmr::memory_resource*`
+  using Allocator::Allocator;
+  node_allocator() = default;
+  node_allocator(Allocator const& allocator) noexcept : Allocator(allocator) {}
+  template <typename Other>
+  node_allocator(node_allocator<Other> const& other) noexcept
+      : Allocator(static_cast<Other const&>(other)) {}
+
+  template <typename U, typename... Args>
+  void construct(U* p, Args&&... args) {
+    Allocator& allocator = *this;
+    traits::construct(allocator, p, std::forward<Args>(args)...);
+  }
+
+  // Sets and multisets
+  template <typename U, typename Adaptor, typename X>
+  void construct(U* p, adapt_in_place<Adaptor, X>&& key) {
+    detail::adapt_using_allocator(key.adaptor,
+                                  p,
+                                  std::forward<X>(key.input),
+                                  static_cast<Allocator const&>(*this));
+  }
+
+  // Maps and multimaps, by way of `emplace_hint(hint, piecewise_construct,
+  // forward_as_tuple(key), forward_as_tuple(args...))`. The members are
+  // built one at a time, as pair's constructor would.
+  template <typename K, typename V, typename Key, typename... Args>
+  std::enable_if_t<is_adapt_in_place<std::decay_t<Key>>::value> construct(
+      std::pair<K const, V>* p,
+      std::piecewise_construct_t,
+      std::tuple<Key> key,
+      std::tuple<Args...> args) {
+    auto&& keyArgs = std::get<0>(key);
+    auto* pKey = const_cast<K*>(std::addressof(p->first));
+    Allocator const& allocator = *this;
+    detail::adapt_using_allocator(
+        keyArgs.adaptor,
+        pKey,
+        std::forward<decltype(keyArgs.input)>(keyArgs.input),
+        allocator);
+    try {
+      std::apply(
+          [&](auto&&... mappedArgs) {
+            detail::construct_using_allocator(
+                std::addressof(p->second),
+                allocator,
+                std::forward<decltype(mappedArgs)>(mappedArgs)...);
+          },
+          std::move(args));
+    } catch (...) {
+      pKey->~K();
+      throw;
+    }
+  }
+};
+}  // namespace detail
+}  // namespace proposed
@@ -1,27 +1,51 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
 #include <set>
+#include <numeric>
+#include <vector>
 #include <proposed/adaptor>
+#include "node-allocator.h"
 
 namespace proposed {
 template <class Key,
           class Compare = std::less<Key>,
           class Allocator = std::allocator<Key>,
           class Adaptor = no_adaptor>
-struct set : std::set<Key, Compare, Allocator> {
+struct set
+    : std::set<Key, Compare, detail::node_allocator<Allocator>> {
  private:
   using this_type = set<Key, Compare, Allocator>;
-  using base_type = std::set<Key, Compare, Allocator>;
+  using base_type =
+      std::set<Key, Compare, detail::node_allocator<Allocator>>;
   using key_adaptor = Adaptor;
   using value_adaptor = Adaptor;
 
  public:
   using base_type::set;
 #include "base-hack.h"
+  using insert_return_type = typename base_type::insert_return_type;
  private:
   static inline key_type const& value_from_iterator(const_iterator in) {
     return *in;
   }
+  static inline key_type& node_key(node_type& node) { return node.value(); }
+  static constexpr bool kUniqueKeys = true;
+  template <typename X>
+  static X const& sorted_key(X const& value) {
+    return value;
+  }
+  template <typename X>
+  iterator emplace_sorted(const_iterator hint, X&& value) {
+    if constexpr (is_write_adaptable<key_adaptor, X>()) {
+      return emplace_hint(hint, detail::make_adapt_in_place(
+                                    keyAdaptor_, std::forward<X>(value)));
+    } else {
+      return emplace_hint(hint, std::forward<X>(value));
+    }
+  }
 #include "common-hacky-helpers.h"
  public:
   template <typename AdaptableType>
@@ -32,9 +56,9 @@ struct set : std::set<Key, Compare, Allocator> {
     if (!found.second) {
       return found;
     }
-    return {insert(found.first,
-                   adapt<key_adaptor>(keyAdaptor_,
-                                      std::forward<AdaptableType>(value))),
+    return {emplace_hint(found.first,
+                         detail::make_adapt_in_place(
+                             keyAdaptor_, std::forward<AdaptableType>(value))),
             true};
   }
 
@@ -46,9 +70,9 @@ struct set : std::set<Key, Compare, Allocator> {
     if (!found.second) {
       return get_iterator(found.first);
     }
-    return insert(
-        found.first,
-        adapt<key_adaptor>(keyAdaptor_, std::forward<AdaptableType>(value)));
+    return emplace_hint(
+        found.first, detail::make_adapt_in_place(
+                         keyAdaptor_, std::forward<AdaptableType>(value)));
   }
 
   template <typename AdaptableType>
@@ -74,17 +98,11 @@ struct set : std::set<Key, Compare, Allocator> {
   }
 
   // Can't do emplace or emplace_hint - Ambiguity
-
-  // template <typename AdaptableType>
-  // typename std::enable_if<is_write_adaptable<key_adaptor, AdaptableType
-  // const&>(),
-  //                         node_type>::type
-  // extract(const AdaptableType& key) {
-  //   auto found = findHint(key);
-  //   if (found.second) {
-  //     return {};
-  //   }
-  //   return extract(found.first);
-  // }
 };
+
+namespace pmr {
+template <class Key, class Compare = std::less<Key>, class Adaptor = no_adaptor>
+using set =
+    proposed::set<Key, Compare, std::pmr::polymorphic_allocator<Key>, Adaptor>;
+}  // namespace pmr
 }
@@ -1,8 +1,11 @@
 #include <proposed/map>
+#include <proposed/multimap>
 #include <proposed/string>
 #include <gtest/gtest.h>
 #include <functional>
+#include <vector>
 #include <test-utils/copy.h>
+#include <test-utils/pinned.h>
 
 using MapType = proposed::map<std::string,
                               int,
@@ -134,3 +137,97 @@ TEST(ProposedMap, Adaptable) {
   EXPECT_EQ(1U, testMap.erase(copy(kAdios)));
   EXPECT_EQ(0U, testMap.erase(copy(kAdios)));
 }
+
+TEST(ProposedMap, HintedAdaptable) {
+  MapType testMap{};
+  for (auto key : {"A"sv, "B"sv, "C"sv}) {
+    auto it = testMap.try_emplace(testMap.end(), key, 1);
+    EXPECT_EQ(key, it->first);
+  }
+  // Already present, with the hint at the element itself
+  auto hint = testMap.begin();
+  for (auto key : {"A"sv, "B"sv, "C"sv}) {
+    auto it = testMap.insert_or_assign(hint, key, 2);
+    EXPECT_EQ(hint, it);
+    EXPECT_EQ(2, it->second);
+    it = testMap.try_emplace(hint, key, 3);
+    EXPECT_EQ(hint, it);
+    EXPECT_EQ(2, it->second);
+    ++hint;
+  }
+  // Bad hints
+  EXPECT_EQ("BB"sv, testMap.try_emplace(testMap.begin(), "BB"sv, 1)->first);
+  EXPECT_EQ(4, testMap.insert_or_assign(testMap.end(), "A"sv, 4)->second);
+  EXPECT_EQ(4U, testMap.size());
+}
+
+TEST(ProposedMap, AdaptsInPlace) {
+  proposed::map<Pinned, std::string, std::less<>,
+                std::allocator<std::pair<const Pinned, std::string>>,
+                pinned_adaptor>
+      testMap{};
+  EXPECT_TRUE(testMap.try_emplace(2, 3, 'b').second);
+  EXPECT_TRUE(testMap.insert_or_assign(1, "a").second);
+  EXPECT_FALSE(testMap.try_emplace(2, "x").second);
+  EXPECT_EQ("c", testMap.try_emplace(testMap.end(), 3, "c")->second);
+  EXPECT_EQ("bbb", testMap.at(2));
+  EXPECT_EQ("z", testMap[4] = "z");
+  EXPECT_EQ(4U, testMap.size());
+}
+
+TEST(ProposedMap, InsertSorted) {
+  std::vector<std::pair<std::string_view, int>> const kSorted = {
+      {"A", 1}, {"B", 2}, {"B", 3}, {"D", 4}, {"C", 5}};
+  MapType testMap{};
+  testMap.assign_sorted(kSorted.begin(), kSorted.end());
+  EXPECT_EQ((MapType{{"A", 1}, {"B", 2}, {"C", 5}, {"D", 4}}), testMap);
+  MapType other{{"B", 7}, {"Z", 8}};
+  testMap.insert_sorted(other.begin(), other.end());
+  EXPECT_EQ((MapType{{"A", 1}, {"B", 2}, {"C", 5}, {"D", 4}, {"Z", 8}}),
+            testMap);
+}
+
+TEST(ProposedMap, ExtractMergeRekey) {
+  MapType testMap{{"A", 1}, {"B", 2}, {"C", 3}};
+  EXPECT_TRUE(testMap.extract("Z"sv).empty());
+  auto node = testMap.extract("B"sv);
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ("B", node.key());
+  EXPECT_EQ(2, node.mapped());
+  testMap.rekey(node, "D"sv);
+  auto result = testMap.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ((MapType{{"A", 1}, {"C", 3}, {"D", 2}}), testMap);
+
+  proposed::multimap<std::string, int, std::less<>,
+                     std::allocator<std::pair<const std::string, int>>,
+                     proposed::string_adaptor>
+      other{{"C", 4}, {"E", 5}, {"E", 6}};
+  testMap.merge(other);
+  EXPECT_EQ((MapType{{"A", 1}, {"C", 3}, {"D", 2}, {"E", 5}}), testMap);
+  EXPECT_EQ(2U, other.size());
+}
+
+TEST(ProposedMap, FindMany) {
+  MapType testMap{};
+  std::vector<std::string> keys;
+  for (int i = 0; i < 100; ++i) {
+    keys.push_back(std::to_string(1000 + 2 * i));
+    testMap[keys.back()] = i;
+  }
+  // Both near and far from each other, out of order, and some missing
+  std::vector<std::string_view> probes;
+  for (int i = 0; i < 300; i += 7) {
+    probes.push_back(keys[(i * 37) % keys.size()]);
+  }
+  auto const kMissing = "1001"s;
+  probes.push_back(kMissing);
+  std::vector<MapType::iterator> found(probes.size());
+  EXPECT_EQ(found.end(),
+            testMap.find_many(probes.begin(), probes.end(), found.begin()));
+  for (std::size_t i = 0; i < probes.size(); ++i) {
+    EXPECT_EQ(testMap.find(probes[i]), found[i]);
+  }
+  found.front()->second = -1;
+  EXPECT_EQ(-1, testMap.at(probes.front()));
+}
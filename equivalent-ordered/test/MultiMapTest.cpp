@@ -1,7 +1,9 @@
 #include <proposed/multimap>
 #include <proposed/string>
 #include <gtest/gtest.h>
+#include <cctype>
 #include <functional>
+#include <vector>
 
 using MultiMapType =
     proposed::multimap<std::string,
@@ -62,3 +64,77 @@ TEST(ProposedMultiMap, Adaptable) {
   EXPECT_EQ(0u, testMultiMap.count("Hello"sv));
   EXPECT_EQ(4u, testMultiMap.size());
 }
+
+TEST(ProposedMultiMap, InsertSorted) {
+  std::vector<std::pair<std::string_view, int>> const kSorted = {
+      {"A", 1}, {"B", 2}, {"B", 3}, {"A", 4}};
+  MultiMapType testMultiMap{};
+  testMultiMap.assign_sorted(kSorted.begin(), kSorted.end());
+  testMultiMap.insert_sorted(kSorted.begin() + 1, kSorted.end());
+  // Equivalent keys stay in the order they were inserted
+  EXPECT_EQ((MultiMapType{
+                {"A", 1}, {"A", 4}, {"A", 4}, {"B", 2}, {"B", 3}, {"B", 2},
+                {"B", 3}}),
+            testMultiMap);
+}
+
+TEST(ProposedMultiMap, ExtractMergeRekey) {
+  MultiMapType testMultiMap{{"A", 1}, {"B", 2}, {"B", 3}, {"B", 4}, {"C", 5}};
+  EXPECT_TRUE(testMultiMap.extract("Z"sv).empty());
+  // The first of the equivalent elements is the one extracted
+  auto node = testMultiMap.extract("B"sv);
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ("B", node.key());
+  EXPECT_EQ(2, node.mapped());
+  // And a rekeyed node goes after those it is now equivalent to
+  testMultiMap.rekey(node, "A"sv);
+  testMultiMap.insert(std::move(node));
+  EXPECT_EQ((MultiMapType{{"A", 1}, {"A", 2}, {"B", 3}, {"B", 4}, {"C", 5}}),
+            testMultiMap);
+
+  // Every element is merged in, after any it is equivalent to
+  MultiMapType other{{"B", 6}, {"C", 7}, {"C", 8}};
+  testMultiMap.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ((MultiMapType{{"A", 1}, {"A", 2}, {"B", 3}, {"B", 4}, {"B", 6},
+                          {"C", 5}, {"C", 7}, {"C", 8}}),
+            testMultiMap);
+  EXPECT_EQ(3U, testMultiMap.count("C"sv));
+}
+
+namespace {
+// Keys are stored in lower case, whatever case they are given in
+struct lowercase_adaptor {
+  using target_type = std::string;
+  template <typename X>
+  static bool constexpr adapts{std::is_same_v<X, std::string_view>};
+
+  void adapt(target_type* pResult, std::string_view input) {
+    auto* result = ::new (static_cast<void*>(pResult)) target_type(input);
+    for (auto& c : *result) {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+  }
+};
+}  // namespace
+
+TEST(ProposedMultiMap, RekeyAdaptsKey) {
+  proposed::multimap<std::string, int, std::less<>,
+                     std::allocator<std::pair<const std::string, int>>,
+                     lowercase_adaptor>
+      testMultiMap{};
+  std::vector<std::pair<std::string_view, int>> const kSorted = {
+      {"ABC", 1}, {"Def", 2}};
+  testMultiMap.insert_sorted(kSorted.begin(), kSorted.end());
+  auto node = testMultiMap.extract("abc"sv);
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ("abc", node.key());
+  // The new key is built as inserting it would build it
+  testMultiMap.rekey(node, "XYZ"sv);
+  EXPECT_EQ("xyz", node.key());
+  testMultiMap.insert(std::move(node));
+  EXPECT_EQ((std::vector<std::pair<const std::string, int>>{{"def", 2},
+                                                            {"xyz", 1}}),
+            (std::vector<std::pair<const std::string, int>>(
+                testMultiMap.begin(), testMultiMap.end())));
+}
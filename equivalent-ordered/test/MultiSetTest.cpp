@@ -1,7 +1,9 @@
 #include <proposed/multiset>
+#include <proposed/set>
 #include <proposed/string>
 #include <gtest/gtest.h>
 #include <functional>
+#include <vector>
 #include <test-utils/copy.h>
 
 using MultiSetType = proposed::multiset<std::string,
@@ -75,3 +77,26 @@ TEST(ProposedMultiSet, Adaptable) {
   EXPECT_EQ(2U, testMultiSet.erase(copy(kHello)));
   EXPECT_EQ(0U, testMultiSet.erase(copy(kHello)));
 }
+
+TEST(ProposedMultiSet, InsertSorted) {
+  std::vector<std::string_view> const kSorted = {"A", "B", "B", "D", "C"};
+  MultiSetType testMultiSet{};
+  testMultiSet.assign_sorted(kSorted.begin(), kSorted.end());
+  EXPECT_EQ((MultiSetType{"A", "B", "B", "C", "D"}), testMultiSet);
+  testMultiSet.insert_sorted(kSorted.begin(), kSorted.begin() + 3);
+  EXPECT_EQ((MultiSetType{"A", "A", "B", "B", "B", "B", "C", "D"}),
+            testMultiSet);
+}
+
+TEST(ProposedMultiSet, ExtractMergeRekey) {
+  MultiSetType testMultiSet{"A", "B", "B"};
+  auto node = testMultiSet.extract("B"sv);
+  ASSERT_FALSE(node.empty());
+  testMultiSet.rekey(node, "A"sv);
+  testMultiSet.insert(std::move(node));
+  EXPECT_EQ((MultiSetType{"A", "A", "B"}), testMultiSet);
+  proposed::set<std::string, std::less<>> other{"B", "C"};
+  testMultiSet.merge(other);
+  EXPECT_EQ((MultiSetType{"A", "A", "B", "B", "C"}), testMultiSet);
+  EXPECT_TRUE(other.empty());
+}
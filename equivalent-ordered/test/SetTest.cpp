@@ -2,7 +2,9 @@
 #include <proposed/string>
 #include <gtest/gtest.h>
 #include <functional>
+#include <vector>
 #include <test-utils/copy.h>
+#include <test-utils/pinned.h>
 
 using SetType = proposed::set<std::string,
                               std::less<>,
@@ -75,3 +77,94 @@ TEST(ProposedSet, Adaptable) {
   EXPECT_EQ(1U, testSet.erase(copy(kHello)));
   EXPECT_EQ(0U, testSet.erase(copy(kHello)));
 }
+
+TEST(ProposedSet, HintedAdaptable) {
+  SetType testSet{};
+  // Good hints, sorted input
+  for (auto key : {"A"sv, "B"sv, "C"sv, "D"sv}) {
+    auto it = testSet.insert(testSet.end(), key);
+    EXPECT_EQ(key, *it);
+  }
+  // Already present, with the hint at the element itself
+  auto hint = testSet.begin();
+  for (auto key : {"A"sv, "B"sv, "C"sv, "D"sv}) {
+    auto it = testSet.insert(hint, key);
+    EXPECT_EQ(hint, it);
+    EXPECT_EQ(key, *it);
+    ++hint;
+  }
+  // Bad hints, before and after the right place
+  EXPECT_EQ("BB"sv, *testSet.insert(testSet.begin(), "BB"sv));
+  EXPECT_EQ("BC"sv, *testSet.insert(testSet.end(), "BC"sv));
+  EXPECT_EQ("C"sv, *testSet.insert(testSet.begin(), "C"sv));
+  EXPECT_EQ("A"sv, *testSet.insert(testSet.end(), "A"sv));
+  EXPECT_EQ(6U, testSet.size());
+}
+
+TEST(ProposedSet, AdaptsInPlace) {
+  proposed::set<Pinned, std::less<>, std::allocator<Pinned>, pinned_adaptor>
+      testSet{};
+  EXPECT_TRUE(testSet.insert(2).second);
+  EXPECT_TRUE(testSet.insert(1).second);
+  EXPECT_FALSE(testSet.insert(2).second);
+  EXPECT_EQ(3, testSet.insert(testSet.end(), 3)->value);
+  EXPECT_EQ(3U, testSet.size());
+  EXPECT_EQ(1, testSet.begin()->value);
+}
+
+TEST(ProposedSet, InsertSorted) {
+  std::vector<std::string_view> const kSorted = {"A", "B", "B", "C", "E"};
+  SetType testSet{};
+  testSet.assign_sorted(kSorted.begin(), kSorted.end());
+  EXPECT_EQ((SetType{"A", "B", "C", "E"}), testSet);
+  // Overlapping, and out of order part way through
+  std::vector<std::string_view> const kMore = {"C", "D", "F", "A0", "G"};
+  testSet.insert_sorted(kMore.begin(), kMore.end());
+  EXPECT_EQ((SetType{"A", "A0", "B", "C", "D", "E", "F", "G"}), testSet);
+  std::vector<std::string> const kKeys = {"X", "Y"};
+  testSet.assign_sorted(kKeys.begin(), kKeys.end());
+  EXPECT_EQ((SetType{"X", "Y"}), testSet);
+}
+
+TEST(ProposedSet, ExtractMergeRekey) {
+  SetType testSet{"A", "B", "C"};
+  EXPECT_TRUE(testSet.extract("Z"sv).empty());
+  auto node = testSet.extract("B"sv);
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ("B", node.value());
+  auto const* storage = &node.value();
+  // Re-keying keeps the node, and so the storage for the key
+  testSet.rekey(node, "D"sv);
+  auto result = testSet.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ(storage, &*result.position);
+  EXPECT_EQ((SetType{"A", "C", "D"}), testSet);
+
+  // Same key type, no adaptor
+  proposed::set<std::string, std::less<>> other{"C", "E"};
+  testSet.merge(other);
+  EXPECT_EQ((SetType{"A", "C", "D", "E"}), testSet);
+  EXPECT_EQ(1U, other.size());
+  EXPECT_EQ(1U, other.count("C"));
+}
+
+TEST(ProposedSet, FindMany) {
+  SetType testSet{"B", "D", "F", "H"};
+  std::vector<std::string_view> const kSorted = {"A", "B", "C", "H", "I"};
+  std::vector<SetType::iterator> found(kSorted.size());
+  testSet.find_many(kSorted.begin(), kSorted.end(), found.begin());
+  EXPECT_EQ((std::vector<SetType::iterator>{testSet.end(),
+                                            testSet.find("B"),
+                                            testSet.end(),
+                                            testSet.find("H"),
+                                            testSet.end()}),
+            found);
+  std::vector<std::string_view> const kUnsorted = {"I", "C", "A", "H", "C"};
+  SetType const& constSet = testSet;
+  std::vector<SetType::const_iterator> bounds(kUnsorted.size());
+  constSet.lower_bound_many(kUnsorted.begin(), kUnsorted.end(),
+                            bounds.begin());
+  for (std::size_t i = 0; i < kUnsorted.size(); ++i) {
+    EXPECT_EQ(testSet.lower_bound(kUnsorted[i]), bounds[i]);
+  }
+}
@@ -0,0 +1,82 @@
+#include <proposed/string>
+#include <proposed/string_interner>
+#include <proposed/unordered_set>
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Interning a stream of field names drawn from a pool of distinct ones,
+// most of them already seen. The baseline is the transparent find followed
+// by an adapting insert on proposed::unordered_set, which hashes twice.
+
+namespace {
+using SetType = proposed::unordered_set<std::string,
+                                        proposed::transparent_string_hash,
+                                        proposed::transparent_string_equal,
+                                        std::allocator<std::string>,
+                                        proposed::string_adaptor>;
+
+std::vector<std::string> makeStream(std::size_t distinct) {
+  std::vector<std::string> result;
+  char buffer[40];
+  for (std::size_t i = 0; i < 1 << 16; ++i) {
+    std::snprintf(buffer, sizeof(buffer), "a-field-name-%08zu",
+                  (i * 2654435761U) % distinct);
+    result.emplace_back(buffer);
+  }
+  return result;
+}
+
+void BM_SetFindThenInsert(benchmark::State& state) {
+  auto const stream = makeStream(state.range(0));
+  SetType set;
+  set.reserve(state.range(0));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    std::string_view text{stream[i++ % stream.size()]};
+    auto found = set.find(text);
+    if (found == set.end()) {
+      found = set.insert(text).first;
+    }
+    benchmark::DoNotOptimize(&*found);
+  }
+}
+
+void BM_Intern(benchmark::State& state) {
+  auto const stream = makeStream(state.range(0));
+  proposed::string_interner<> interner;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        interner.intern(std::string_view{stream[i++ % stream.size()]}));
+  }
+}
+
+void BM_SharedIntern(benchmark::State& state) {
+  static proposed::string_interner<>* interner;
+  if (state.thread_index() == 0) {
+    interner = new proposed::string_interner<>;
+  }
+  auto const stream = makeStream(state.range(0));
+  std::size_t i = state.thread_index() * 997;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        interner->intern(std::string_view{stream[i++ % stream.size()]}));
+  }
+  if (state.thread_index() == 0) {
+    delete interner;
+  }
+}
+
+void distinctCounts(benchmark::internal::Benchmark* b) {
+  b->Arg(1 << 8)->Arg(1 << 12)->Arg(1 << 16);
+}
+}  // namespace
+
+BENCHMARK(BM_SetFindThenInsert)->Apply(distinctCounts);
+BENCHMARK(BM_Intern)->Apply(distinctCounts);
+BENCHMARK(BM_SharedIntern)->Arg(1 << 12)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
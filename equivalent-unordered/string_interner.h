@@ -0,0 +1,308 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <proposed/string>
+#include <proposed/unordered_set>
+
+namespace proposed {
+// Interns strings: each distinct string is stored once, for the lifetime of
+// the interner, and named by a 4-byte handle. Equal handles mean equal
+// strings, so handles can stand in for the strings in comparisons, hashing
+// and maps.
+//
+// `intern` hashes its argument once; the hash picks one of `Shards`
+// independently locked shards and is carried into that shard's
+// `proposed::unordered_set`, whose adaptor copies new strings into the
+// shard's arena. `view` takes no lock: a handle's text never moves.
+template <std::size_t Shards = 16,
+          class Hash = transparent_string_hash,
+          class Allocator = std::allocator<char>>
+struct string_interner {
+  static_assert(Shards > 0 && (Shards & (Shards - 1)) == 0,
+                "Shards must be a power of two");
+
+  struct handle {
+    std::uint32_t id;
+
+    friend bool operator==(handle lhs, handle rhs) { return lhs.id == rhs.id; }
+    friend bool operator!=(handle lhs, handle rhs) { return lhs.id != rhs.id; }
+    friend bool operator<(handle lhs, handle rhs) { return lhs.id < rhs.id; }
+  };
+
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using allocator_type = Allocator;
+
+  string_interner() : string_interner(Hash{}) {}
+  explicit string_interner(Hash const& hash,
+                           Allocator const& alloc = Allocator{})
+      : hash_(hash) {
+    shards_.reserve(Shards);
+    for (std::uint32_t index = 0; index < Shards; ++index) {
+      shards_.push_back(std::make_unique<shard>(alloc, index));
+    }
+  }
+  string_interner(string_interner const&) = delete;
+  string_interner& operator=(string_interner const&) = delete;
+
+  // The handle of `text`, interning it if it is new. Thread-safe.
+  handle intern(std::string_view text) {
+    hashed_view probe{text, hash_(text)};
+    auto& owner = shard_for(probe.hash);
+    std::lock_guard<std::mutex> lock{owner.mutex};
+    auto result = owner.entries.insert(probe);
+    handle const interned{result.first->id};
+    if (result.second && owner.count > owner.bucketCount) {
+      // proposed::unordered_set leaves growing to its owner
+      owner.bucketCount *= 2;
+      owner.entries.rehash(owner.bucketCount);
+    }
+    return interned;
+  }
+
+  // The handle of `text` if it has been interned. Thread-safe.
+  std::optional<handle> find(std::string_view text) const {
+    hashed_view probe{text, hash_(text)};
+    auto& owner = shard_for(probe.hash);
+    std::lock_guard<std::mutex> lock{owner.mutex};
+    auto found = owner.entries.find(probe);
+    if (found == owner.entries.end()) {
+      return std::nullopt;
+    }
+    return handle{found->id};
+  }
+
+  // The text of a handle returned by this interner, valid as long as the
+  // interner is. Lock-free.
+  std::string_view view(handle h) const {
+    return shards_[h.id & kShardMask]->lookup(h.id >> kShardBits);
+  }
+  std::string_view operator[](handle h) const { return view(h); }
+
+  // The number of distinct strings interned. Thread-safe, but only a
+  // snapshot while other threads intern.
+  size_type size() const {
+    size_type result = 0;
+    for (auto const& shard : shards_) {
+      std::lock_guard<std::mutex> lock{shard->mutex};
+      result += shard->count;
+    }
+    return result;
+  }
+
+ private:
+  static constexpr unsigned kShardBits = [] {
+    unsigned bits = 0;
+    while ((std::size_t{1} << bits) < Shards) {
+      ++bits;
+    }
+    return bits;
+  }();
+  static constexpr std::uint32_t kShardMask = Shards - 1;
+  static constexpr std::size_t kMaxPerShard = std::size_t{1}
+                                              << (32 - kShardBits);
+  // Arena blocks; longer strings get a block to themselves
+  static constexpr std::size_t kBlockSize = 4096;
+  // The directory from local index to text is in chunks of doubling size,
+  // kFirstChunk, 2 * kFirstChunk, ..., so no entry ever moves
+  static constexpr std::size_t kFirstChunk = 64;
+  static constexpr std::size_t kChunks = 28;
+
+  struct hashed_view {
+    std::string_view text;
+    std::size_t hash;
+  };
+
+  struct entry {
+    std::string_view text;
+    std::size_t hash;
+    std::uint32_t id;
+  };
+
+  struct entry_hash {
+    using is_transparent = void;
+    std::size_t operator()(entry const& e) const noexcept { return e.hash; }
+    std::size_t operator()(hashed_view const& v) const noexcept {
+      return v.hash;
+    }
+  };
+
+  struct entry_equal {
+    using is_transparent = void;
+    bool operator()(entry const& lhs, entry const& rhs) const noexcept {
+      return lhs.id == rhs.id;
+    }
+    bool operator()(entry const& lhs, hashed_view const& rhs) const noexcept {
+      return lhs.hash == rhs.hash && lhs.text == rhs.text;
+    }
+  };
+
+  struct shard;
+
+  // Builds the entry for a string the set has not seen, copying the text
+  // into the shard's arena
+  struct entry_adaptor {
+    using target_type = entry;
+    template <typename X>
+    static bool constexpr adapts{
+        std::is_same_v<std::decay_t<X>, hashed_view>};
+
+    void adapt(target_type* pResult, hashed_view const& input) {
+      ::new (static_cast<void*>(pResult)) target_type(owner->add(input));
+    }
+
+    shard* owner = nullptr;
+  };
+
+  using char_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<char>;
+  using char_traits = std::allocator_traits<char_allocator>;
+  using entry_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<entry>;
+  using view_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<std::string_view>;
+  using view_traits = std::allocator_traits<view_allocator>;
+  using block = std::pair<char*, std::size_t>;
+  using block_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<block>;
+  using entry_set = unordered_set<entry,
+                                  entry_hash,
+                                  entry_equal,
+                                  entry_allocator,
+                                  entry_adaptor>;
+
+  struct shard {
+    shard(Allocator const& allocator, std::uint32_t index)
+        : alloc(allocator),
+          entries(kFirstChunk,
+                  entry_hash{},
+                  entry_equal{},
+                  entry_allocator{allocator},
+                  entry_adaptor{this}),
+          blocks(allocator),
+          shardIndex(index) {}
+    shard(shard const&) = delete;
+    shard& operator=(shard const&) = delete;
+
+    ~shard() {
+      char_allocator chars{alloc};
+      for (auto const& block : blocks) {
+        char_traits::deallocate(chars, block.first, block.second);
+      }
+      view_allocator views{alloc};
+      for (std::size_t chunk = 0; chunk < kChunks; ++chunk) {
+        if (auto* p = directory[chunk].load(std::memory_order_relaxed)) {
+          view_traits::deallocate(views, p, kFirstChunk << chunk);
+        }
+      }
+    }
+
+    // Chunk and offset of local index `i`: chunk k holds indices from
+    // kFirstChunk * (2^k - 1)
+    static std::pair<std::size_t, std::size_t> locate(std::size_t i) {
+      auto const scaled = i / kFirstChunk + 1;
+#if defined(__GNUC__)
+      std::size_t const chunk = 63 - __builtin_clzll(scaled);
+#else
+      std::size_t chunk = 0;
+      while (scaled >> (chunk + 1)) {
+        ++chunk;
+      }
+#endif
+      return {chunk, i - kFirstChunk * ((std::size_t{1} << chunk) - 1)};
+    }
+
+    std::string_view lookup(std::size_t i) const {
+      auto const where = locate(i);
+      return directory[where.first].load(std::memory_order_acquire)
+          [where.second];
+    }
+
+    char* copy_text(std::string_view text) {
+      char_allocator chars{alloc};
+      if (text.size() > kBlockSize / 4) {
+        auto* own = char_traits::allocate(chars, text.size());
+        blocks.emplace_back(own, text.size());
+        std::memcpy(own, text.data(), text.size());
+        return own;
+      }
+      if (static_cast<std::size_t>(limit - cursor) < text.size()) {
+        cursor = char_traits::allocate(chars, kBlockSize);
+        blocks.emplace_back(cursor, kBlockSize);
+        limit = cursor + kBlockSize;
+      }
+      auto* result = cursor;
+      if (!text.empty()) {
+        std::memcpy(result, text.data(), text.size());
+      }
+      cursor += text.size();
+      return result;
+    }
+
+    // Called with the lock held, from the set's adaptor
+    entry add(hashed_view const& input) {
+      if (count == kMaxPerShard) {
+        throw std::length_error{"string_interner shard is full"};
+      }
+      auto const where = locate(count);
+      auto* chunk = directory[where.first].load(std::memory_order_relaxed);
+      if (!chunk) {
+        view_allocator views{alloc};
+        chunk = view_traits::allocate(views, kFirstChunk << where.first);
+        directory[where.first].store(chunk, std::memory_order_release);
+      }
+      std::string_view text{copy_text(input.text), input.text.size()};
+      // Written before the handle is returned, so before anyone can ask
+      chunk[where.second] = text;
+      auto const id =
+          static_cast<std::uint32_t>(count << kShardBits) | shardIndex;
+      ++count;
+      return {text, input.hash, id};
+    }
+
+    Allocator alloc;
+    mutable std::mutex mutex;
+    entry_set entries;
+    std::vector<block, block_allocator> blocks;
+    char* cursor = nullptr;
+    char* limit = nullptr;
+    std::atomic<std::string_view*> directory[kChunks] = {};
+    std::size_t count = 0;
+    std::size_t bucketCount = kFirstChunk;
+    std::uint32_t shardIndex;
+  };
+
+  // The top bits of the hash, leaving the low ones to pick buckets
+  shard& shard_for(std::size_t hash) const {
+    if constexpr (kShardBits == 0) {
+      return *shards_[0];
+    } else {
+      return *shards_[hash >>
+                      (std::numeric_limits<std::size_t>::digits - kShardBits)];
+    }
+  }
+
+  Hash hash_;
+  std::vector<std::unique_ptr<shard>> shards_;
+};
+
+namespace pmr {
+template <std::size_t Shards = 16, class Hash = transparent_string_hash>
+using string_interner = proposed::string_interner<
+    Shards,
+    Hash,
+    std::pmr::polymorphic_allocator<char>>;
+}  // namespace pmr
+}  // namespace proposed
@@ -0,0 +1,79 @@
+#include <proposed/string_interner>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+TEST(ProposedStringInterner, Basics) {
+  proposed::string_interner<> interner;
+  auto hello = interner.intern("Hello"sv);
+  auto world = interner.intern("World"s);
+  auto empty = interner.intern(""sv);
+  EXPECT_NE(hello, world);
+  EXPECT_EQ(hello, interner.intern(std::string{"Hel"} + "lo"));
+  EXPECT_EQ(empty, interner.intern(std::string_view{}));
+  EXPECT_EQ("Hello"sv, interner.view(hello));
+  EXPECT_EQ("World"sv, interner[world]);
+  EXPECT_EQ(""sv, interner[empty]);
+  EXPECT_EQ(3U, interner.size());
+  EXPECT_EQ(world, interner.find("World"sv));
+  EXPECT_FALSE(interner.find("Adios"sv));
+  static_assert(sizeof(hello) == 4);
+}
+
+TEST(ProposedStringInterner, ViewsStayPut) {
+  proposed::string_interner<4> interner;
+  std::vector<std::string> texts;
+  for (int i = 0; i < 20000; ++i) {
+    texts.push_back("field-" + std::to_string(i));
+  }
+  // Long enough to need a block of its own
+  texts.push_back(std::string(5000, 'x'));
+  std::vector<proposed::string_interner<4>::handle> handles;
+  std::vector<std::string_view> views;
+  for (auto const& text : texts) {
+    handles.push_back(interner.intern(text));
+    views.push_back(interner.view(handles.back()));
+  }
+  EXPECT_EQ(texts.size(), interner.size());
+  for (size_t i = 0; i < texts.size(); ++i) {
+    EXPECT_EQ(handles[i], interner.intern(texts[i]));
+    EXPECT_EQ(views[i].data(), interner.view(handles[i]).data());
+    EXPECT_EQ(texts[i], views[i]);
+  }
+}
+
+TEST(ProposedStringInterner, ConcurrentIntern) {
+  constexpr int kThreads = 4;
+  constexpr int kTexts = 5000;
+  proposed::string_interner<> interner;
+  std::vector<std::string> texts;
+  for (int i = 0; i < kTexts; ++i) {
+    texts.push_back("tag=" + std::to_string(i));
+  }
+  std::vector<std::vector<proposed::string_interner<>::handle>> seen(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      // Each thread walks the texts from a different starting point
+      for (int i = 0; i < kTexts; ++i) {
+        auto const& text = texts[(i + t * kTexts / kThreads) % kTexts];
+        auto handle = interner.intern(text);
+        EXPECT_EQ(text, interner.view(handle));
+        seen[t].push_back(handle);
+      }
+      std::rotate(seen[t].begin(),
+                  seen[t].end() - t * kTexts / kThreads,
+                  seen[t].end());
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(static_cast<size_t>(kTexts), interner.size());
+  for (int t = 1; t < kThreads; ++t) {
+    EXPECT_EQ(seen[0], seen[t]);
+  }
+}
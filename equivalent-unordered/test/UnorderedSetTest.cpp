@@ -4,6 +4,8 @@
 #include <functional>
 #include <test-utils/copy.h>
 #include <iostream>
+#include <algorithm>
+#include <vector>
 
 struct myhash : std::hash<std::string_view> {
   using is_transparent = void;
@@ -15,6 +17,13 @@ using SetType = proposed::unordered_set<std::string,
                                         std::allocator<std::string>,
                                         proposed::string_adaptor>;
 
+using WyHashSetType =
+    proposed::unordered_set<std::string,
+                            proposed::transparent_string_hash,
+                            proposed::transparent_string_equal,
+                            std::allocator<std::string>,
+                            proposed::string_adaptor>;
+
 using namespace std::literals;
 using namespace test_utils;
 
@@ -88,6 +97,32 @@ TEST(ProposedUnorderedSet, TransparentLookup) {
   EXPECT_EQ(0U, testSet.erase(copy(kHello)));
 }
 
+TEST(ProposedUnorderedSet, TransparentStringHash) {
+  proposed::transparent_string_hash hash;
+  auto const kHello = "Hello"s;
+  EXPECT_EQ(hash(kHello), hash("Hello"sv));
+  EXPECT_EQ(hash(kHello), hash("Hello"));
+  EXPECT_NE(hash(kHello), hash("Hellp"sv));
+  proposed::transparent_string_equal equal;
+  EXPECT_TRUE(equal(kHello, "Hello"sv));
+  EXPECT_TRUE(equal("Hello", kHello));
+  EXPECT_FALSE(equal(kHello, "Hell"));
+
+  WyHashSetType testSet{};
+  testSet.insert({"Hello"sv, "Set"sv, "World"sv});
+  EXPECT_EQ(1U, testSet.count(kHello));
+  EXPECT_EQ(1U, testSet.count("Set"sv));
+  EXPECT_EQ(1U, testSet.count("World"));
+  EXPECT_EQ(0U, testSet.count("Hell"sv));
+  EXPECT_EQ(1U, testSet.erase("Hello"sv));
+  EXPECT_EQ(0U, testSet.erase(kHello));
+  // Long keys take the 48-byte chained path
+  std::string const kLong(200, 'x');
+  testSet.insert(std::string_view{kLong});
+  EXPECT_EQ(1U, testSet.count(kLong));
+  EXPECT_EQ(0U, testSet.count(std::string_view{kLong}.substr(1)));
+}
+
 TEST(ProposedUnorderedSet, Adaptable) {
   auto const kHello = "Hello"sv;
   auto const kSet = "Set"sv;
@@ -113,3 +148,80 @@ TEST(ProposedUnorderedSet, Adaptable) {
   EXPECT_EQ(1U, testSet.erase(copy(kHello)));
   EXPECT_EQ(0U, testSet.erase(copy(kHello)));
 }
+
+TEST(ProposedUnorderedSet, Iteration) {
+  SetType testSet{};
+  EXPECT_TRUE(testSet.begin() == testSet.end());
+  testSet.insert({"Hello"sv, "Set"sv, "World"sv});
+  std::vector<std::string> seen(testSet.begin(), testSet.end());
+  std::sort(seen.begin(), seen.end());
+  EXPECT_EQ((std::vector<std::string>{"Hello", "Set", "World"}), seen);
+}
+
+namespace {
+SetType makeSet(std::size_t bucketCount, std::initializer_list<int> keys) {
+  SetType result(bucketCount);
+  for (auto key : keys) {
+    result.insert(std::to_string(key));
+  }
+  return result;
+}
+
+std::vector<std::string> sorted(SetType const& set) {
+  std::vector<std::string> result(set.begin(), set.end());
+  std::sort(result.begin(), result.end());
+  return result;
+}
+}  // namespace
+
+TEST(ProposedUnorderedSet, SetAlgebra) {
+  // Equal bucket counts take the bucket-aligned path; unequal ones probe.
+  for (std::size_t rhsBuckets : {7U, 13U}) {
+    auto const lhs = makeSet(7, {1, 2, 3, 4, 5, 6});
+    auto const rhs = makeSet(rhsBuckets, {4, 5, 6, 7, 8});
+    EXPECT_EQ(sorted(makeSet(7, {1, 2, 3, 4, 5, 6, 7, 8})),
+              sorted(proposed::set_union(lhs, rhs)));
+    EXPECT_EQ(sorted(makeSet(7, {4, 5, 6})),
+              sorted(proposed::set_intersection(lhs, rhs)));
+    EXPECT_EQ(sorted(makeSet(7, {4, 5, 6})),
+              sorted(proposed::set_intersection(rhs, lhs)));
+    EXPECT_EQ(sorted(makeSet(7, {1, 2, 3})),
+              sorted(proposed::set_difference(lhs, rhs)));
+    EXPECT_EQ(sorted(makeSet(7, {7, 8})),
+              sorted(proposed::set_difference(rhs, lhs)));
+    EXPECT_FALSE(proposed::is_subset(lhs, rhs));
+    EXPECT_TRUE(proposed::is_subset(makeSet(rhsBuckets, {4, 6}), lhs));
+    EXPECT_TRUE(proposed::is_subset(makeSet(rhsBuckets, {}), lhs));
+    EXPECT_TRUE(lhs == makeSet(rhsBuckets, {6, 5, 4, 3, 2, 1}));
+    EXPECT_TRUE(lhs != rhs);
+  }
+}
+
+TEST(ProposedUnorderedSet, CopyPreservesLayout) {
+  auto const original = makeSet(13, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+  SetType copied{original};
+  EXPECT_EQ(13U, copied.bucket_count());
+  for (std::size_t index = 0; index < original.bucket_count(); ++index) {
+    EXPECT_EQ(original.bucket_size(index), copied.bucket_size(index));
+  }
+  EXPECT_TRUE(original == copied);
+  copied.erase("1"sv);
+  EXPECT_EQ(1U, original.count("1"sv));
+  SetType assigned{};
+  assigned = original;
+  EXPECT_EQ(13U, assigned.bucket_count());
+  EXPECT_TRUE(original == assigned);
+}
+
+TEST(ProposedUnorderedSet, CopyTriviallyCopyableKeys) {
+  proposed::unordered_set<int> original(5);
+  for (int key = 0; key < 20; ++key) {
+    original.insert(key);
+  }
+  auto copied = original;
+  EXPECT_EQ(5U, copied.bucket_count());
+  EXPECT_EQ(20U, copied.size());
+  for (int key = 0; key < 20; ++key) {
+    EXPECT_EQ(1U, copied.count(key));
+  }
+}
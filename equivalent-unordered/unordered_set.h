@@ -1,13 +1,22 @@
+#pragma once
+
+#include <memory_resource>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <functional>
+#include <limits>
 #include <proposed/adaptor>
 
-namespace std {
-float ceil(float arg);
+namespace proposed {
+namespace detail {
+struct unordered_set_algebra;
+template <typename Container, typename Enable>
+struct parallel_builder;
 }
 
-namespace proposed {
 template <class Key,
           class Hash = std::hash<Key>,
           class KeyEqual = std::equal_to<Key>,
@@ -32,20 +41,22 @@ struct unordered_set {
         : raw_(raw), outer_(outerIndex), inner_(innerIndex) {}
     reference operator*() const { return *operator->(); }
     pointer operator->() const { return (*raw_)[outer_][inner_]; }
-    bool operator==(const iterator& other) {
+    bool operator==(const iterator& other) const {
       return ((raw_ == other.raw_) && (outer_ == other.outer_) &&
               (inner_ == other.inner_));
     }
+    bool operator!=(const iterator& other) const { return !operator==(other); }
     iterator& operator++() {
       if (++inner_ < (*raw_)[outer_].size()) {
         return *this;
       }
-      if (++outer_ < raw_->size()) {
-        inner_ = 0;
-        return *this;
+      while (++outer_ < raw_->size()) {
+        if (!(*raw_)[outer_].empty()) {
+          inner_ = 0;
+          return *this;
+        }
       }
-      outer_ = std::numeric_limits<size_type>::max();
-      inner_ = std::numeric_limits<size_type>::max();
+      *this = iterator{};
       return *this;
     }
     iterator operator++(int) {
@@ -113,7 +124,19 @@ struct unordered_set {
       : hash_(hash),
         equal_(equal),
         alloc_(alloc),
-        buckets_(bucket_count, alloc) {}
+        buckets_(bucket_count) {}
+  // For adaptors with state of their own, which is copied along with the set
+  unordered_set(size_type bucket_count,
+                const Hash& hash,
+                const KeyEqual& equal,
+                const Allocator& alloc,
+                const Adaptor& adaptor)
+      : hash_(hash),
+        equal_(equal),
+        alloc_(alloc),
+        buckets_(bucket_count),
+        keyAdaptor_(adaptor),
+        valueAdaptor_(adaptor) {}
   unordered_set(size_type bucket_count, const Allocator& alloc)
       : unordered_set(bucket_count, Hash(), KeyEqual(), alloc) {}
   unordered_set(size_type bucket_count,
@@ -146,17 +169,26 @@ struct unordered_set {
                 const Allocator& alloc)
       : unordered_set(first, last, bucket_count, hash, KeyEqual(), alloc) {}
   unordered_set(const unordered_set& other)
-      : unordered_set(other.begin(), other.end()) {}
+      : unordered_set(other,
+                      std::allocator_traits<Allocator>::
+                          select_on_container_copy_construction(other.alloc_)) {
+  }
   unordered_set(const unordered_set& other, const Allocator& alloc)
-      : unordered_set(other.begin(), other.end(), size_type(32), alloc) {}
+      : hash_(other.hash_),
+        equal_(other.equal_),
+        alloc_(alloc),
+        buckets_(other.buckets_.size()),
+        max_load_factor_(other.max_load_factor_),
+        keyAdaptor_(other.keyAdaptor_),
+        valueAdaptor_(other.valueAdaptor_) {
+    copy_buckets_from(other);
+  }
   unordered_set(unordered_set&& other) = default;
   unordered_set(unordered_set&& other, const Allocator& alloc)
       : hash_(std::move(other.hash_)),
         equal_(std::move(other.equal_)),
         alloc_(alloc),
-        buckets_(std::move(buckets_)) {
-    alloc_ = alloc;
-  }
+        buckets_(std::move(other.buckets_)) {}
   unordered_set(std::initializer_list<value_type> init,
                 size_type bucket_count = size_type(32),
                 const Hash& hash = Hash(),
@@ -182,21 +214,44 @@ struct unordered_set {
   ~unordered_set() { clear(); }
 
   unordered_set& operator=(const unordered_set& other) {
+    if (this == &other) {
+      return *this;
+    }
     clear();
     hash_ = other.hash_;
     equal_ = other.equal_;
-    alloc_ = other.alloc_;
-    insert(other.begin(), other.end());
+    if constexpr (std::allocator_traits<Allocator>::
+                      propagate_on_container_copy_assignment::value) {
+      alloc_ = other.alloc_;
+    }
+    max_load_factor_ = other.max_load_factor_;
+    keyAdaptor_ = other.keyAdaptor_;
+    valueAdaptor_ = other.valueAdaptor_;
+    buckets_ = buckets_type(other.buckets_.size());
+    copy_buckets_from(other);
     return *this;
   }
   unordered_set& operator=(unordered_set&& other) noexcept(
       std::allocator_traits<Allocator>::is_always_equal::value&&
           std::is_nothrow_move_assignable<Hash>::value&&
               std::is_nothrow_move_assignable<KeyEqual>::value) {
+    if constexpr (!std::allocator_traits<Allocator>::
+                      propagate_on_container_move_assignment::value) {
+      if (!(alloc_ == other.alloc_)) {
+        // The entries can't change hands, so they are copied
+        return *this = static_cast<unordered_set const&>(other);
+      }
+    }
+    clear();
+    if constexpr (std::allocator_traits<Allocator>::
+                      propagate_on_container_move_assignment::value) {
+      alloc_ = std::move(other.alloc_);
+    }
     hash_ = std::move(other.hash_);
     equal_ = std::move(other.equal_);
-    alloc_ = std::move(other.alloc_);
     buckets_ = std::move(other.buckets_);
+    keyAdaptor_ = std::move(other.keyAdaptor_);
+    valueAdaptor_ = std::move(other.valueAdaptor_);
     return *this;
   }
 
@@ -211,13 +266,11 @@ struct unordered_set {
   iterator begin() { return cbegin(); }
   const_iterator begin() const { return cbegin(); }
   const_iterator cbegin() const {
-    auto outer = buckets_.begin();
-    do {
-      auto inner = outer->begin();
-      if (inner != outer->end()) {
-        return {buckets_, outer, inner};
+    for (size_type outer = 0; outer < buckets_.size(); ++outer) {
+      if (!buckets_[outer].empty()) {
+        return {&buckets_, outer, 0};
       }
-    } while (++outer != buckets_.end());
+    }
     return {};
   }
 
@@ -317,6 +370,46 @@ struct unordered_set {
     std::allocator_traits<allocator_type>::deallocate(alloc_, thing, 1);
   }
 
+  // Keys with no user-visible copy behaviour can be duplicated with memcpy,
+  // unless the allocator wants a say in how elements are constructed.
+  static constexpr bool copy_as_bytes =
+      std::is_trivially_copyable_v<Key> &&
+      std::is_same_v<Allocator, std::allocator<Key>>;
+
+  // Copies every key of `other`, which must have the same bucket count as
+  // this (empty) set, into the same bucket and position it occupies in
+  // `other`, so that no key is hashed or compared.
+  void copy_buckets_from(const unordered_set& other) {
+    try {
+      auto const bucketCount = other.buckets_.size();
+      for (size_type index = 0; index < bucketCount; ++index) {
+        auto const& source = other.buckets_[index];
+        auto& bucket = buckets_[index];
+        bucket.reserve(source.size());
+        for (auto entry : source) {
+          auto newEntryPtr =
+              std::allocator_traits<allocator_type>::allocate(alloc_, 1);
+          if constexpr (copy_as_bytes) {
+            std::memcpy(static_cast<void*>(newEntryPtr), entry, sizeof(Key));
+          } else {
+            try {
+              std::allocator_traits<allocator_type>::construct(
+                  alloc_, newEntryPtr, *entry);
+            } catch (...) {
+              std::allocator_traits<allocator_type>::deallocate(
+                  alloc_, newEntryPtr, 1);
+              throw;
+            }
+          }
+          bucket.push_back(newEntryPtr);
+        }
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
  public:
   std::pair<iterator, bool> insert(const value_type& value) {
     return insert_helper(value);
@@ -332,10 +425,21 @@ struct unordered_set {
   }
   template <class InputIt>
   void insert(InputIt first, InputIt last) {
-    while (first != last) {
-      insert(*first);
-      ++first;
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      // A range we can measure gets its buckets up front, growing at least
+      // geometrically so that a run of small ranges stays linear
+      size_type wanted = size() + std::distance(first, last);
+      if (wanted > bucket_count() * max_load_factor_) {
+        reserve(std::max(wanted, 2 * size()));
+      }
     }
+    detail::for_each_adapted_batch(
+        first, last, get_allocator(), [this](auto from, auto to) {
+          for (; from != to; ++from) {
+            insert(*from);
+          }
+        });
   }
   void insert(std::initializer_list<value_type> ilist) {
     for (auto const& key : ilist) {
@@ -485,6 +589,7 @@ struct unordered_set {
   void max_load_factor(float ml) { max_load_factor_ = std::max(1.0f, ml); }
 
  private:
+  // Only the key pointers are redistributed; keys never move or get copied.
   void actually_rehash(size_type count) {
     std::vector<std::vector<Key*>> oldBuckets{std::move(buckets_)};
     buckets_ = std::vector<std::vector<Key*>>(count);
@@ -500,12 +605,12 @@ struct unordered_set {
     size_type actual_count = count;
     auto current_size = size();
     if (actual_count == 0) {
-      actual_count = ceilf(1.5f * current_size / max_load_factor_);
+      actual_count = std::ceil(1.5f * current_size / max_load_factor_);
     } else {
       float resulting_load_factor = current_size;
       resulting_load_factor /= count;
       if (resulting_load_factor > max_load_factor_) {
-        actual_count = ceilf(1.5f * current_size / max_load_factor_);
+        actual_count = std::ceil(1.5f * current_size / max_load_factor_);
       }
     }
     actually_rehash(actual_count);
@@ -520,7 +625,7 @@ struct unordered_set {
   KeyEqual equal_;
   Allocator alloc_;
   buckets_type buckets_;
-  float max_load_factor_;
+  float max_load_factor_{1.0f};
 
   // Begin transparent query additions
 
@@ -635,7 +740,8 @@ struct unordered_set {
     }
     auto newEntryPtr =
         std::allocator_traits<allocator_type>::allocate(alloc_, 1);
-    keyAdaptor_.adapt(newEntryPtr, std::forward<VT>(vt));
+    detail::adapt_using_allocator(
+        keyAdaptor_, newEntryPtr, std::forward<VT>(vt), alloc_);
     bucket.emplace_back(newEntryPtr);
     return {iterator{&buckets_, bucketIndex, entryIndex}, true};
   }
@@ -653,7 +759,8 @@ struct unordered_set {
     }
     auto newEntryPtr =
         std::allocator_traits<allocator_type>::allocate(alloc_, 1);
-    keyAdaptor_.adapt(newEntryPtr, std::forward<VT>(vt));
+    detail::adapt_using_allocator(
+        keyAdaptor_, newEntryPtr, std::forward<VT>(vt), alloc_);
     if (hint.outer_ == bucketIndex) {
       bucket.insert(hint.inner_, newEntryPtr);
       return hint;
@@ -690,32 +797,305 @@ struct unordered_set {
   }
 
   // End adaptable mutation additions
+
+  friend struct detail::unordered_set_algebra;
+  friend struct detail::parallel_builder<unordered_set, void>;
 };
 
-template <class Key, class Hash, class KeyEqual, class Allocator>
-bool operator==(const unordered_set<Key, Hash, KeyEqual, Allocator>& lhs,
-                const unordered_set<Key, Hash, KeyEqual, Allocator>& rhs) {
-  if (lhs.size() != rhs.size()) {
-    return false;
+namespace detail {
+// Implementation of the set-algebra free functions below. Every result is
+// built with the left operand's hash function, equality and bucket count, so
+// a key found in bucket `i` of the left operand is appended straight into
+// bucket `i` of the result without being hashed again.
+struct unordered_set_algebra {
+  static constexpr std::size_t kProbeBatch = 16;
+
+  // When both sets use a stateless hash function and the same number of
+  // buckets, equal keys live in the same bucket index in both, so they can be
+  // compared bucket-by-bucket with no hashing at all.
+  template <typename Set>
+  static bool aligned(Set const& lhs, Set const& rhs) {
+    return std::is_empty_v<typename Set::hasher> &&
+           lhs.buckets_.size() == rhs.buckets_.size();
+  }
+
+  template <typename Set>
+  static typename Set::key_type const* bucket_find(
+      Set const& set,
+      std::size_t bucketIndex,
+      typename Set::key_type const& key) {
+    for (auto entry : set.buckets_[bucketIndex]) {
+      if (set.equal_(*entry, key)) {
+        return entry;
+      }
+    }
+    return nullptr;
+  }
+
+  template <typename Set>
+  static Set empty_like(Set const& like) {
+    return Set{like.buckets_.size(), like.hash_, like.equal_, like.alloc_};
+  }
+
+  template <typename Set>
+  static void append(Set& result,
+                     std::size_t bucketIndex,
+                     typename Set::key_type const& key) {
+    using aTraits = std::allocator_traits<typename Set::allocator_type>;
+    auto newEntryPtr = aTraits::allocate(result.alloc_, 1);
+    aTraits::construct(result.alloc_, newEntryPtr, key);
+    result.buckets_[bucketIndex].emplace_back(newEntryPtr);
+  }
+
+  // Calls `visit(fromIndex, key, inIndex, match)` for every key in `from`,
+  // where `inIndex` is the bucket the key hashes to in `in` and `match` is the
+  // equal key found there, or null, until `visit` returns false. The hashes
+  // for a batch of keys are taken and their buckets prefetched before any
+  // bucket is scanned, so that the cache misses of consecutive probes overlap
+  // instead of serialising.
+  template <typename Set, typename Visit>
+  static void probe_each(Set const& from, Set const& in, Visit&& visit) {
+    struct probe {
+      std::size_t fromIndex;
+      typename Set::key_type const* key;
+      std::size_t inIndex;
+    };
+    probe batch[kProbeBatch];
+    std::size_t batchSize{};
+    auto flush = [&] {
+      for (std::size_t i = 0; i < batchSize; ++i) {
+        auto const& p = batch[i];
+        if (!visit(p.fromIndex, *p.key, p.inIndex,
+                   bucket_find(in, p.inIndex, *p.key))) {
+          return false;
+        }
+      }
+      batchSize = 0;
+      return true;
+    };
+    auto const fromBuckets = from.buckets_.size();
+    for (std::size_t fromIndex = 0; fromIndex < fromBuckets; ++fromIndex) {
+      for (auto entry : from.buckets_[fromIndex]) {
+        auto inIndex = in.bucket(*entry);
+#if defined(__GNUC__)
+        __builtin_prefetch(in.buckets_[inIndex].data());
+#endif
+        batch[batchSize++] = {fromIndex, entry, inIndex};
+        if (batchSize == kProbeBatch && !flush()) {
+          return;
+        }
+      }
+    }
+    flush();
+  }
+
+  template <typename Set>
+  static Set set_union(Set const& lhs, Set const& rhs) {
+    auto result = empty_like(lhs);
+    auto const bucketCount = lhs.buckets_.size();
+    for (std::size_t index = 0; index < bucketCount; ++index) {
+      auto& bucket = result.buckets_[index];
+      bucket.reserve(lhs.buckets_[index].size());
+      for (auto entry : lhs.buckets_[index]) {
+        append(result, index, *entry);
+      }
+    }
+    if (aligned(lhs, rhs)) {
+      for (std::size_t index = 0; index < bucketCount; ++index) {
+        for (auto entry : rhs.buckets_[index]) {
+          if (!bucket_find(lhs, index, *entry)) {
+            append(result, index, *entry);
+          }
+        }
+      }
+      return result;
+    }
+    probe_each(rhs, lhs,
+               [&](std::size_t, auto const& key, std::size_t lhsIndex,
+                   auto const* match) {
+                 if (!match) {
+                   append(result, lhsIndex, key);
+                 }
+                 return true;
+               });
+    return result;
+  }
+
+  template <typename Set>
+  static Set set_intersection(Set const& lhs, Set const& rhs) {
+    auto result = empty_like(lhs);
+    if (aligned(lhs, rhs)) {
+      auto const& smaller = lhs.size() <= rhs.size() ? lhs : rhs;
+      auto const& larger = &smaller == &lhs ? rhs : lhs;
+      auto const bucketCount = lhs.buckets_.size();
+      for (std::size_t index = 0; index < bucketCount; ++index) {
+        for (auto entry : smaller.buckets_[index]) {
+          if (auto match = bucket_find(larger, index, *entry)) {
+            append(result, index, &smaller == &lhs ? *entry : *match);
+          }
+        }
+      }
+      return result;
+    }
+    if (lhs.size() <= rhs.size()) {
+      probe_each(lhs, rhs,
+                 [&](std::size_t lhsIndex, auto const& key, std::size_t,
+                     auto const* match) {
+                   if (match) {
+                     append(result, lhsIndex, key);
+                   }
+                   return true;
+                 });
+    } else {
+      probe_each(rhs, lhs,
+                 [&](std::size_t, auto const&, std::size_t lhsIndex,
+                     auto const* match) {
+                   if (match) {
+                     append(result, lhsIndex, *match);
+                   }
+                   return true;
+                 });
+    }
+    return result;
+  }
+
+  template <typename Set>
+  static Set set_difference(Set const& lhs, Set const& rhs) {
+    auto result = empty_like(lhs);
+    auto const bucketCount = lhs.buckets_.size();
+    if (aligned(lhs, rhs)) {
+      for (std::size_t index = 0; index < bucketCount; ++index) {
+        for (auto entry : lhs.buckets_[index]) {
+          if (!bucket_find(rhs, index, *entry)) {
+            append(result, index, *entry);
+          }
+        }
+      }
+      return result;
+    }
+    if (lhs.size() <= rhs.size()) {
+      probe_each(lhs, rhs,
+                 [&](std::size_t lhsIndex, auto const& key, std::size_t,
+                     auto const* match) {
+                   if (!match) {
+                     append(result, lhsIndex, key);
+                   }
+                   return true;
+                 });
+      return result;
+    }
+    // The right operand is the smaller: look each of its keys up in the left
+    // operand, then copy across everything that was not hit.
+    std::vector<typename Set::key_type const*> hits;
+    hits.reserve(rhs.size());
+    probe_each(rhs, lhs,
+               [&](std::size_t, auto const&, std::size_t, auto const* match) {
+                 if (match) {
+                   hits.push_back(match);
+                 }
+                 return true;
+               });
+    std::sort(hits.begin(), hits.end());
+    for (std::size_t index = 0; index < bucketCount; ++index) {
+      for (auto entry : lhs.buckets_[index]) {
+        if (!std::binary_search(hits.begin(), hits.end(), entry)) {
+          append(result, index, *entry);
+        }
+      }
+    }
+    return result;
   }
-  for (auto const& key : lhs) {
-    if (rhs.count(key) == 0) {
+
+  template <typename Set>
+  static bool is_subset(Set const& lhs, Set const& rhs) {
+    if (lhs.size() > rhs.size()) {
       return false;
     }
+    if (aligned(lhs, rhs)) {
+      auto const bucketCount = lhs.buckets_.size();
+      for (std::size_t index = 0; index < bucketCount; ++index) {
+        for (auto entry : lhs.buckets_[index]) {
+          if (!bucket_find(rhs, index, *entry)) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+    bool result = true;
+    probe_each(lhs, rhs,
+               [&](std::size_t, auto const&, std::size_t, auto const* match) {
+                 result = match != nullptr;
+                 return result;
+               });
+    return result;
   }
-  return true;
+};
+}  // namespace detail
+
+// Returns a set holding every key in either operand
+template <class Key, class Hash, class KeyEqual, class Allocator, class Adaptor>
+unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor> set_union(
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& lhs,
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& rhs) {
+  return detail::unordered_set_algebra::set_union(lhs, rhs);
 }
 
-template <class Key, class Hash, class KeyEqual, class Allocator>
-bool operator!=(const unordered_set<Key, Hash, KeyEqual, Allocator>& lhs,
-                const unordered_set<Key, Hash, KeyEqual, Allocator>& rhs) {
+// Returns a set holding every key in both operands
+template <class Key, class Hash, class KeyEqual, class Allocator, class Adaptor>
+unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor> set_intersection(
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& lhs,
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& rhs) {
+  return detail::unordered_set_algebra::set_intersection(lhs, rhs);
+}
+
+// Returns a set holding every key in `lhs` which is not in `rhs`
+template <class Key, class Hash, class KeyEqual, class Allocator, class Adaptor>
+unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor> set_difference(
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& lhs,
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& rhs) {
+  return detail::unordered_set_algebra::set_difference(lhs, rhs);
+}
+
+// Returns whether every key in `lhs` is also in `rhs`
+template <class Key, class Hash, class KeyEqual, class Allocator, class Adaptor>
+bool is_subset(
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& lhs,
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& rhs) {
+  return detail::unordered_set_algebra::is_subset(lhs, rhs);
+}
+
+template <class Key, class Hash, class KeyEqual, class Allocator, class Adaptor>
+bool operator==(
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& lhs,
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& rhs) {
+  return lhs.size() == rhs.size() && is_subset(lhs, rhs);
+}
+
+template <class Key, class Hash, class KeyEqual, class Allocator, class Adaptor>
+bool operator!=(
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& lhs,
+    const unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>& rhs) {
   return !operator==(lhs, rhs);
 }
 
-template <class Key, class Hash, class KeyEqual, class Alloc>
-void swap(unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
-          unordered_set<Key, Hash, KeyEqual, Alloc>&
+template <class Key, class Hash, class KeyEqual, class Alloc, class Adaptor>
+void swap(unordered_set<Key, Hash, KeyEqual, Alloc, Adaptor>& lhs,
+          unordered_set<Key, Hash, KeyEqual, Alloc, Adaptor>&
               rhs) noexcept(noexcept(lhs.swap(rhs))) {
   lhs.swap(rhs);
 }
+
+namespace pmr {
+template <class Key,
+          class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Adaptor = no_adaptor>
+using unordered_set = proposed::unordered_set<
+    Key,
+    Hash,
+    KeyEqual,
+    std::pmr::polymorphic_allocator<Key>,
+    Adaptor>;
+}  // namespace pmr
 }
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <proposed/adaptor>
+
+namespace proposed {
+// Tags for constructing a flat container from input the caller promises is
+// already sorted (and, for `sorted_unique`, free of equivalent keys).
+struct sorted_unique_t {
+  explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+struct sorted_equivalent_t {
+  explicit sorted_equivalent_t() = default;
+};
+inline constexpr sorted_equivalent_t sorted_equivalent{};
+
+namespace detail {
+template <bool Unique>
+using sorted_t =
+    std::conditional_t<Unique, sorted_unique_t, sorted_equivalent_t>;
+}  // namespace detail
+}  // namespace proposed
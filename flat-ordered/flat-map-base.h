@@ -0,0 +1,529 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <vector>
+#include <proposed/iterator>
+#include "flat-common.h"
+
+namespace proposed {
+namespace detail {
+// Sorted-vector storage and lookup shared by `flat_map` and `flat_multimap`.
+// Keys and mapped values live in two parallel arrays, so that searching only
+// touches keys. When `Unique` no two keys are equivalent.
+template <class Key, class T, class Compare, class Allocator, bool Unique>
+struct flat_map_base {
+ private:
+  using aTraits = std::allocator_traits<Allocator>;
+
+ public:
+  using key_container_type =
+      std::vector<Key, typename aTraits::template rebind_alloc<Key>>;
+  using mapped_container_type =
+      std::vector<T, typename aTraits::template rebind_alloc<T>>;
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference =
+      std::pair<Key const&, typename mapped_container_type::reference>;
+  using const_reference =
+      std::pair<Key const&, typename mapped_container_type::const_reference>;
+
+  struct value_compare {
+    bool operator()(const_reference lhs, const_reference rhs) const {
+      return compare_(lhs.first, rhs.first);
+    }
+
+   private:
+    friend struct flat_map_base;
+    explicit value_compare(Compare compare) : compare_(compare) {}
+    Compare compare_;
+  };
+
+  template <bool Const>
+  struct iterator_impl {
+   private:
+    using key_iterator = typename key_container_type::const_iterator;
+    using mapped_iterator =
+        std::conditional_t<Const,
+                           typename mapped_container_type::const_iterator,
+                           typename mapped_container_type::iterator>;
+
+   public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::pair<Key, T>;
+    using reference = std::conditional_t<Const,
+                                         flat_map_base::const_reference,
+                                         flat_map_base::reference>;
+    using pointer = arrow_proxy<reference>;
+    using iterator_category = std::random_access_iterator_tag;
+
+    iterator_impl() = default;
+    template <bool OtherConst,
+              typename = std::enable_if_t<Const && !OtherConst>>
+    iterator_impl(iterator_impl<OtherConst> other)
+        : key_(other.key_), mapped_(other.mapped_) {}
+
+    reference operator*() const { return {*key_, *mapped_}; }
+    pointer operator->() const { return {**this}; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    iterator_impl& operator++() {
+      ++key_;
+      ++mapped_;
+      return *this;
+    }
+    iterator_impl operator++(int) {
+      iterator_impl result{*this};
+      operator++();
+      return result;
+    }
+    iterator_impl& operator--() {
+      --key_;
+      --mapped_;
+      return *this;
+    }
+    iterator_impl operator--(int) {
+      iterator_impl result{*this};
+      operator--();
+      return result;
+    }
+    iterator_impl& operator+=(difference_type n) {
+      key_ += n;
+      mapped_ += n;
+      return *this;
+    }
+    iterator_impl& operator-=(difference_type n) {
+      key_ -= n;
+      mapped_ -= n;
+      return *this;
+    }
+    friend iterator_impl operator+(iterator_impl it, difference_type n) {
+      return it += n;
+    }
+    friend iterator_impl operator+(difference_type n, iterator_impl it) {
+      return it += n;
+    }
+    friend iterator_impl operator-(iterator_impl it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(iterator_impl const& lhs,
+                                     iterator_impl const& rhs) {
+      return lhs.key_ - rhs.key_;
+    }
+    friend bool operator==(iterator_impl const& lhs, iterator_impl const& rhs) {
+      return lhs.key_ == rhs.key_;
+    }
+    friend bool operator!=(iterator_impl const& lhs, iterator_impl const& rhs) {
+      return lhs.key_ != rhs.key_;
+    }
+    friend bool operator<(iterator_impl const& lhs, iterator_impl const& rhs) {
+      return lhs.key_ < rhs.key_;
+    }
+    friend bool operator>(iterator_impl const& lhs, iterator_impl const& rhs) {
+      return lhs.key_ > rhs.key_;
+    }
+    friend bool operator<=(iterator_impl const& lhs, iterator_impl const& rhs) {
+      return lhs.key_ <= rhs.key_;
+    }
+    friend bool operator>=(iterator_impl const& lhs, iterator_impl const& rhs) {
+      return lhs.key_ >= rhs.key_;
+    }
+
+   private:
+    iterator_impl(key_iterator key, mapped_iterator mapped)
+        : key_(key), mapped_(mapped) {}
+    key_iterator key_;
+    mapped_iterator mapped_;
+    friend struct flat_map_base;
+    friend struct iterator_impl<!Const>;
+  };
+
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  struct containers {
+    key_container_type keys;
+    mapped_container_type values;
+  };
+
+  flat_map_base() = default;
+  explicit flat_map_base(Compare const& compare,
+                         Allocator const& alloc = Allocator())
+      : keys_(alloc), values_(alloc), compare_(compare) {}
+  explicit flat_map_base(Allocator const& alloc)
+      : keys_(alloc), values_(alloc) {}
+  template <class InputIt>
+  flat_map_base(InputIt first,
+                InputIt last,
+                Compare const& compare = Compare(),
+                Allocator const& alloc = Allocator())
+      : flat_map_base(compare, alloc) {
+    append(first, last);
+    sort_from(0);
+  }
+  template <class InputIt>
+  flat_map_base(sorted_t<Unique>,
+                InputIt first,
+                InputIt last,
+                Compare const& compare = Compare(),
+                Allocator const& alloc = Allocator())
+      : flat_map_base(compare, alloc) {
+    append(first, last);
+  }
+  flat_map_base(std::initializer_list<value_type> init,
+                Compare const& compare = Compare(),
+                Allocator const& alloc = Allocator())
+      : flat_map_base(init.begin(), init.end(), compare, alloc) {}
+  flat_map_base(key_container_type keys,
+                mapped_container_type values,
+                Compare const& compare = Compare())
+      : keys_(std::move(keys)), values_(std::move(values)), compare_(compare) {
+    sort_from(0);
+  }
+  flat_map_base(sorted_t<Unique>,
+                key_container_type keys,
+                mapped_container_type values,
+                Compare const& compare = Compare())
+      : keys_(std::move(keys)),
+        values_(std::move(values)),
+        compare_(compare) {}
+
+  allocator_type get_allocator() const { return keys_.get_allocator(); }
+
+  iterator begin() noexcept { return make_iterator(0); }
+  const_iterator begin() const noexcept { return make_iterator(0); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  iterator end() noexcept { return make_iterator(size()); }
+  const_iterator end() const noexcept { return make_iterator(size()); }
+  const_iterator cend() const noexcept { return end(); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator{end()};
+  }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  reverse_iterator rend() noexcept { return reverse_iterator{begin()}; }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator{begin()};
+  }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept {
+    return std::min<size_type>(keys_.max_size(), values_.max_size());
+  }
+  void reserve(size_type count) {
+    keys_.reserve(count);
+    values_.reserve(count);
+  }
+  void shrink_to_fit() {
+    keys_.shrink_to_fit();
+    values_.shrink_to_fit();
+  }
+
+  void clear() noexcept {
+    keys_.clear();
+    values_.clear();
+  }
+
+  iterator erase(iterator pos) { return erase(const_iterator{pos}); }
+  iterator erase(const_iterator pos) {
+    auto index = index_of(pos);
+    keys_.erase(keys_.begin() + index);
+    values_.erase(values_.begin() + index);
+    return make_iterator(index);
+  }
+  iterator erase(const_iterator first, const_iterator last) {
+    auto index = index_of(first);
+    auto lastIndex = index_of(last);
+    keys_.erase(keys_.begin() + index, keys_.begin() + lastIndex);
+    values_.erase(values_.begin() + index, values_.begin() + lastIndex);
+    return make_iterator(index);
+  }
+  size_type erase(key_type const& key) { return erase_range(key); }
+
+  void swap(flat_map_base& other) noexcept {
+    using std::swap;
+    swap(keys_, other.keys_);
+    swap(values_, other.values_);
+    swap(compare_, other.compare_);
+  }
+
+  // Moves the underlying arrays out, leaving this container empty
+  containers extract() && {
+    containers result{std::move(keys_), std::move(values_)};
+    clear();
+    return result;
+  }
+  // Adopts `keys` and `values`, which must be the same length with `keys`
+  // already sorted (and unique, for flat_map)
+  void replace(key_container_type&& keys, mapped_container_type&& values) {
+    keys_ = std::move(keys);
+    values_ = std::move(values);
+  }
+
+  key_container_type const& keys() const noexcept { return keys_; }
+  mapped_container_type const& values() const noexcept { return values_; }
+
+  size_type count(key_type const& key) const {
+    auto range = equal_range_index(key);
+    return range.second - range.first;
+  }
+  iterator find(key_type const& key) { return make_iterator(find_index(key)); }
+  const_iterator find(key_type const& key) const {
+    return make_iterator(find_index(key));
+  }
+  std::pair<iterator, iterator> equal_range(key_type const& key) {
+    auto range = equal_range_index(key);
+    return {make_iterator(range.first), make_iterator(range.second)};
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      key_type const& key) const {
+    auto range = equal_range_index(key);
+    return {make_iterator(range.first), make_iterator(range.second)};
+  }
+  iterator lower_bound(key_type const& key) {
+    return make_iterator(lower_bound_index(key));
+  }
+  const_iterator lower_bound(key_type const& key) const {
+    return make_iterator(lower_bound_index(key));
+  }
+  iterator upper_bound(key_type const& key) {
+    return make_iterator(upper_bound_index(key));
+  }
+  const_iterator upper_bound(key_type const& key) const {
+    return make_iterator(upper_bound_index(key));
+  }
+
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, size_type>::type count(
+      K const& key) const {
+    auto range = equal_range_index(key);
+    return range.second - range.first;
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, iterator>::type find(
+      K const& key) {
+    return make_iterator(find_index(key));
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, const_iterator>::type
+  find(K const& key) const {
+    return make_iterator(find_index(key));
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value,
+                          std::pair<iterator, iterator>>::type
+  equal_range(K const& key) {
+    auto range = equal_range_index(key);
+    return {make_iterator(range.first), make_iterator(range.second)};
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value,
+                          std::pair<const_iterator, const_iterator>>::type
+  equal_range(K const& key) const {
+    auto range = equal_range_index(key);
+    return {make_iterator(range.first), make_iterator(range.second)};
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, iterator>::type
+  lower_bound(K const& key) {
+    return make_iterator(lower_bound_index(key));
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, const_iterator>::type
+  lower_bound(K const& key) const {
+    return make_iterator(lower_bound_index(key));
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, iterator>::type
+  upper_bound(K const& key) {
+    return make_iterator(upper_bound_index(key));
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, const_iterator>::type
+  upper_bound(K const& key) const {
+    return make_iterator(upper_bound_index(key));
+  }
+
+  key_compare key_comp() const { return compare_; }
+  value_compare value_comp() const { return value_compare{compare_}; }
+
+  friend bool operator==(flat_map_base const& lhs, flat_map_base const& rhs) {
+    return lhs.keys_ == rhs.keys_ && lhs.values_ == rhs.values_;
+  }
+  friend bool operator!=(flat_map_base const& lhs, flat_map_base const& rhs) {
+    return !(lhs == rhs);
+  }
+
+ protected:
+  iterator make_iterator(size_type index) {
+    return {keys_.cbegin() + index, values_.begin() + index};
+  }
+  const_iterator make_iterator(size_type index) const {
+    return {keys_.cbegin() + index, values_.cbegin() + index};
+  }
+  size_type index_of(const_iterator pos) const {
+    return static_cast<size_type>(pos.key_ - keys_.cbegin());
+  }
+
+  template <typename K>
+  size_type lower_bound_index(K const& key) const {
+    return static_cast<size_type>(
+        std::lower_bound(keys_.begin(), keys_.end(), key, compare_) -
+        keys_.begin());
+  }
+  template <typename K>
+  size_type upper_bound_index(K const& key) const {
+    return static_cast<size_type>(
+        std::upper_bound(keys_.begin(), keys_.end(), key, compare_) -
+        keys_.begin());
+  }
+  template <typename K>
+  size_type find_index(K const& key) const {
+    auto index = lower_bound_index(key);
+    if (index == size() || compare_(key, keys_[index])) {
+      return size();
+    }
+    return index;
+  }
+  template <typename K>
+  std::pair<size_type, size_type> equal_range_index(K const& key) const {
+    auto index = lower_bound_index(key);
+    if constexpr (Unique) {
+      if (index == size() || compare_(key, keys_[index])) {
+        return {index, index};
+      }
+      return {index, index + 1};
+    } else {
+      return {index, upper_bound_index(key)};
+    }
+  }
+
+  template <typename K>
+  size_type erase_range(K const& key) {
+    auto range = equal_range_index(key);
+    keys_.erase(keys_.begin() + range.first, keys_.begin() + range.second);
+    values_.erase(values_.begin() + range.first,
+                  values_.begin() + range.second);
+    return range.second - range.first;
+  }
+
+  // The bool is false if an equivalent key is already present
+  template <typename K>
+  std::pair<size_type, bool> findHint(K const& key) const {
+    auto index = lower_bound_index(key);
+    return {index, index == size() || compare_(key, keys_[index])};
+  }
+
+  // The bool is false if an equivalent key is already present
+  template <typename K>
+  std::pair<size_type, bool> findHint(const_iterator hint, K const& key) const {
+    auto index = index_of(hint);
+    if ((index != size() && compare_(keys_[index], key)) ||
+        (index != 0 && !compare_(keys_[index - 1], key))) {
+      // Bad initial hint
+      index = lower_bound_index(key);
+    }
+    return {index, index == size() || compare_(key, keys_[index])};
+  }
+
+  // Where a key equivalent to `key` goes in a multimap: as close before `hint`
+  // as ordering allows.
+  template <typename K>
+  size_type findMultiHint(const_iterator hint, K const& key) const {
+    auto index = index_of(hint);
+    if (index != 0 && compare_(key, keys_[index - 1])) {
+      return static_cast<size_type>(
+          std::upper_bound(keys_.begin(), keys_.begin() + index - 1, key,
+                           compare_) -
+          keys_.begin());
+    }
+    if (index != size() && compare_(keys_[index], key)) {
+      return static_cast<size_type>(
+          std::lower_bound(keys_.begin() + index + 1, keys_.end(), key,
+                           compare_) -
+          keys_.begin());
+    }
+    return index;
+  }
+
+  // Inserts a key built from `key` and a mapped value built from `args` at
+  // `index`, keeping the two arrays in step if either construction throws.
+  template <typename K, typename... Args>
+  iterator emplace_at(size_type index, K&& key, Args&&... args) {
+    keys_.emplace(keys_.begin() + index, std::forward<K>(key));
+    try {
+      values_.emplace(values_.begin() + index, std::forward<Args>(args)...);
+    } catch (...) {
+      keys_.erase(keys_.begin() + index);
+      throw;
+    }
+    return make_iterator(index);
+  }
+
+  template <class InputIt>
+  void append(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      emplace_at(size(), (*first).first, (*first).second);
+    }
+  }
+
+  // Sorts the elements from index `start` onwards and merges them into the
+  // already-sorted elements before `start`. Among equivalent keys, earlier
+  // ones stay first and, when `Unique`, are the ones kept.
+  void sort_from(size_type start) {
+    auto const count = size();
+    auto inOrder = [this](size_type lhs, size_type rhs) {
+      return Unique ? compare_(keys_[lhs], keys_[rhs])
+                    : !compare_(keys_[rhs], keys_[lhs]);
+    };
+    // Appending keys that are already in order is common enough to check for
+    bool sorted = true;
+    for (auto index = std::max<size_type>(start, 1); sorted && index < count;
+         ++index) {
+      sorted = inOrder(index - 1, index);
+    }
+    if (sorted) {
+      return;
+    }
+    std::vector<size_type> order(count);
+    std::iota(order.begin(), order.end(), size_type{0});
+    auto byKey = [this](size_type lhs, size_type rhs) {
+      return compare_(keys_[lhs], keys_[rhs]);
+    };
+    std::stable_sort(order.begin() + start, order.end(), byKey);
+    std::inplace_merge(order.begin(), order.begin() + start, order.end(),
+                       byKey);
+    key_container_type keys(keys_.get_allocator());
+    mapped_container_type values(values_.get_allocator());
+    keys.reserve(count);
+    values.reserve(count);
+    for (auto index : order) {
+      if (Unique && !keys.empty() && !compare_(keys.back(), keys_[index])) {
+        continue;
+      }
+      keys.push_back(std::move(keys_[index]));
+      values.push_back(std::move(values_[index]));
+    }
+    keys_ = std::move(keys);
+    values_ = std::move(values);
+  }
+
+  key_container_type keys_;
+  mapped_container_type values_;
+  Compare compare_;
+};
+}  // namespace detail
+}  // namespace proposed
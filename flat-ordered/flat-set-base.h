@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <vector>
+#include "flat-common.h"
+
+namespace proposed {
+namespace detail {
+// Sorted-vector storage and lookup shared by `flat_set` and `flat_multiset`.
+// Elements are kept in `Compare` order in one contiguous array; when `Unique`
+// no two elements are equivalent.
+template <class Key, class Compare, class Allocator, bool Unique>
+struct flat_set_base {
+  using container_type = std::vector<Key, Allocator>;
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
+  using size_type = typename container_type::size_type;
+  using difference_type = typename container_type::difference_type;
+  using reference = value_type&;
+  using const_reference = value_type const&;
+  using pointer = typename std::allocator_traits<Allocator>::pointer;
+  using const_pointer =
+      typename std::allocator_traits<Allocator>::const_pointer;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+
+  flat_set_base() = default;
+  explicit flat_set_base(Compare const& compare,
+                         Allocator const& alloc = Allocator())
+      : keys_(alloc), compare_(compare) {}
+  explicit flat_set_base(Allocator const& alloc) : keys_(alloc) {}
+  template <class InputIt>
+  flat_set_base(InputIt first,
+                InputIt last,
+                Compare const& compare = Compare(),
+                Allocator const& alloc = Allocator())
+      : keys_(first, last, alloc), compare_(compare) {
+    sort_from(0);
+  }
+  template <class InputIt>
+  flat_set_base(sorted_t<Unique>,
+                InputIt first,
+                InputIt last,
+                Compare const& compare = Compare(),
+                Allocator const& alloc = Allocator())
+      : keys_(first, last, alloc), compare_(compare) {}
+  flat_set_base(std::initializer_list<value_type> init,
+                Compare const& compare = Compare(),
+                Allocator const& alloc = Allocator())
+      : flat_set_base(init.begin(), init.end(), compare, alloc) {}
+  explicit flat_set_base(container_type keys,
+                         Compare const& compare = Compare())
+      : keys_(std::move(keys)), compare_(compare) {
+    sort_from(0);
+  }
+  flat_set_base(sorted_t<Unique>,
+                container_type keys,
+                Compare const& compare = Compare())
+      : keys_(std::move(keys)), compare_(compare) {}
+
+  allocator_type get_allocator() const { return keys_.get_allocator(); }
+
+  iterator begin() const noexcept { return keys_.begin(); }
+  iterator end() const noexcept { return keys_.end(); }
+  const_iterator cbegin() const noexcept { return keys_.cbegin(); }
+  const_iterator cend() const noexcept { return keys_.cend(); }
+  reverse_iterator rbegin() const noexcept { return reverse_iterator{end()}; }
+  reverse_iterator rend() const noexcept { return reverse_iterator{begin()}; }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept { return keys_.max_size(); }
+  size_type capacity() const noexcept { return keys_.capacity(); }
+  void reserve(size_type count) { keys_.reserve(count); }
+  void shrink_to_fit() { keys_.shrink_to_fit(); }
+
+  void clear() noexcept { keys_.clear(); }
+
+  iterator erase(const_iterator pos) { return keys_.erase(pos); }
+  iterator erase(const_iterator first, const_iterator last) {
+    return keys_.erase(first, last);
+  }
+  size_type erase(key_type const& key) { return erase_range(key); }
+
+  void swap(flat_set_base& other) noexcept {
+    using std::swap;
+    swap(keys_, other.keys_);
+    swap(compare_, other.compare_);
+  }
+
+  // Moves the underlying sorted array out, leaving this container empty
+  container_type extract() && {
+    container_type result{std::move(keys_)};
+    keys_.clear();
+    return result;
+  }
+  // Adopts `keys`, which must already be sorted (and unique, for flat_set)
+  void replace(container_type&& keys) { keys_ = std::move(keys); }
+
+  size_type count(key_type const& key) const {
+    auto range = equal_range(key);
+    return static_cast<size_type>(range.second - range.first);
+  }
+  iterator find(key_type const& key) const { return find_impl(key); }
+  std::pair<iterator, iterator> equal_range(key_type const& key) const {
+    return equal_range_impl(key);
+  }
+  iterator lower_bound(key_type const& key) const {
+    return std::lower_bound(keys_.begin(), keys_.end(), key, compare_);
+  }
+  iterator upper_bound(key_type const& key) const {
+    return std::upper_bound(keys_.begin(), keys_.end(), key, compare_);
+  }
+
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, size_type>::type count(
+      K const& key) const {
+    auto range = equal_range(key);
+    return static_cast<size_type>(range.second - range.first);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, iterator>::type find(
+      K const& key) const {
+    return find_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value,
+                          std::pair<iterator, iterator>>::type
+  equal_range(K const& key) const {
+    return equal_range_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, iterator>::type
+  lower_bound(K const& key) const {
+    return std::lower_bound(keys_.begin(), keys_.end(), key, compare_);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<is_transparent<C>::value, iterator>::type
+  upper_bound(K const& key) const {
+    return std::upper_bound(keys_.begin(), keys_.end(), key, compare_);
+  }
+
+  key_compare key_comp() const { return compare_; }
+  value_compare value_comp() const { return compare_; }
+
+  friend bool operator==(flat_set_base const& lhs, flat_set_base const& rhs) {
+    return lhs.keys_ == rhs.keys_;
+  }
+  friend bool operator!=(flat_set_base const& lhs, flat_set_base const& rhs) {
+    return !(lhs == rhs);
+  }
+
+ protected:
+  template <typename K>
+  iterator find_impl(K const& key) const {
+    auto found = lower_bound(key);
+    if (found == end() || compare_(key, *found)) {
+      return end();
+    }
+    return found;
+  }
+
+  template <typename K>
+  std::pair<iterator, iterator> equal_range_impl(K const& key) const {
+    if constexpr (Unique) {
+      auto found = lower_bound(key);
+      if (found == end() || compare_(key, *found)) {
+        return {found, found};
+      }
+      return {found, found + 1};
+    } else {
+      return std::equal_range(keys_.begin(), keys_.end(), key, compare_);
+    }
+  }
+
+  template <typename K>
+  size_type erase_range(K const& key) {
+    auto range = equal_range(key);
+    auto result = static_cast<size_type>(range.second - range.first);
+    keys_.erase(range.first, range.second);
+    return result;
+  }
+
+  // The bool is false if an equivalent element is already present
+  template <typename K>
+  std::pair<iterator, bool> findHint(K const& value) const {
+    auto hint = lower_bound(value);
+    return {hint, hint == end() || compare_(value, *hint)};
+  }
+
+  // The bool is false if an equivalent element is already present
+  template <typename K>
+  std::pair<iterator, bool> findHint(const_iterator hint,
+                                     K const& value) const {
+    if ((hint != end() && compare_(*hint, value)) ||
+        (hint != begin() && !compare_(*(hint - 1), value))) {
+      // Bad initial hint
+      hint = lower_bound(value);
+    }
+    return {hint, hint == end() || compare_(value, *hint)};
+  }
+
+  // Where an element equivalent to `value` goes in a multiset: as close
+  // before `hint` as ordering allows.
+  template <typename K>
+  iterator findMultiHint(const_iterator hint, K const& value) const {
+    if (hint != begin() && compare_(value, *(hint - 1))) {
+      return std::upper_bound(begin(), hint - 1, value, compare_);
+    }
+    if (hint != end() && compare_(*hint, value)) {
+      return std::lower_bound(hint + 1, end(), value, compare_);
+    }
+    return hint;
+  }
+
+  // Sorts the elements from index `start` onwards and merges them into the
+  // already-sorted elements before `start`. Among equivalent elements, earlier
+  // ones stay first and, when `Unique`, are the ones kept.
+  void sort_from(size_type start) {
+    auto middle = keys_.begin() + start;
+    // Appending keys that are already in order is common enough to check for
+    auto outOfOrder = [this](Key const& lhs, Key const& rhs) {
+      return Unique ? !compare_(lhs, rhs) : compare_(rhs, lhs);
+    };
+    if (std::adjacent_find(start == 0 ? middle : middle - 1, keys_.end(),
+                           outOfOrder) == keys_.end()) {
+      return;
+    }
+    std::stable_sort(middle, keys_.end(), compare_);
+    std::inplace_merge(keys_.begin(), middle, keys_.end(), compare_);
+    if constexpr (Unique) {
+      keys_.erase(std::unique(keys_.begin(), keys_.end(),
+                              [this](Key const& lhs, Key const& rhs) {
+                                return !compare_(lhs, rhs);
+                              }),
+                  keys_.end());
+    }
+  }
+
+  container_type keys_;
+  Compare compare_;
+};
+}  // namespace detail
+}  // namespace proposed
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <memory_resource>
+#include "flat-set-base.h"
+
+namespace proposed {
+template <class Key,
+          class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>,
+          class Adaptor = no_adaptor>
+struct flat_multiset : detail::flat_set_base<Key, Compare, Allocator, false> {
+ private:
+  using base_type = detail::flat_set_base<Key, Compare, Allocator, false>;
+  using key_adaptor = Adaptor;
+  using value_adaptor = Adaptor;
+
+ public:
+  using typename base_type::const_iterator;
+  using typename base_type::iterator;
+  using typename base_type::key_type;
+  using typename base_type::size_type;
+  using typename base_type::value_type;
+
+  using base_type::flat_set_base;
+  using base_type::erase;
+
+  iterator insert(value_type const& value) {
+    return this->keys_.insert(this->upper_bound(value), value);
+  }
+  iterator insert(value_type&& value) {
+    auto found = this->upper_bound(value);
+    return this->keys_.insert(found, std::move(value));
+  }
+  iterator insert(const_iterator hint, value_type const& value) {
+    return this->keys_.insert(this->findMultiHint(hint, value), value);
+  }
+  iterator insert(const_iterator hint, value_type&& value) {
+    auto found = this->findMultiHint(hint, value);
+    return this->keys_.insert(found, std::move(value));
+  }
+  // Appends the whole range, then sorts and merges it in: O(n + m log m)
+  // rather than the O(n * m) of inserting one element at a time.
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    auto start = this->keys_.size();
+    detail::for_each_adapted_batch(
+        first, last, this->get_allocator(), [this](auto from, auto to) {
+          this->keys_.insert(this->keys_.end(), from, to);
+        });
+    this->sort_from(start);
+  }
+  void insert(std::initializer_list<value_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  template <class... Args>
+  iterator emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return insert(hint, value_type(std::forward<Args>(args)...));
+  }
+
+ private:
+  key_adaptor keyAdaptor_;
+  static_assert(!adaptor_traits<key_adaptor>::is_adaptor ||
+                std::is_same_v<key_type, typename key_adaptor::target_type>);
+
+  template <typename AdaptableType>
+  static bool constexpr is_write_adaptable() {
+    return detail::is_write_adaptable_v<Key, iterator, const_iterator,
+                                        key_adaptor, AdaptableType>;
+  }
+
+ public:
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(), iterator>::type
+  insert(AdaptableType&& value) {
+    auto found = this->upper_bound(value);
+    return this->keys_.insert(
+        found, detail::adapt_to<key_type>(keyAdaptor_,
+                                          std::forward<AdaptableType>(value),
+                                          this->get_allocator()));
+  }
+
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType>(), iterator>::type
+  insert(const_iterator hint, AdaptableType&& value) {
+    auto found = this->findMultiHint(hint, value);
+    return this->keys_.insert(
+        found, detail::adapt_to<key_type>(keyAdaptor_,
+                                          std::forward<AdaptableType>(value),
+                                          this->get_allocator()));
+  }
+
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType const&>()>::type
+  insert(std::initializer_list<AdaptableType> ilist) {
+    for (const auto& elem : ilist) {
+      insert(elem);
+    }
+  }
+
+  template <typename AdaptableType>
+  typename std::enable_if<is_write_adaptable<AdaptableType const&>(),
+                          size_type>::type
+  erase(const AdaptableType& key) {
+    return this->erase_range(key);
+  }
+
+  // Can't do emplace or emplace_hint - Ambiguity
+};
+
+namespace pmr {
+template <class Key, class Compare = std::less<Key>, class Adaptor = no_adaptor>
+using flat_multiset = proposed::flat_multiset<
+    Key,
+    Compare,
+    std::pmr::polymorphic_allocator<Key>,
+    Adaptor>;
+}  // namespace pmr
+}  // namespace proposed
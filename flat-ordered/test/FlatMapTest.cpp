@@ -0,0 +1,183 @@
+#include <proposed/flat_map>
+#include <proposed/string>
+#include <gtest/gtest.h>
+#include <functional>
+#include <vector>
+#include <test-utils/copy.h>
+
+using MapType =
+    proposed::flat_map<std::string,
+                       int,
+                       std::less<>,
+                       std::allocator<std::pair<const std::string, int>>,
+                       proposed::string_adaptor>;
+
+using namespace std::literals;
+using namespace test_utils;
+
+TEST(ProposedFlatMap, ExactKeyType) {
+  auto const kHello = "Hello"s;
+  auto const kGoodbye = "Goodbye"s;
+  auto const kAdios = "Adios"s;
+  MapType testMap{};
+  testMap[kHello] = 1;
+  EXPECT_EQ(1, testMap.at(kHello));
+  auto x = testMap.insert_or_assign(kHello, 2);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(kHello));
+  x = testMap.try_emplace(kHello, 3);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(kHello));
+  x = testMap.insert_or_assign(kGoodbye, 4);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(4, x.first->second);
+  EXPECT_EQ(4, testMap.at(kGoodbye));
+  x = testMap.try_emplace(kAdios, 3);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(3, x.first->second);
+  EXPECT_EQ(3, testMap.at(kAdios));
+  EXPECT_EQ(1U, testMap.erase(kAdios));
+  EXPECT_EQ(0U, testMap.erase(kAdios));
+  testMap.clear();
+  // And again, with rvalues
+  testMap[copy(kHello)] = 1;
+  EXPECT_EQ(1, testMap.at(copy(kHello)));
+  x = testMap.insert_or_assign(copy(kHello), 2);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(copy(kHello)));
+  x = testMap.try_emplace(copy(kHello), 3);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(copy(kHello)));
+  x = testMap.insert_or_assign(copy(kGoodbye), 4);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(4, x.first->second);
+  EXPECT_EQ(4, testMap.at(copy(kGoodbye)));
+  x = testMap.try_emplace(copy(kAdios), 3);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(3, x.first->second);
+  EXPECT_EQ(3, testMap.at(copy(kAdios)));
+  EXPECT_EQ(1U, testMap.erase(copy(kAdios)));
+  EXPECT_EQ(0U, testMap.erase(copy(kAdios)));
+}
+
+TEST(ProposedFlatMap, ImplicitlyConstructible) {
+  MapType testMap{};
+  testMap["Hello"] = 1;
+  EXPECT_EQ(1, testMap.at("Hello"));
+  auto x = testMap.insert_or_assign("Hello", 2);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at("Hello"));
+  x = testMap.try_emplace("Hello", 3);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at("Hello"));
+  x = testMap.insert_or_assign("Goodbye", 4);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(4, x.first->second);
+  EXPECT_EQ(4, testMap.at("Goodbye"));
+  x = testMap.try_emplace("Adios", 3);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(3, x.first->second);
+  EXPECT_EQ(3, testMap.at("Adios"));
+  EXPECT_EQ(1U, testMap.erase("Adios"));
+  EXPECT_EQ(0U, testMap.erase("Adios"));
+}
+
+TEST(ProposedFlatMap, Adaptable) {
+  auto const kHello = "Hello"sv;
+  auto const kGoodbye = "Goodbye"sv;
+  auto const kAdios = "Adios"sv;
+  MapType testMap{};
+  testMap[kHello] = 1;
+  EXPECT_EQ(1, testMap.at(kHello));
+  auto x = testMap.insert_or_assign(kHello, 2);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(kHello));
+  x = testMap.try_emplace(kHello, 3);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(kHello));
+  x = testMap.insert_or_assign(kGoodbye, 4);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(4, x.first->second);
+  EXPECT_EQ(4, testMap.at(kGoodbye));
+  x = testMap.try_emplace(kAdios, 3);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(3, x.first->second);
+  EXPECT_EQ(3, testMap.at(kAdios));
+  EXPECT_EQ(1U, testMap.erase(kAdios));
+  EXPECT_EQ(0U, testMap.erase(kAdios));
+  testMap.clear();
+  // And again, with rvalues
+  testMap[copy(kHello)] = 1;
+  EXPECT_EQ(1, testMap.at(copy(kHello)));
+  x = testMap.insert_or_assign(copy(kHello), 2);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(copy(kHello)));
+  x = testMap.try_emplace(copy(kHello), 3);
+  EXPECT_EQ(false, x.second);
+  EXPECT_EQ(2, x.first->second);
+  EXPECT_EQ(2, testMap.at(copy(kHello)));
+  x = testMap.insert_or_assign(copy(kGoodbye), 4);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(4, x.first->second);
+  EXPECT_EQ(4, testMap.at(copy(kGoodbye)));
+  x = testMap.try_emplace(copy(kAdios), 3);
+  EXPECT_EQ(true, x.second);
+  EXPECT_EQ(3, x.first->second);
+  EXPECT_EQ(3, testMap.at(copy(kAdios)));
+  EXPECT_EQ(1U, testMap.erase(copy(kAdios)));
+  EXPECT_EQ(0U, testMap.erase(copy(kAdios)));
+}
+
+TEST(ProposedFlatMap, BulkConstruction) {
+  std::vector<std::pair<std::string, int>> const kInput = {
+      {"World", 1}, {"Hello", 2}, {"Map", 3}, {"Hello", 4}};
+  MapType testMap{kInput.begin(), kInput.end()};
+  EXPECT_EQ((std::vector<std::string>{"Hello", "Map", "World"}),
+            std::vector<std::string>(testMap.keys().begin(),
+                                     testMap.keys().end()));
+  EXPECT_EQ((std::vector<int>{2, 3, 1}),
+            std::vector<int>(testMap.values().begin(), testMap.values().end()));
+  testMap.insert({{"Apple", 5}, {"World", 6}});
+  EXPECT_EQ(4U, testMap.size());
+  EXPECT_EQ(5, testMap.at("Apple"sv));
+  EXPECT_EQ(1, testMap.at("World"sv));
+  int total = 0;
+  for (auto entry : testMap) {
+    total += entry.second;
+  }
+  EXPECT_EQ(11, total);
+}
+
+TEST(ProposedFlatMap, Hints) {
+  MapType testMap{};
+  auto last = testMap.end();
+  for (auto word : {"a"sv, "b"sv, "c"sv}) {
+    last = testMap.try_emplace(testMap.end(), word, 1);
+  }
+  EXPECT_EQ("c", last->first);
+  auto found = testMap.insert_or_assign(testMap.begin(), "b"sv, 7);
+  EXPECT_EQ(7, found->second);
+  EXPECT_EQ(3U, testMap.size());
+}
+
+TEST(ProposedFlatMap, HintsExactKeyType) {
+  MapType testMap{};
+  testMap.try_emplace(testMap.end(), "b"s, 1);
+  testMap.insert_or_assign(testMap.end(), "c"s, 2);
+  auto found = testMap.try_emplace(testMap.end(), "b"s, 3);
+  EXPECT_EQ(1, found->second);
+  found = testMap.insert_or_assign(testMap.begin(), "c"s, 4);
+  EXPECT_EQ(4, found->second);
+  testMap.insert(testMap.begin(), {"a"s, 5});
+  EXPECT_EQ("a", testMap.begin()->first);
+  EXPECT_EQ(3U, testMap.size());
+}
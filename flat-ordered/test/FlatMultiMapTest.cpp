@@ -0,0 +1,76 @@
+#include <proposed/flat_multimap>
+#include <proposed/string>
+#include <gtest/gtest.h>
+#include <functional>
+#include <vector>
+
+using MultiMapType =
+    proposed::flat_multimap<std::string,
+                            int,
+                            std::less<>,
+                            std::allocator<std::pair<const std::string, int>>,
+                            proposed::string_adaptor>;
+
+using namespace std::literals;
+
+TEST(ProposedFlatMultiMap, ExactKeyType) {
+  MultiMapType testMultiMap{};
+  testMultiMap.emplace("Hello"s, 1);
+  testMultiMap.emplace("Hello"s, 2);
+  testMultiMap.emplace("Hello"s, 3);
+  testMultiMap.emplace("Hello"s, 4);
+  testMultiMap.emplace("Aye"s, 1);
+  testMultiMap.emplace("Aye"s, 2);
+  testMultiMap.emplace("Zoom"s, 3);
+  testMultiMap.emplace("Zoom"s, 4);
+  EXPECT_EQ(8u, testMultiMap.size());
+  EXPECT_EQ(4u, testMultiMap.count("Hello"s));
+  EXPECT_EQ(4u, testMultiMap.erase("Hello"s));
+  EXPECT_EQ(0u, testMultiMap.count("Hello"s));
+  EXPECT_EQ(4u, testMultiMap.size());
+}
+
+TEST(ProposedFlatMultiMap, ImplicitlyConstructible) {
+  MultiMapType testMultiMap{};
+  testMultiMap.emplace("Hello", 1);
+  testMultiMap.emplace("Hello", 2);
+  testMultiMap.emplace("Hello", 3);
+  testMultiMap.emplace("Hello", 4);
+  testMultiMap.emplace("Aye", 1);
+  testMultiMap.emplace("Aye", 2);
+  testMultiMap.emplace("Zoom", 3);
+  testMultiMap.emplace("Zoom", 4);
+  EXPECT_EQ(8u, testMultiMap.size());
+  EXPECT_EQ(4u, testMultiMap.count("Hello"));
+  EXPECT_EQ(4u, testMultiMap.erase("Hello"));
+  EXPECT_EQ(0u, testMultiMap.count("Hello"));
+  EXPECT_EQ(4u, testMultiMap.size());
+}
+
+TEST(ProposedFlatMultiMap, Adaptable) {
+  MultiMapType testMultiMap{};
+  testMultiMap.emplace("Hello"s, 1);
+  testMultiMap.emplace("Hello"s, 2);
+  testMultiMap.emplace("Hello"s, 3);
+  testMultiMap.emplace("Hello"s, 4);
+  testMultiMap.emplace("Aye"s, 1);
+  testMultiMap.emplace("Aye"s, 2);
+  testMultiMap.emplace("Zoom"s, 3);
+  testMultiMap.emplace("Zoom"s, 4);
+  EXPECT_EQ(8u, testMultiMap.size());
+  EXPECT_EQ(4u, testMultiMap.count("Hello"sv));
+  EXPECT_EQ(4u, testMultiMap.erase("Hello"sv));
+  EXPECT_EQ(0u, testMultiMap.count("Hello"sv));
+  EXPECT_EQ(4u, testMultiMap.size());
+}
+
+TEST(ProposedFlatMultiMap, EquivalentKeysKeepInsertionOrder) {
+  MultiMapType testMultiMap{{"b", 1}, {"a", 2}, {"b", 3}};
+  testMultiMap.emplace("b", 4);
+  std::vector<int> values;
+  auto range = testMultiMap.equal_range("b"sv);
+  for (auto it = range.first; it != range.second; ++it) {
+    values.push_back(it->second);
+  }
+  EXPECT_EQ((std::vector<int>{1, 3, 4}), values);
+}
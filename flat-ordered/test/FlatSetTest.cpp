@@ -0,0 +1,131 @@
+#include <proposed/flat_set>
+#include <proposed/string>
+#include <gtest/gtest.h>
+#include <functional>
+#include <vector>
+#include <test-utils/copy.h>
+
+using SetType = proposed::flat_set<std::string,
+                                   std::less<>,
+                                   std::allocator<std::string>,
+                                   proposed::string_adaptor>;
+
+using namespace std::literals;
+using namespace test_utils;
+
+TEST(ProposedFlatSet, ExactValueType) {
+  auto const kHello = "Hello"s;
+  auto const kSet = "Set"s;
+  auto const kWorld = "World"s;
+  std::initializer_list<std::string> kList = {kHello, kSet, kWorld};
+  SetType testSet{};
+  testSet.insert(kHello);
+  EXPECT_EQ(1U, testSet.count(kHello));
+  testSet.insert(kList);
+  EXPECT_EQ(1U, testSet.count(kHello));
+  EXPECT_EQ(1U, testSet.count(kSet));
+  EXPECT_EQ(1U, testSet.count(kWorld));
+  EXPECT_EQ(1U, testSet.erase(kHello));
+  EXPECT_EQ(0U, testSet.erase(kHello));
+  testSet.clear();
+  // And again, with rvalues
+  testSet.insert(copy(kHello));
+  EXPECT_EQ(1U, testSet.count(copy(kHello)));
+  testSet.insert(copy(kList));
+  EXPECT_EQ(1U, testSet.count(copy(kHello)));
+  EXPECT_EQ(1U, testSet.count(copy(kSet)));
+  EXPECT_EQ(1U, testSet.count(copy(kWorld)));
+  EXPECT_EQ(1U, testSet.erase(copy(kHello)));
+  EXPECT_EQ(0U, testSet.erase(copy(kHello)));
+}
+
+TEST(ProposedFlatSet, ImplicitlyConstructible) {
+  SetType testSet{};
+  testSet.insert("Hello");
+  EXPECT_EQ(1U, testSet.count("Hello"));
+  testSet.insert({"Hello", "Set", "World"});
+  EXPECT_EQ(1U, testSet.count("Hello"));
+  EXPECT_EQ(1U, testSet.count("Set"));
+  EXPECT_EQ(1U, testSet.count("World"));
+  EXPECT_EQ(1U, testSet.erase("Hello"));
+  EXPECT_EQ(0U, testSet.erase("Hello"));
+}
+
+TEST(ProposedFlatSet, Adaptable) {
+  auto const kHello = "Hello"sv;
+  auto const kSet = "Set"sv;
+  auto const kWorld = "World"sv;
+  std::initializer_list<std::string_view> kList = {kHello, kSet, kWorld};
+  SetType testSet{};
+  testSet.insert(kHello);
+  EXPECT_EQ(1U, testSet.count(kHello));
+  testSet.insert(kList);
+  EXPECT_EQ(1U, testSet.count(kHello));
+  EXPECT_EQ(1U, testSet.count(kSet));
+  EXPECT_EQ(1U, testSet.count(kWorld));
+  EXPECT_EQ(1U, testSet.erase(kHello));
+  EXPECT_EQ(0U, testSet.erase(kHello));
+  testSet.clear();
+  // And again, with rvalues
+  testSet.insert(copy(kHello));
+  EXPECT_EQ(1U, testSet.count(copy(kHello)));
+  testSet.insert(copy(kList));
+  EXPECT_EQ(1U, testSet.count(copy(kHello)));
+  EXPECT_EQ(1U, testSet.count(copy(kSet)));
+  EXPECT_EQ(1U, testSet.count(copy(kWorld)));
+  EXPECT_EQ(1U, testSet.erase(copy(kHello)));
+  EXPECT_EQ(0U, testSet.erase(copy(kHello)));
+}
+
+TEST(ProposedFlatSet, BulkConstruction) {
+  std::vector<std::string> const kInput = {"World", "Hello", "Set", "Hello"};
+  SetType testSet{kInput.begin(), kInput.end()};
+  EXPECT_EQ((std::vector<std::string>{"Hello", "Set", "World"}),
+            std::vector<std::string>(testSet.begin(), testSet.end()));
+  testSet.insert({"Apple"s, "World"s, "Zebra"s});
+  EXPECT_EQ((std::vector<std::string>{"Apple", "Hello", "Set", "World",
+                                      "Zebra"}),
+            std::vector<std::string>(testSet.begin(), testSet.end()));
+  SetType sorted{proposed::sorted_unique, kInput.begin() + 1,
+                 kInput.begin() + 3};
+  EXPECT_EQ(2U, sorted.size());
+  EXPECT_TRUE(sorted.find("Set"sv) != sorted.end());
+}
+
+namespace {
+// Counts the comparisons made through it and every copy of it
+struct counting_less {
+  std::size_t* count;
+  bool operator()(int lhs, int rhs) const {
+    ++*count;
+    return lhs < rhs;
+  }
+};
+}  // namespace
+
+TEST(ProposedFlatSet, SortedInputSkipsSort) {
+  std::size_t comparisons = 0;
+  std::vector<int> const kInput = {1, 2, 3, 4, 5, 6, 7, 8};
+  proposed::flat_set<int, counting_less> testSet{
+      kInput.begin(), kInput.end(), counting_less{&comparisons}};
+  EXPECT_EQ(kInput.size() - 1, comparisons);
+  // Appending after the last key checks the seam and the new keys only
+  comparisons = 0;
+  std::vector<int> const kMore = {9, 10, 11};
+  testSet.insert(kMore.begin(), kMore.end());
+  EXPECT_EQ(kMore.size(), comparisons);
+  EXPECT_EQ(11U, testSet.size());
+}
+
+TEST(ProposedFlatSet, Hints) {
+  SetType testSet{};
+  for (auto word : {"a"sv, "b"sv, "c"sv, "d"sv}) {
+    testSet.insert(testSet.end(), word);
+  }
+  auto found = testSet.insert(testSet.begin(), "c"sv);
+  EXPECT_EQ("c", *found);
+  EXPECT_EQ(4U, testSet.size());
+  testSet.insert(testSet.begin(), "bb"sv);
+  EXPECT_EQ((std::vector<std::string>{"a", "b", "bb", "c", "d"}),
+            std::vector<std::string>(testSet.begin(), testSet.end()));
+}
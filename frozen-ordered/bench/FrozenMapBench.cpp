@@ -0,0 +1,101 @@
+#include <proposed/flat_map>
+#include <proposed/frozen_map>
+#include <proposed/map>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace {
+using StdMap = proposed::map<std::string, int, std::less<>>;
+using FlatMap = proposed::flat_map<std::string, int, std::less<>>;
+using FrozenMap = proposed::frozen_map<std::string, int, std::less<>>;
+
+// Keys look like identifiers. One in `sharedEvery` of them (none if 0)
+// starts with the same 14 bytes, which defeats the 8-byte prefix array and
+// leaves frozen_map comparing those keys directly.
+std::vector<std::string> makeKeys(std::size_t count, std::size_t sharedEvery) {
+  std::mt19937 rng{static_cast<unsigned>(count)};
+  std::uniform_int_distribution<int> chars{'a', 'z'};
+  std::uniform_int_distribution<int> lengths{8, 32};
+  std::vector<std::string> result;
+  result.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    std::string key =
+        sharedEvery && i % sharedEvery == 0 ? "shared/prefix/" : "";
+    for (int length = lengths(rng); length > 0; --length) {
+      key.push_back(static_cast<char>(chars(rng)));
+    }
+    result.push_back(std::move(key));
+  }
+  return result;
+}
+
+StdMap makeSource(std::vector<std::string> const& keys) {
+  StdMap result;
+  int value = 0;
+  for (auto const& key : keys) {
+    result.try_emplace(key, value++);
+  }
+  return result;
+}
+
+template <typename Map>
+Map freeze(StdMap const& source) {
+  if constexpr (std::is_same<Map, StdMap>::value) {
+    return source;
+  } else {
+    return Map{source.begin(), source.end()};
+  }
+}
+
+template <typename Map>
+void BM_LowerBound(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0), state.range(1));
+  auto const map = freeze<Map>(makeSource(keys));
+  std::vector<std::string_view> probes(keys.begin(), keys.end());
+  std::shuffle(probes.begin(), probes.end(), std::mt19937{1});
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.lower_bound(probes[i]));
+    if (++i == probes.size()) {
+      i = 0;
+    }
+  }
+}
+
+template <typename Map>
+void BM_FindMissing(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0), state.range(1));
+  auto const map = freeze<Map>(makeSource(keys));
+  auto probes = makeKeys(state.range(0) + 1, state.range(1));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(std::string_view{probes[i]}));
+    if (++i == probes.size()) {
+      i = 0;
+    }
+  }
+}
+
+void keyCounts(benchmark::internal::Benchmark* benchmark) {
+  for (auto sharedEvery : {0, 4}) {
+    for (auto count : {1 << 10, 1 << 16, 1 << 20}) {
+      benchmark->Args({count, sharedEvery});
+    }
+  }
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_LowerBound, StdMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_LowerBound, FlatMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_LowerBound, FrozenMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_FindMissing, StdMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_FindMissing, FlatMap)->Apply(keyCounts);
+BENCHMARK_TEMPLATE(BM_FindMissing, FrozenMap)->Apply(keyCounts);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace proposed {
+namespace detail {
+template <class Compare, class Key>
+inline constexpr bool is_natural_less_v{
+    std::is_same<Compare, std::less<Key>>::value ||
+    std::is_same<Compare, std::less<>>::value};
+
+// An order-preserving 64-bit summary of a key: if prefix(a) < prefix(b) then
+// a < b under `Compare`. When `exact`, equal prefixes also mean equivalent
+// keys. `accepts<K>` says whether a probe of type K can be summarised too;
+// keys and probes without one are compared directly.
+template <class Key, class Compare, class = void>
+struct frozen_prefix {
+  static constexpr bool enabled = false;
+  template <typename K>
+  static constexpr bool accepts = false;
+};
+
+// Strings ordered byte by byte: the first 8 bytes, big-endian and zero
+// padded, so that comparing prefixes as integers orders like comparing the
+// strings.
+template <class Traits, class Alloc, class Compare>
+struct frozen_prefix<
+    std::basic_string<char, Traits, Alloc>,
+    Compare,
+    std::enable_if_t<
+        std::is_same<Traits, std::char_traits<char>>::value &&
+        is_natural_less_v<Compare, std::basic_string<char, Traits, Alloc>>>> {
+  static constexpr bool enabled = true;
+  static constexpr bool exact = false;
+  template <typename K>
+  static constexpr bool accepts =
+      std::is_convertible<K const&, std::string_view>::value;
+
+  template <typename K>
+  static std::uint64_t of(K const& key) {
+    std::string_view view{key};
+    unsigned char bytes[8] = {};
+    std::memcpy(bytes, view.data(), std::min<std::size_t>(view.size(), 8));
+    std::uint64_t result = 0;
+    for (auto byte : bytes) {
+      result = (result << 8) | byte;
+    }
+    return result;
+  }
+};
+
+// Integers: the value itself, with the sign bit flipped for signed types
+template <class Key, class Compare>
+struct frozen_prefix<Key,
+                     Compare,
+                     std::enable_if_t<std::is_integral<Key>::value &&
+                                      sizeof(Key) <= 8 &&
+                                      is_natural_less_v<Compare, Key>>> {
+  static constexpr bool enabled = true;
+  static constexpr bool exact = true;
+  template <typename K>
+  static constexpr bool accepts = std::is_same<K, Key>::value;
+
+  static std::uint64_t of(Key key) {
+    if constexpr (std::is_signed<Key>::value) {
+      return static_cast<std::uint64_t>(static_cast<std::int64_t>(key)) ^
+             (std::uint64_t{1} << 63);
+    } else {
+      return key;
+    }
+  }
+};
+
+// Search index over an array of keys sorted by `Compare`, laid out as an
+// implicit binary search tree in breadth-first (Eytzinger) order: node k has
+// children 2k and 2k + 1. The top levels of the tree share a few cache
+// lines, each step is a branch-free index update, and the descendants three
+// levels below the node being compared are prefetched while it runs.
+//
+// Each node has the rank of its key in the sorted array and, where the key
+// type has one, its `frozen_prefix`. The prefixes are kept in an array of
+// their own so that the search loop mostly reads one dense array, and only
+// dereferences a key when prefixes tie.
+template <class Key, class Compare, class Allocator = std::allocator<Key>>
+struct eytzinger_index {
+  using size_type = std::size_t;
+
+  eytzinger_index() : prefixes_(prefixes_size(0)), ranks_(1) {}
+  eytzinger_index(Key const* keys, size_type count, Allocator const& alloc)
+      : prefixes_(prefixes_size(count), 0, prefix_allocator{alloc}),
+        ranks_(count + 1, 0, rank_allocator{alloc}) {
+    size_type rank = 0;
+    build(keys, 1, rank);
+  }
+
+  // Rank of the first key not less than `key`
+  template <typename K>
+  size_type lower_bound(Key const* keys,
+                        K const& key,
+                        Compare const& compare) const {
+    return search<false>(keys, key, [&](Key const& nodeKey) {
+      return compare(nodeKey, key);
+    });
+  }
+
+  // Rank of the first key greater than `key`
+  template <typename K>
+  size_type upper_bound(Key const* keys,
+                        K const& key,
+                        Compare const& compare) const {
+    return search<true>(keys, key, [&](Key const& nodeKey) {
+      return !compare(key, nodeKey);
+    });
+  }
+
+  // Rank of the key equivalent to `key`, or size() if none
+  template <typename K>
+  size_type find(Key const* keys, K const& key, Compare const& compare) const {
+    auto rank = lower_bound(keys, key, compare);
+    if (rank == size() || compare(key, keys[rank])) {
+      return size();
+    }
+    return rank;
+  }
+
+  size_type size() const noexcept { return ranks_.size() - 1; }
+
+ private:
+  using prefix_traits = frozen_prefix<Key, Compare>;
+  using prefix_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<std::uint64_t>;
+  using rank_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<size_type>;
+
+  // Eight prefixes share a cache line, so prefetching node 8k fetches all of
+  // k's great-grandchildren
+  static constexpr size_type kPrefetchStride = 8;
+
+  static size_type prefixes_size(size_type count) {
+    return prefix_traits::enabled ? count + 1 : 0;
+  }
+
+  // Fills the subtree rooted at `k` from consecutive sorted keys
+  void build(Key const* keys, size_type k, size_type& rank) {
+    if (k >= ranks_.size()) {
+      return;
+    }
+    build(keys, 2 * k, rank);
+    if constexpr (prefix_traits::enabled) {
+      prefixes_[k] = prefix_traits::of(keys[rank]);
+    }
+    ranks_[k] = rank++;
+    build(keys, 2 * k + 1, rank);
+  }
+
+  // `before(nodeKey)` is whether nodeKey orders before the position sought;
+  // `TiesBefore` is the same for a key equivalent to the probe.
+  template <bool TiesBefore, typename K, typename Before>
+  size_type search(Key const* keys, K const& key, Before&& before) const {
+    auto const* ranks = ranks_.data();
+    size_type const count = size();
+    size_type k = 1;
+    if constexpr (prefix_traits::template accepts<K>) {
+      auto const* prefixes = prefixes_.data();
+      auto const probe = prefix_traits::of(key);
+      while (k <= count) {
+#if defined(__GNUC__)
+        __builtin_prefetch(prefixes + std::min(kPrefetchStride * k, count));
+#endif
+        auto const nodePrefix = prefixes[k];
+        bool goRight;
+        if constexpr (prefix_traits::exact) {
+          goRight =
+              (nodePrefix < probe) | ((nodePrefix == probe) & TiesBefore);
+        } else {
+          // Only ties on the prefix need the key itself
+          goRight = nodePrefix < probe ||
+                    (nodePrefix == probe && before(keys[ranks[k]]));
+        }
+        k = 2 * k + goRight;
+      }
+    } else {
+      while (k <= count) {
+#if defined(__GNUC__)
+        __builtin_prefetch(ranks + std::min(kPrefetchStride * k, count));
+#endif
+        k = 2 * k + before(keys[ranks[k]]);
+      }
+    }
+    // Undo the trailing right turns, and the left turn before them, to get
+    // back to the last node we went left at
+#if defined(__GNUC__)
+    k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+#else
+    while (k & 1) {
+      k >>= 1;
+    }
+    k >>= 1;
+#endif
+    return k == 0 ? count : ranks[k];
+  }
+
+  std::vector<std::uint64_t, prefix_allocator> prefixes_;
+  std::vector<size_type, rank_allocator> ranks_;
+};
+}  // namespace detail
+}  // namespace proposed
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <memory_resource>
+#include <stdexcept>
+#include <proposed/flat_map>
+#include "eytzinger.h"
+
+namespace proposed {
+// A map that cannot change after construction, for tables that are built
+// once and then only searched. Keys and mapped values are iterated in key
+// order from two parallel arrays, and keys are found through an
+// `eytzinger_index` over the key array.
+template <class Key,
+          class T,
+          class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+struct frozen_map {
+ private:
+  using elements_type = flat_map<Key, T, Compare, Allocator>;
+  using key_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Key>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = typename elements_type::value_type;
+  using key_compare = Compare;
+  using value_compare = typename elements_type::value_compare;
+  using allocator_type = Allocator;
+  using size_type = typename elements_type::size_type;
+  using difference_type = typename elements_type::difference_type;
+  using reference = typename elements_type::const_reference;
+  using const_reference = typename elements_type::const_reference;
+  using iterator = typename elements_type::const_iterator;
+  using const_iterator = iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+
+  frozen_map() = default;
+  // From any container already ordered by `Compare`, such as a proposed::map.
+  // Sources with equivalent keys (the multi containers) keep only the
+  // first of each; checking for them costs one pass over the source.
+  template <class Container,
+            typename = std::enable_if_t<std::is_same<
+                typename Container::key_compare,
+                Compare>::value>>
+  explicit frozen_map(Container const& source,
+                      Allocator const& alloc = Allocator())
+      : frozen_map(source.begin(),
+                   source.end(),
+                   source.key_comp(),
+                   alloc) {}
+  template <class InputIt>
+  frozen_map(InputIt first,
+             InputIt last,
+             Compare const& compare = Compare(),
+             Allocator const& alloc = Allocator())
+      : elements_(first, last, compare, alloc), index_(make_index()) {}
+  template <class InputIt>
+  frozen_map(sorted_unique_t,
+             InputIt first,
+             InputIt last,
+             Compare const& compare = Compare(),
+             Allocator const& alloc = Allocator())
+      : elements_(sorted_unique, first, last, compare, alloc),
+        index_(make_index()) {}
+  frozen_map(std::initializer_list<value_type> init,
+             Compare const& compare = Compare(),
+             Allocator const& alloc = Allocator())
+      : frozen_map(init.begin(), init.end(), compare, alloc) {}
+
+  allocator_type get_allocator() const { return elements_.get_allocator(); }
+
+  iterator begin() const noexcept { return elements_.begin(); }
+  iterator end() const noexcept { return elements_.end(); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  reverse_iterator rbegin() const noexcept { return reverse_iterator{end()}; }
+  reverse_iterator rend() const noexcept { return reverse_iterator{begin()}; }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  bool empty() const noexcept { return elements_.empty(); }
+  size_type size() const noexcept { return elements_.size(); }
+
+  T const& at(key_type const& key) const { return at_impl(key); }
+
+  size_type count(key_type const& key) const { return find(key) != end(); }
+  iterator find(key_type const& key) const { return find_impl(key); }
+  bool contains(key_type const& key) const { return find(key) != end(); }
+  std::pair<iterator, iterator> equal_range(key_type const& key) const {
+    return equal_range_impl(key);
+  }
+  iterator lower_bound(key_type const& key) const {
+    return lower_bound_impl(key);
+  }
+  iterator upper_bound(key_type const& key) const {
+    return upper_bound_impl(key);
+  }
+
+  template <typename K, typename C = Compare>
+  typename std::enable_if<detail::is_transparent<C>::value, T const&>::type
+  at(K const& key) const {
+    return at_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<detail::is_transparent<C>::value, size_type>::type
+  count(K const& key) const {
+    return find(key) != end();
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<detail::is_transparent<C>::value, iterator>::type
+  find(K const& key) const {
+    return find_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<detail::is_transparent<C>::value, bool>::type
+  contains(K const& key) const {
+    return find(key) != end();
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<detail::is_transparent<C>::value,
+                          std::pair<iterator, iterator>>::type
+  equal_range(K const& key) const {
+    return equal_range_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<detail::is_transparent<C>::value, iterator>::type
+  lower_bound(K const& key) const {
+    return lower_bound_impl(key);
+  }
+  template <typename K, typename C = Compare>
+  typename std::enable_if<detail::is_transparent<C>::value, iterator>::type
+  upper_bound(K const& key) const {
+    return upper_bound_impl(key);
+  }
+
+  key_compare key_comp() const { return elements_.key_comp(); }
+  value_compare value_comp() const { return elements_.value_comp(); }
+
+  friend bool operator==(frozen_map const& lhs, frozen_map const& rhs) {
+    return lhs.elements_ == rhs.elements_;
+  }
+  friend bool operator!=(frozen_map const& lhs, frozen_map const& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  detail::eytzinger_index<Key, Compare, key_allocator> make_index() const {
+    return {elements_.keys().data(), size(), key_allocator{get_allocator()}};
+  }
+
+  template <typename K>
+  T const& at_impl(K const& key) const {
+    auto rank = index_.find(elements_.keys().data(), key, key_comp());
+    if (rank == size()) {
+      throw std::out_of_range{"No such key in map"};
+    }
+    return elements_.values()[rank];
+  }
+
+  template <typename K>
+  iterator find_impl(K const& key) const {
+    return begin() + index_.find(elements_.keys().data(), key, key_comp());
+  }
+
+  template <typename K>
+  iterator lower_bound_impl(K const& key) const {
+    return begin() +
+           index_.lower_bound(elements_.keys().data(), key, key_comp());
+  }
+
+  template <typename K>
+  iterator upper_bound_impl(K const& key) const {
+    return begin() +
+           index_.upper_bound(elements_.keys().data(), key, key_comp());
+  }
+
+  template <typename K>
+  std::pair<iterator, iterator> equal_range_impl(K const& key) const {
+    auto found = lower_bound_impl(key);
+    if (found == end() || key_comp()(key, found->first)) {
+      return {found, found};
+    }
+    return {found, found + 1};
+  }
+
+  elements_type elements_;
+  detail::eytzinger_index<Key, Compare, key_allocator> index_;
+};
+
+namespace pmr {
+template <class Key, class T, class Compare = std::less<Key>>
+using frozen_map = proposed::frozen_map<
+    Key,
+    T,
+    Compare,
+    std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+}  // namespace proposed
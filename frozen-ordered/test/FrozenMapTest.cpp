@@ -0,0 +1,70 @@
+#include <proposed/frozen_map>
+#include <proposed/map>
+#include <proposed/multimap>
+#include <gtest/gtest.h>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+TEST(ProposedFrozenMap, FromProposedMap) {
+  proposed::map<std::string, int, std::less<>> source;
+  for (int i = 0; i < 1000; ++i) {
+    // Long shared prefixes make most comparisons tie on the key prefix
+    source.try_emplace("common-prefix-" + std::to_string(i * 2), i);
+  }
+  proposed::frozen_map<std::string, int, std::less<>> frozen{source};
+  ASSERT_EQ(source.size(), frozen.size());
+  auto expected = source.begin();
+  for (auto entry : frozen) {
+    EXPECT_EQ(expected->first, entry.first);
+    EXPECT_EQ(expected->second, entry.second);
+    ++expected;
+  }
+  for (int i = 0; i < 2000; ++i) {
+    auto key = "common-prefix-" + std::to_string(i);
+    std::string_view view{key};
+    auto lower = source.lower_bound(view);
+    auto found = frozen.lower_bound(view);
+    if (lower == source.end()) {
+      EXPECT_TRUE(found == frozen.end());
+    } else {
+      EXPECT_EQ(lower->first, found->first);
+    }
+    auto upper = source.upper_bound(view);
+    auto foundUpper = frozen.upper_bound(view);
+    if (upper == source.end()) {
+      EXPECT_TRUE(foundUpper == frozen.end());
+    } else {
+      EXPECT_EQ(upper->first, foundUpper->first);
+    }
+    EXPECT_EQ(source.count(view), frozen.count(view));
+  }
+  EXPECT_EQ(21, frozen.at("common-prefix-42"sv));
+  EXPECT_EQ(21, frozen.at("common-prefix-42"s));
+  EXPECT_THROW(frozen.at("common-prefix-43"sv), std::out_of_range);
+  auto range = frozen.equal_range("common-prefix-42"sv);
+  ASSERT_TRUE(range.first != range.second);
+  EXPECT_EQ(21, range.first->second);
+  EXPECT_TRUE(++range.first == range.second);
+}
+
+TEST(ProposedFrozenMap, FromProposedMultimap) {
+  proposed::multimap<int, std::string> source{
+      {1, "one"}, {2, "two"}, {2, "deux"}, {3, "three"}};
+  proposed::frozen_map<int, std::string> frozen{source};
+  EXPECT_EQ(3U, frozen.size());
+  EXPECT_EQ(1U, frozen.count(2));
+  EXPECT_EQ("two", frozen.at(2));
+}
+
+TEST(ProposedFrozenMap, Unsorted) {
+  proposed::frozen_map<int, std::string> frozen{
+      {3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+  EXPECT_EQ(3U, frozen.size());
+  EXPECT_EQ("one", frozen.at(1));
+  EXPECT_EQ("three", frozen.rbegin()->second);
+  EXPECT_TRUE(frozen.find(4) == frozen.end());
+}
@@ -0,0 +1,88 @@
+#include <proposed/frozen_set>
+#include <proposed/multiset>
+#include <proposed/set>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+namespace {
+// Keys that tie on their first 8 bytes, differ only by trailing NULs, or
+// use bytes above 0x7f
+std::vector<std::string> const kTrickyKeys = {
+    ""s,         "\0"s,         "a"s,           "a\0"s,
+    "a\0b"s,     "abcdefgh"s,   "abcdefgh\0"s,  "abcdefghi"s,
+    "abcdefghj"s, "abcdefgz"s,  "b"s,           "\x7f"s,
+    "\x80"s,     "\xff\xff"s,   "\xff\xff\xff\xff\xff\xff\xff\xff\xff"s};
+
+template <typename Frozen, typename Sorted, typename K>
+void expectSameBounds(Frozen const& frozen,
+                      Sorted const& sorted,
+                      K const& key) {
+  auto lower = std::lower_bound(sorted.begin(), sorted.end(), key);
+  auto upper = std::upper_bound(sorted.begin(), sorted.end(), key);
+  EXPECT_EQ(lower - sorted.begin(), frozen.lower_bound(key) - frozen.begin());
+  EXPECT_EQ(upper - sorted.begin(), frozen.upper_bound(key) - frozen.begin());
+  EXPECT_EQ(static_cast<std::size_t>(upper - lower), frozen.count(key));
+  auto range = frozen.equal_range(key);
+  EXPECT_EQ(lower - sorted.begin(), range.first - frozen.begin());
+  EXPECT_EQ(upper - sorted.begin(), range.second - frozen.begin());
+}
+}  // namespace
+
+TEST(ProposedFrozenSet, FromProposedSet) {
+  proposed::set<std::string, std::less<>> source;
+  for (auto const& key : kTrickyKeys) {
+    if (key != "b") {
+      source.insert(key);
+    }
+  }
+  proposed::frozen_set<std::string, std::less<>> frozen{source};
+  std::vector<std::string> sorted(source.begin(), source.end());
+  EXPECT_TRUE(std::equal(sorted.begin(), sorted.end(), frozen.begin(),
+                         frozen.end()));
+  for (auto const& key : kTrickyKeys) {
+    expectSameBounds(frozen, sorted, key);
+    expectSameBounds(frozen, sorted, std::string_view{key});
+  }
+  EXPECT_TRUE(frozen.contains("abcdefghi"sv));
+  EXPECT_FALSE(frozen.contains("abcdefgi"sv));
+  EXPECT_TRUE(frozen.find("b"sv) == frozen.end());
+}
+
+TEST(ProposedFrozenSet, FromProposedMultiset) {
+  proposed::multiset<int> source{1, 2, 2, 3, 3, 3};
+  proposed::frozen_set<int> frozen{source};
+  EXPECT_EQ(3U, frozen.size());
+  EXPECT_EQ(1U, frozen.count(2));
+  EXPECT_EQ((std::vector<int>{1, 2, 3}),
+            std::vector<int>(frozen.begin(), frozen.end()));
+}
+
+TEST(ProposedFrozenSet, IntegerKeys) {
+  std::mt19937 rng{3};
+  std::uniform_int_distribution<int> values{-1000, 1000};
+  std::vector<int> input;
+  for (int i = 0; i < 777; ++i) {
+    input.push_back(values(rng));
+  }
+  proposed::frozen_set<int> frozen{input.begin(), input.end()};
+  std::sort(input.begin(), input.end());
+  input.erase(std::unique(input.begin(), input.end()), input.end());
+  ASSERT_EQ(input.size(), frozen.size());
+  for (int key = -1002; key <= 1002; ++key) {
+    expectSameBounds(frozen, input, key);
+  }
+}
+
+TEST(ProposedFrozenSet, Empty) {
+  proposed::frozen_set<std::string> frozen{};
+  EXPECT_TRUE(frozen.empty());
+  EXPECT_TRUE(frozen.find("x"s) == frozen.end());
+  EXPECT_TRUE(frozen.lower_bound("x"s) == frozen.end());
+  EXPECT_TRUE(frozen.upper_bound(""s) == frozen.end());
+}
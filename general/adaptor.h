@@ -1,5 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 namespace proposed {
 // New Concept: Adaptor
 // The type T satisifies Adaptor if:
@@ -25,6 +33,263 @@ namespace proposed {
 //       void operator()(target_type *p, Source&& source);
 //   and is present must construct a `target_type` in the uninitialised storage
 //   addressed by `p`
+// * The same methods are also available under the name `adapt`, which is
+//   what the adaptor-aware containers call
+// * The instance template methods may be optionally defined:
+//       void adapt(target_type *p, Source&& source, Alloc const& alloc);
+//       void operator()(target_type *p, Source&& source, Alloc const& alloc);
+//   and if present must construct a `target_type` at `p` by uses-allocator
+//   construction with `alloc`, the allocator of the container it is for
+// * The instance method may be optionally defined:
+//       void adapt_n(target_type *out, Source const* in, std::size_t n);
+//   and if present must construct `n` targets at `out` from the `n` sources
+//   at `in`, as `n` calls of `adapt` would, leaving none constructed if it
+//   throws. Range insertion of adapted values uses it in batches.
+// * The instance template method may be optionally defined:
+//       void adapt_n(target_type *out, Source const* in, std::size_t n,
+//                    Alloc const& alloc);
+//   and if present must do the same, building each target as the
+//   allocator-extended `adapt` would. Range insertion into a container whose
+//   allocators are not all equal uses it in batches.
+
+namespace detail {
+// Runs `adaptor` over `input` into `p`: through its `adapt` method if it has
+// one, otherwise as a function object
+template <typename A, typename Target, typename X>
+auto invoke_adaptor(A& adaptor, Target* p, X&& input, int)
+    -> decltype(adaptor.adapt(p, std::forward<X>(input))) {
+  return adaptor.adapt(p, std::forward<X>(input));
+}
+template <typename A, typename Target, typename X>
+void invoke_adaptor(A& adaptor, Target* p, X&& input, long) {
+  adaptor(p, std::forward<X>(input));
+}
+template <typename A, typename Target, typename X>
+void invoke_adaptor(A& adaptor, Target* p, X&& input) {
+  invoke_adaptor(adaptor, p, std::forward<X>(input), 0);
+}
+
+// Constructs a `T` at `p` from `args` by uses-allocator construction: with
+// `alloc` after `std::allocator_arg` or at the end, if `T` uses an
+// allocator that `alloc` converts to, and from `args` alone otherwise
+template <typename T, typename Alloc, typename... Args>
+void construct_using_allocator(T* p, Alloc const& alloc, Args&&... args) {
+  if constexpr (!std::uses_allocator_v<T, Alloc>) {
+    ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+  } else if constexpr (std::is_constructible_v<T,
+                                               std::allocator_arg_t,
+                                               Alloc const&,
+                                               Args...>) {
+    ::new (static_cast<void*>(p))
+        T(std::allocator_arg, alloc, std::forward<Args>(args)...);
+  } else {
+    ::new (static_cast<void*>(p)) T(std::forward<Args>(args)..., alloc);
+  }
+}
+
+template <int N>
+struct priority : priority<N - 1> {};
+template <>
+struct priority<0> {};
+
+// As `invoke_adaptor`, offering `adaptor` the container's allocator `alloc`
+// for the target. `adapt` is still preferred to `operator()`, and under
+// either name the allocator-extended form is preferred; adaptors that take no
+// allocator build the target as they would anyway.
+template <typename A, typename Target, typename X, typename Alloc>
+auto adapt_using_allocator(A& adaptor,
+                           Target* p,
+                           X&& input,
+                           Alloc const& alloc,
+                           priority<3>)
+    -> decltype(adaptor.adapt(p, std::forward<X>(input), alloc)) {
+  return adaptor.adapt(p, std::forward<X>(input), alloc);
+}
+template <typename A, typename Target, typename X, typename Alloc>
+auto adapt_using_allocator(A& adaptor,
+                           Target* p,
+                           X&& input,
+                           Alloc const&,
+                           priority<2>)
+    -> decltype(adaptor.adapt(p, std::forward<X>(input))) {
+  return adaptor.adapt(p, std::forward<X>(input));
+}
+template <typename A, typename Target, typename X, typename Alloc>
+auto adapt_using_allocator(A& adaptor,
+                           Target* p,
+                           X&& input,
+                           Alloc const& alloc,
+                           priority<1>)
+    -> decltype(adaptor(p, std::forward<X>(input), alloc)) {
+  return adaptor(p, std::forward<X>(input), alloc);
+}
+template <typename A, typename Target, typename X, typename Alloc>
+void adapt_using_allocator(A& adaptor,
+                           Target* p,
+                           X&& input,
+                           Alloc const&,
+                           priority<0>) {
+  adaptor(p, std::forward<X>(input));
+}
+template <typename A, typename Target, typename X, typename Alloc>
+void adapt_using_allocator(A& adaptor,
+                           Target* p,
+                           X&& input,
+                           Alloc const& alloc) {
+  adapt_using_allocator(adaptor, p, std::forward<X>(input), alloc,
+                        priority<3>{});
+}
+
+// Uninitialised storage for a `T` with the lifetime of the enclosing scope;
+// whoever constructs `value` destroys it
+template <typename T>
+union adaptor_scratch {
+  adaptor_scratch() {}
+  ~adaptor_scratch() {}
+  T value;
+};
+
+// As `adaptor_scratch`, for `N` of them
+template <typename T, std::size_t N>
+union scratch_array {
+  scratch_array() {}
+  ~scratch_array() {}
+  T values[N];
+};
+
+template <typename T>
+void destroy_n(T* p, std::size_t n) noexcept {
+  for (std::size_t i = 0; i < n; ++i) {
+    p[i].~T();
+  }
+}
+
+// Whether `A` has a batch `adapt_n` for sources of type `Source`
+template <typename A, typename Source, typename = void>
+struct has_adapt_n : std::false_type {};
+template <typename A, typename Source>
+struct has_adapt_n<
+    A,
+    Source,
+    std::void_t<decltype(std::declval<A&>().adapt_n(
+        std::declval<typename A::target_type*>(),
+        std::declval<Source const*>(),
+        std::size_t{}))>> : std::true_type {};
+
+// Whether `A` has a batch `adapt_n` for sources of type `Source` taking the
+// container's allocator, of type `Alloc`
+template <typename A, typename Source, typename Alloc, typename = void>
+struct has_adapt_n_using_allocator : std::false_type {};
+template <typename A, typename Source, typename Alloc>
+struct has_adapt_n_using_allocator<
+    A,
+    Source,
+    Alloc,
+    std::void_t<decltype(std::declval<A&>().adapt_n(
+        std::declval<typename A::target_type*>(),
+        std::declval<Source const*>(),
+        std::size_t{},
+        std::declval<Alloc const&>()))>> : std::true_type {};
+
+// Constructs `n` `T`s at `out` from the `n` sources at `in` as
+// `construct_using_allocator` does. If it throws, none are left constructed.
+template <typename T, typename Source, typename Alloc>
+void construct_n_using_allocator(T* out,
+                                 Source const* in,
+                                 std::size_t n,
+                                 Alloc const& alloc) {
+  std::size_t done = 0;
+  try {
+    for (; done < n; ++done) {
+      construct_using_allocator(out + done, alloc, in[done]);
+    }
+  } catch (...) {
+    destroy_n(out, done);
+    throw;
+  }
+}
+
+// Adapts the `n` sources at `in` into `out`: in one call if `adaptor` has
+// `adapt_n`, otherwise one at a time. If it throws, no targets are left
+// constructed.
+template <typename A, typename Source>
+void adapt_n(A& adaptor,
+             typename A::target_type* out,
+             Source const* in,
+             std::size_t n) {
+  if constexpr (has_adapt_n<A, Source>::value) {
+    adaptor.adapt_n(out, in, n);
+  } else {
+    std::size_t done = 0;
+    try {
+      for (; done < n; ++done) {
+        invoke_adaptor(adaptor, out + done, in[done]);
+      }
+    } catch (...) {
+      destroy_n(out, done);
+      throw;
+    }
+  }
+}
+
+// As above, building each target with `alloc` as `adapt_using_allocator`
+// does: in one call if `adaptor` has an allocator-extended `adapt_n`
+template <typename A, typename Source, typename Alloc>
+void adapt_n(A& adaptor,
+             typename A::target_type* out,
+             Source const* in,
+             std::size_t n,
+             Alloc const& alloc) {
+  if constexpr (has_adapt_n_using_allocator<A, Source, Alloc>::value) {
+    adaptor.adapt_n(out, in, n, alloc);
+  } else {
+    std::size_t done = 0;
+    try {
+      for (; done < n; ++done) {
+        adapt_using_allocator(adaptor, out + done, in[done], alloc);
+      }
+    } catch (...) {
+      destroy_n(out, done);
+      throw;
+    }
+  }
+}
+
+// How many values the batch paths adapt at once
+inline constexpr std::size_t kAdaptBatch = 32;
+}  // namespace detail
+
+// How expensive an adaptation is, cheapest first, for `union_adaptor` to
+// choose between adaptors that accept the same source
+enum class adaptation_cost { trivial, moves, copies, allocates };
+
+// The cost of adapting an `X` (with its value category, as passed) with
+// `Adaptor`. Adaptors opt in by defining a static constexpr
+// `adaptation_cost` template `cost<X>`; those that don't are assumed to
+// allocate.
+template <typename Adaptor, typename X, typename = void>
+struct adaptor_cost
+    : std::integral_constant<adaptation_cost, adaptation_cost::allocates> {};
+template <typename Adaptor, typename X>
+struct adaptor_cost<Adaptor,
+                    X,
+                    std::void_t<decltype(Adaptor::template cost<X>)>>
+    : std::integral_constant<adaptation_cost, Adaptor::template cost<X>> {};
+template <typename Adaptor, typename X>
+inline constexpr adaptation_cost adaptor_cost_v{
+    adaptor_cost<Adaptor, X>::value};
+
+namespace detail {
+// The cost of constructing a `Result` from an `X`
+template <typename Result, typename X>
+inline constexpr adaptation_cost construction_cost_v{
+    std::is_trivially_constructible_v<Result, X&&>
+        ? adaptation_cost::trivial
+        : std::is_same_v<Result, std::decay_t<X>> &&
+                  !std::is_lvalue_reference_v<X>
+              ? adaptation_cost::moves
+              : adaptation_cost::copies};
+}  // namespace detail
 
 // Default Adaptor for adaptor aware containers so that they have the
 // pre-adaptor behaviour
@@ -43,11 +308,40 @@ struct constructible_adaptor {
   static bool constexpr adapts{
       std::is_constructible_v<Result, std::decay_t<X> const&> ||
       std::is_constructible_v<Result, std::decay_t<X>&&>};
+  template <typename X>
+  static adaptation_cost constexpr cost{
+      detail::construction_cost_v<Result, X>};
 
   template <typename X>
   void operator()(target_type* pResult, X&& input) {
     ::new (static_cast<void*>(pResult)) target_type(std::forward<X>(input));
   }
+  template <typename X>
+  void adapt(target_type* pResult, X&& input) {
+    (*this)(pResult, std::forward<X>(input));
+  }
+  template <typename X, typename Alloc>
+  void operator()(target_type* pResult, X&& input, Alloc const& alloc) {
+    detail::construct_using_allocator(pResult, alloc, std::forward<X>(input));
+  }
+  template <typename X, typename Alloc>
+  void adapt(target_type* pResult, X&& input, Alloc const& alloc) {
+    (*this)(pResult, std::forward<X>(input), alloc);
+  }
+  // Only for conversions that do real work. Trivial ones inline to a
+  // vectorised loop one value at a time; a batch buffer only slows them.
+  template <typename X>
+  std::enable_if_t<std::is_constructible_v<Result, X const&> &&
+                   !std::is_trivially_constructible_v<Result, X const&>>
+  adapt_n(target_type* out, X const* in, std::size_t n) {
+    std::uninitialized_copy_n(in, n, out);
+  }
+  template <typename X, typename Alloc>
+  std::enable_if_t<std::is_constructible_v<Result, X const&> &&
+                   !std::is_trivially_constructible_v<Result, X const&>>
+  adapt_n(target_type* out, X const* in, std::size_t n, Alloc const& alloc) {
+    detail::construct_n_using_allocator(out, in, n, alloc);
+  }
 };
 
 // Adaptor for any type `Result` which adapts all types for which it has a
@@ -61,235 +355,434 @@ struct implicit_constructible_adaptor {
        std::is_constructible_v<Result, std::decay_t<X> const&>) ||
       (std::is_assignable_v<Result, std::decay_t<X>&&> &&
        std::is_constructible_v<Result, std::decay_t<X>&&>)};
+  template <typename X>
+  static adaptation_cost constexpr cost{
+      detail::construction_cost_v<Result, X>};
 
   template <typename X>
   void operator()(target_type* pResult, X&& input) {
     ::new (static_cast<void*>(pResult)) target_type(std::forward<X>(input));
   }
+  template <typename X>
+  void adapt(target_type* pResult, X&& input) {
+    (*this)(pResult, std::forward<X>(input));
+  }
+  template <typename X, typename Alloc>
+  void operator()(target_type* pResult, X&& input, Alloc const& alloc) {
+    detail::construct_using_allocator(pResult, alloc, std::forward<X>(input));
+  }
+  template <typename X, typename Alloc>
+  void adapt(target_type* pResult, X&& input, Alloc const& alloc) {
+    (*this)(pResult, std::forward<X>(input), alloc);
+  }
+  // Only for conversions that do real work. Trivial ones inline to a
+  // vectorised loop one value at a time; a batch buffer only slows them.
+  template <typename X>
+  std::enable_if_t<std::is_constructible_v<Result, X const&> &&
+                   !std::is_trivially_constructible_v<Result, X const&>>
+  adapt_n(target_type* out, X const* in, std::size_t n) {
+    std::uninitialized_copy_n(in, n, out);
+  }
+  template <typename X, typename Alloc>
+  std::enable_if_t<std::is_constructible_v<Result, X const&> &&
+                   !std::is_trivially_constructible_v<Result, X const&>>
+  adapt_n(target_type* out, X const* in, std::size_t n, Alloc const& alloc) {
+    detail::construct_n_using_allocator(out, in, n, alloc);
+  }
 };
 
-template <typename Adaptor, typename... Args>
+// Adaptor accepting everything any of `Adaptors` accepts, all of which must
+// share a `target_type`. Each source type is routed at compile time to the
+// cheapest adaptor that accepts it, by `adaptor_cost`; ties go to the one
+// listed first.
+template <typename... Adaptors>
 struct union_adaptor {
  private:
-  using remainder = union_adaptor<Args...>;
-  Adaptor adaptor_;
-  remainder remainder_;
+  static_assert(sizeof...(Adaptors) > 0,
+                "`union_adaptor` needs at least one adaptor");
+  using adaptors_type = std::tuple<Adaptors...>;
+  using first_type = std::tuple_element_t<0, adaptors_type>;
+  static constexpr std::size_t kNone = sizeof...(Adaptors);
+
+  template <typename X>
+  static constexpr std::size_t select() {
+    constexpr bool viable[] = {
+        Adaptors::template adapts<std::decay_t<X>>...};
+    constexpr adaptation_cost costs[] = {adaptor_cost_v<Adaptors, X>...};
+    std::size_t best = kNone;
+    for (std::size_t i = 0; i < kNone; ++i) {
+      if (viable[i] && (best == kNone || costs[i] < costs[best])) {
+        best = i;
+      }
+    }
+    return best;
+  }
+
+  adaptors_type adaptors_;
 
  public:
-  static_assert(std::is_same_v<Adaptor::target_type, remainder::target_type>,
+  using target_type = typename first_type::target_type;
+  static_assert((std::is_same_v<target_type, typename Adaptors::target_type> &&
+                 ...),
                 "The `target_type` of all adaptor parameters to "
                 "`union_adaptor` must be the same");
-  union_adaptor() {}
-  union_adaptor(Adaptor adaptor, Args... args)
-      : adaptor_(adaptor), remainder_(std::move(args)...) {}
-  using target_type = typename Adaptor::target_type;
+  union_adaptor() = default;
+  union_adaptor(Adaptors... adaptors) : adaptors_(std::move(adaptors)...) {}
   template <typename X>
-  static bool constexpr adapts{Adaptor::template adapts<X> ||
-                               remainder::template adapts<X>};
+  static bool constexpr adapts{(Adaptors::template adapts<X> || ...)};
+  // Index in `Adaptors` of the adaptor used for an `X` (with its value
+  // category, as passed), or `sizeof...(Adaptors)` if none accepts it
+  template <typename X>
+  static std::size_t constexpr selects{select<X>()};
 
+ private:
   template <typename X>
-  void operator()(target_type* pResult, X&& input) {
-    if (adaptor_.adapts<X>) {
-      adaptor_(pResult, std::forward<X>(input));
+  static constexpr bool batches_impl() {
+    if constexpr (selects<X const&> == kNone) {
+      return false;
     } else {
-      remainder_(pResult, std::forward<X>(input));
+      return detail::has_adapt_n<std::tuple_element_t<selects<X const&>,
+                                                      adaptors_type>,
+                                 X>::value;
     }
   }
-};
-
-template <typename Adaptor>
-struct union_adaptor<Adaptor> {
- private:
-  Adaptor adaptor_;
+  template <typename X>
+  static bool constexpr batches{batches_impl<X>()};
+  template <typename X, typename Alloc>
+  static constexpr bool batches_using_allocator_impl() {
+    if constexpr (selects<X const&> == kNone) {
+      return false;
+    } else {
+      return detail::has_adapt_n_using_allocator<
+          std::tuple_element_t<selects<X const&>, adaptors_type>,
+          X,
+          Alloc>::value;
+    }
+  }
+  template <typename X, typename Alloc>
+  static bool constexpr batches_using_allocator{
+      batches_using_allocator_impl<X, Alloc>()};
 
  public:
-  union_adaptor() {}
-  union_adaptor(Adaptor adaptor) : adaptor_(adaptor) {}
-  using target_type = typename Adaptor::target_type;
   template <typename X>
-  static bool constexpr adapts{Adaptor::template adapts<X>};
-
+  std::enable_if_t<selects<X> != kNone> operator()(target_type* pResult,
+                                                   X&& input) {
+    detail::invoke_adaptor(
+        std::get<selects<X>>(adaptors_), pResult, std::forward<X>(input));
+  }
   template <typename X>
-  void operator()(target_type* pResult, X&& input) {
-    adaptor_(pResult, std::forward<X>(input));
+  std::enable_if_t<selects<X> != kNone> adapt(target_type* pResult,
+                                              X&& input) {
+    (*this)(pResult, std::forward<X>(input));
+  }
+  template <typename X, typename Alloc>
+  std::enable_if_t<selects<X> != kNone> operator()(target_type* pResult,
+                                                   X&& input,
+                                                   Alloc const& alloc) {
+    detail::adapt_using_allocator(std::get<selects<X>>(adaptors_), pResult,
+                                  std::forward<X>(input), alloc);
+  }
+  template <typename X, typename Alloc>
+  std::enable_if_t<selects<X> != kNone> adapt(target_type* pResult,
+                                              X&& input,
+                                              Alloc const& alloc) {
+    (*this)(pResult, std::forward<X>(input), alloc);
+  }
+  // Only if the adaptor chosen for an `X const&` has one itself
+  template <typename X>
+  std::enable_if_t<batches<X>> adapt_n(target_type* out,
+                                       X const* in,
+                                       std::size_t n) {
+    std::get<selects<X const&>>(adaptors_).adapt_n(out, in, n);
+  }
+  template <typename X, typename Alloc>
+  std::enable_if_t<batches_using_allocator<X, Alloc>> adapt_n(
+      target_type* out,
+      X const* in,
+      std::size_t n,
+      Alloc const& alloc) {
+    std::get<selects<X const&>>(adaptors_).adapt_n(out, in, n, alloc);
   }
 };
 
-template <typename First,
-          typename Second,
-          typename Allocator = std::allocator<typename First::target_type>>
+// Adaptor running each of `Adaptors` over the result of the one before:
+// `chain_adaptor<A, B, C>` adapts what `A` adapts, to `C::target_type`. The
+// intermediate results live on the stack for the duration of the call and
+// the whole chain is one inlinable call, so chaining through a cheap
+// intermediate such as a `string_view` costs nothing over adapting directly.
+template <typename... Adaptors>
 struct chain_adaptor {
  private:
-  using aTraits = std::allocator_traits<Allocator>;
-  Second second_;
-  First first_;
-  Allocator allocator_;
+  static_assert(sizeof...(Adaptors) >= 2,
+                "`chain_adaptor` needs at least two adaptors");
+  using adaptors_type = std::tuple<Adaptors...>;
+  template <std::size_t I>
+  using link = std::tuple_element_t<I, adaptors_type>;
+  static constexpr std::size_t kLast = sizeof...(Adaptors) - 1;
 
- public:
-  static_assert(Second::template adapts<typename First::target_type>,
-                "The second adaptor must be able to adapt the first adaptor's "
+  template <std::size_t... I>
+  static constexpr bool links_match(std::index_sequence<I...>) {
+    return (link<I + 1>::template adapts<typename link<I>::target_type> &&
+            ...);
+  }
+  static_assert(links_match(std::make_index_sequence<kLast>{}),
+                "Each adaptor must be able to adapt the previous adaptor's "
                 "`target_type`");
-  explicit chain_adaptor(First first = {},
-                         Second second = {},
-                         Allocator allocator = {})
-      : first_(first), second_(second), allocator_(allocator) {}
-  using target_type = typename Second::target_type;
+
+  template <typename X, std::size_t... I>
+  static constexpr bool links_batch(std::index_sequence<I...>) {
+    return detail::has_adapt_n<link<0>, X>::value ||
+           (detail::has_adapt_n<link<I + 1>,
+                                typename link<I>::target_type>::value ||
+            ...);
+  }
   template <typename X>
-  static bool constexpr adapts{First::template adapts<X>};
+  static bool constexpr batches{
+      links_batch<X>(std::make_index_sequence<kLast>{})};
+
+  adaptors_type adaptors_;
+
+ public:
+  chain_adaptor() = default;
+  explicit chain_adaptor(Adaptors... adaptors)
+      : adaptors_(std::move(adaptors)...) {}
+  using target_type = typename link<kLast>::target_type;
+  template <typename X>
+  static bool constexpr adapts{link<0>::template adapts<X>};
 
   template <typename X>
   void operator()(target_type* pResult, X&& input) {
-    auto pIntermediate = aTraits::allocate(allocator_, 1);
-    first_(pIntermediate, std::forward<X>(input));
-    second_(pResult, std::move(*pIntermediate));
-    aTraits::deallocate(allocator_, pIntermediate, 1);
+    run<0>(pResult, std::forward<X>(input));
+  }
+  template <typename X>
+  void adapt(target_type* pResult, X&& input) {
+    run<0>(pResult, std::forward<X>(input));
+  }
+  // Only the final result is built with the container's allocator; the
+  // intermediates are gone before the call returns
+  template <typename X, typename Alloc>
+  void operator()(target_type* pResult, X&& input, Alloc const& alloc) {
+    run<0>(pResult, std::forward<X>(input), &alloc);
+  }
+  template <typename X, typename Alloc>
+  void adapt(target_type* pResult, X&& input, Alloc const& alloc) {
+    run<0>(pResult, std::forward<X>(input), &alloc);
+  }
+  // Only if some link has an `adapt_n` of its own. Each link adapts a
+  // whole batch before the next one starts; the rest run one at a time.
+  template <typename X>
+  std::enable_if_t<adapts<X const&> && batches<X>> adapt_n(target_type* out,
+                                                           X const* in,
+                                                           std::size_t n) {
+    run_n<0>(out, in, n);
+  }
+  template <typename X, typename Alloc>
+  std::enable_if_t<adapts<X const&> && batches<X>> adapt_n(
+      target_type* out,
+      X const* in,
+      std::size_t n,
+      Alloc const& alloc) {
+    run_n<0>(out, in, n, &alloc);
+  }
+
+ private:
+  template <std::size_t I, typename X, typename Alloc = void>
+  void run_n(target_type* out,
+             X const* in,
+             std::size_t n,
+             Alloc const* alloc = nullptr) {
+    if constexpr (I == kLast) {
+      if constexpr (std::is_void_v<Alloc>) {
+        detail::adapt_n(std::get<I>(adaptors_), out, in, n);
+      } else {
+        detail::adapt_n(std::get<I>(adaptors_), out, in, n, *alloc);
+      }
+    } else {
+      using intermediate_type = typename link<I>::target_type;
+      detail::scratch_array<intermediate_type, detail::kAdaptBatch> scratch;
+      std::size_t done = 0;
+      while (done < n) {
+        auto const count = std::min(n - done, detail::kAdaptBatch);
+        detail::adapt_n(
+            std::get<I>(adaptors_), scratch.values, in + done, count);
+        try {
+          run_n<I + 1>(out + done, scratch.values, count, alloc);
+        } catch (...) {
+          detail::destroy_n(scratch.values, count);
+          detail::destroy_n(out, done);
+          throw;
+        }
+        detail::destroy_n(scratch.values, count);
+        done += count;
+      }
+    }
+  }
+
+  template <std::size_t I, typename X, typename Alloc = void>
+  void run(target_type* pResult, X&& input, Alloc const* alloc = nullptr) {
+    if constexpr (I == kLast) {
+      if constexpr (std::is_void_v<Alloc>) {
+        detail::invoke_adaptor(
+            std::get<I>(adaptors_), pResult, std::forward<X>(input));
+      } else {
+        detail::adapt_using_allocator(
+            std::get<I>(adaptors_), pResult, std::forward<X>(input), *alloc);
+      }
+    } else {
+      using intermediate_type = typename link<I>::target_type;
+      detail::adaptor_scratch<intermediate_type> scratch;
+      detail::invoke_adaptor(
+          std::get<I>(adaptors_), &scratch.value, std::forward<X>(input));
+      try {
+        run<I + 1>(pResult, std::move(scratch.value), alloc);
+      } catch (...) {
+        scratch.value.~intermediate_type();
+        throw;
+      }
+      scratch.value.~intermediate_type();
+    }
   }
 };
 
 namespace detail {
-template <typename Adaptor,
-          typename Iterator,
-          typename Allocator = std::allocator<typename Adaptor::target_type>>
+// Iterator over the results of adapting the elements of `Iterator`. The
+// adapted value is built inside the iterator, the first time it is
+// dereferenced at each position; copies start without one and adapt again
+// only if they are dereferenced themselves. Adaptation is a pure function
+// of the element, so multiple passes see equal values, though two iterators
+// at the same position hold distinct copies of them. It is a forward
+// iterator at most: the value dies with the iterator, and adaptors like
+// std::reverse_iterator dereference a temporary.
+template <typename Adaptor, typename Iterator>
 struct adapting_input_iterator {
   using value_type = typename Adaptor::target_type;
-  using pointer = value_type const*;
-  using reference = value_type const&;
+  using pointer = value_type*;
+  using reference = value_type&;
   using difference_type =
       typename std::iterator_traits<Iterator>::difference_type;
-  using iterator_category = std::input_iterator_tag;
+  using iterator_category = std::conditional_t<
+      std::is_base_of_v<
+          std::forward_iterator_tag,
+          typename std::iterator_traits<Iterator>::iterator_category>,
+      std::forward_iterator_tag,
+      std::input_iterator_tag>;
 
   adapting_input_iterator() {}
-
+  adapting_input_iterator(adapting_input_iterator const& other)
+      : adaptor_(other.adaptor_), underlying_(other.underlying_) {}
   adapting_input_iterator(adapting_input_iterator&& other)
       : adaptor_(std::move(other.adaptor_)),
-        underlying_(std::move(other.underlying_)),
-        value_(other.value_) {
-    other.value_ = nullptr;
-  }
-  adapting_input_iterator(adapting_input_iterator const& other)
-      : adaptor_(other.adaptor_), underlying_(other.underlying_) {
-    if (other.value_) {
-      ensureValue();
-    }
+        underlying_(std::move(other.underlying_)) {
+    take_value(other);
   }
+  explicit adapting_input_iterator(Iterator underlying)
+      : underlying_(std::move(underlying)) {}
+  adapting_input_iterator(Adaptor adaptor, Iterator underlying)
+      : adaptor_(std::move(adaptor)), underlying_(std::move(underlying)) {}
+  ~adapting_input_iterator() { reset(); }
 
-  explicit adapting_input_iterator(Adaptor adaptor, Allocator allocator = {})
-      : adaptor_(adaptor), allocator_(allocator) {}
-  explicit adapting_input_iterator(Iterator underlying,
-                                   Allocator allocator = {})
-      : underlying_(underlying), allocator_(allocator) {}
-  adapting_input_iterator(Adaptor adaptor,
-                          Iterator underlying,
-                          Allocator allocator = {})
-      : adaptor_(adaptor), underlying_(underlying), allocator_(allocator) {}
-  ~adapting_input_iterator() { ensureNoValue(); }
-
-  adapting_input_iterator& operator=(adapting_input_iterator&& other) {
-    ensureNoValue();
-    ::new (static_cast<void*>(this)) adapting_input_iterator(std::move(other));
+  adapting_input_iterator& operator=(adapting_input_iterator const& other) {
+    if (this != &other) {
+      reset();
+      adaptor_ = other.adaptor_;
+      underlying_ = other.underlying_;
+    }
     return *this;
   }
-  adapting_input_iterator& operator=(adapting_input_iterator const& other) {
-    ensureNoValue();
-    ::new (static_cast<void*>(this)) adapting_input_iterator(other);
+  adapting_input_iterator& operator=(adapting_input_iterator&& other) {
+    if (this != &other) {
+      reset();
+      adaptor_ = std::move(other.adaptor_);
+      underlying_ = std::move(other.underlying_);
+      take_value(other);
+    }
     return *this;
   }
 
-  bool operator==(adapting_input_iterator const& other) const {
-    return adaptor_ == other.adaptor_ && underlying_ == other.underlying_;
-  }
-  bool operator!=(adapting_input_iterator const& other) const {
-    return !operator==(other);
+  Iterator const& base() const { return underlying_; }
+  Adaptor& adaptor() const { return adaptor_; }
+
+  // The value may be moved from, as by std::make_move_iterator
+  reference operator*() const {
+    if (!hasValue_) {
+      detail::invoke_adaptor(adaptor_, &value_.value, *underlying_);
+      hasValue_ = true;
+    }
+    return value_.value;
   }
-  bool operator==(Iterator const& other) const { return underlying_ == other; }
-  bool operator!=(Iterator const& other) const { return !operator==(other); }
+  pointer operator->() const { return std::addressof(**this); }
 
   adapting_input_iterator& operator++() {
-    ensureNoValue();
+    reset();
     ++underlying_;
     return *this;
   }
-
   adapting_input_iterator operator++(int) {
-    adapting_input_iterator result{};
-    result.adaptor_ = adaptor_;
-    result.underlying_ = underlying_;
-    result.value_ = value_;
-    value_ = nullptr;
+    adapting_input_iterator result{*this};
+    result.take_value(*this);
     ++underlying_;
     return result;
   }
 
-  pointer operator->() {
-    ensureValue();
-    return value_;
+  friend bool operator==(adapting_input_iterator const& lhs,
+                         adapting_input_iterator const& rhs) {
+    return lhs.underlying_ == rhs.underlying_;
   }
-  reference operator*() {
-    ensureValue();
-    return *value_;
+  friend bool operator!=(adapting_input_iterator const& lhs,
+                         adapting_input_iterator const& rhs) {
+    return !(lhs == rhs);
   }
+  bool operator==(Iterator const& other) const { return underlying_ == other; }
+  bool operator!=(Iterator const& other) const { return !operator==(other); }
 
  private:
-  using aTraits = std::allocator_traits<Allocator>;
-  void ensureValue() {
-    if (value_) {
-      return;
+  void reset() {
+    if (hasValue_) {
+      value_.value.~value_type();
+      hasValue_ = false;
     }
-    value_ = aTraits::allocate(allocator_, 1);
-    adaptor_(value_, *underlying_);
   }
-  void ensureNoValue() {
-    if (!value_) {
-      return;
+
+  // The source may be single-pass, so an adapted value goes with the
+  // position rather than being adapted again
+  void take_value(adapting_input_iterator& other) {
+    if (other.hasValue_) {
+      ::new (static_cast<void*>(&value_.value))
+          value_type(std::move(other.value_.value));
+      hasValue_ = true;
+      other.reset();
     }
-    value_->~value_type();
-    aTraits::deallocate(allocator_, value_, 1);
-    value_ = nullptr;
   }
-  Adaptor adaptor_;
+
+  mutable Adaptor adaptor_;
   Iterator underlying_;
-  Allocator allocator_;
-  value_type* value_;
+  mutable adaptor_scratch<value_type> value_;
+  mutable bool hasValue_ = false;
 };
 
-template <typename Adaptor,
-          typename Iterator,
-          typename Allocator = std::allocator<typename Adaptor::target_type>>
+// Output iterator adapting each value assigned through it and passing the
+// result on to `Iterator`. The adapted value is built on the stack and
+// moved into the underlying iterator's assignment.
+template <typename Adaptor, typename Iterator>
 struct adapting_output_iterator {
   using iterator_category = std::output_iterator_tag;
+  using value_type = void;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = void;
 
   adapting_output_iterator() {}
+  explicit adapting_output_iterator(Iterator underlying)
+      : underlying_(std::move(underlying)) {}
+  adapting_output_iterator(Adaptor adaptor, Iterator underlying)
+      : adaptor_(std::move(adaptor)), underlying_(std::move(underlying)) {}
 
-  adapting_output_iterator(adapting_output_iterator&& other)
-      : adaptor_(std::move(other.adaptor_)),
-        underlying_(std::move(other.underlying_)) {}
-  adapting_output_iterator(adapting_output_iterator const& other)
-      : adaptor_(other.adaptor_), underlying_(other.underlying_) {}
-
-  explicit adapting_output_iterator(Adaptor adaptor, Allocator allocator = {})
-      : adaptor_(adaptor), allocator_(allocator) {}
-  explicit adapting_output_iterator(Iterator underlying,
-                                    Allocator allocator = {})
-      : underlying_(underlying), allocator_(allocator) {}
-  adapting_output_iterator(Adaptor adaptor,
-                           Iterator underlying,
-                           Allocator allocator = {})
-      : adaptor_(adaptor), underlying_(underlying), allocator_(allocator) {}
-
-  adapting_output_iterator& operator=(adapting_output_iterator&& other) {
-    ::new (static_cast<void*>(this)) adapting_output_iterator(std::move(other));
-    return *this;
-  }
-  adapting_output_iterator& operator=(adapting_output_iterator const& other) {
-    ::new (static_cast<void*>(this)) adapting_output_iterator(other);
-    return *this;
-  }
+  Iterator const& base() const { return underlying_; }
 
   adapting_output_iterator& operator++() {
     ++underlying_;
     return *this;
   }
-
   adapting_output_iterator operator++(int) {
     adapting_output_iterator result{*this};
     operator++();
@@ -297,85 +790,350 @@ struct adapting_output_iterator {
   }
 
   class assignment_proxy {
-    using aTraits = std::allocator_traits<Allocator>;
-    Adaptor adaptor_;
-    Iterator underlying_;
-    Allocator allocator_;
+    adapting_output_iterator& owner_;
 
    public:
     template <typename T>
-    typename std::enable_if<Adaptor::template adapts<T>>::type operator=(
-        T&& thing) {
+    typename std::enable_if<Adaptor::template adapts<std::decay_t<T>>,
+                            assignment_proxy&>::type
+    operator=(T&& thing) {
       using result_type = typename Adaptor::target_type;
-      result_type* result = aTraits::allocate(allocator_, 1);
-      adaptor_(result, std::forward<T>(thing));
-      *underlying_ = std::move(result);
-      result->~result_type();
-      aTraits::deallocate(allocator_, result, 1);
+      adaptor_scratch<result_type> result;
+      invoke_adaptor(owner_.adaptor_, &result.value, std::forward<T>(thing));
+      try {
+        *owner_.underlying_ = std::move(result.value);
+      } catch (...) {
+        result.value.~result_type();
+        throw;
+      }
+      result.value.~result_type();
+      return *this;
     }
-    assignment_proxy(Adaptor adaptor, Iterator underlying, Allocator allocator)
-        : adaptor_(adaptor), underlying_(underlying), allocator_(allocator) {}
+    explicit assignment_proxy(adapting_output_iterator& owner)
+        : owner_(owner) {}
   };
 
-  assignment_proxy operator*() { return {adaptor_, underlying_, allocator_}; }
+  assignment_proxy operator*() { return assignment_proxy{*this}; }
 
  private:
   Adaptor adaptor_;
   Iterator underlying_;
-  Allocator allocator_;
 };
+
+// Recognises an adapting range, by copy or by move
+template <typename It>
+struct adapting_range : std::false_type {};
+template <typename Adaptor, typename Iterator>
+struct adapting_range<adapting_input_iterator<Adaptor, Iterator>>
+    : std::true_type {
+  using adaptor_type = Adaptor;
+  using source_type = typename std::iterator_traits<Iterator>::value_type;
+
+  static adapting_input_iterator<Adaptor, Iterator> unwrap(
+      adapting_input_iterator<Adaptor, Iterator> const& it) {
+    return it;
+  }
+};
+template <typename It>
+struct adapting_range<std::move_iterator<It>> : adapting_range<It> {
+  static auto unwrap(std::move_iterator<It> const& it) {
+    return adapting_range<It>::unwrap(it.base());
+  }
+};
+
+// ... whose adaptor has `adapt_n` for its sources
+template <typename It, typename = void>
+struct batch_adapting : std::false_type {};
+template <typename It>
+struct batch_adapting<It, std::enable_if_t<adapting_range<It>::value>>
+    : has_adapt_n<typename adapting_range<It>::adaptor_type,
+                  typename adapting_range<It>::source_type> {};
+
+// ... and has one taking the container's allocator `Alloc`
+template <typename It, typename Alloc, typename = void>
+struct batch_adapting_using_allocator : std::false_type {};
+template <typename It, typename Alloc>
+struct batch_adapting_using_allocator<
+    It,
+    Alloc,
+    std::enable_if_t<adapting_range<It>::value>>
+    : has_adapt_n_using_allocator<typename adapting_range<It>::adaptor_type,
+                                  typename adapting_range<It>::source_type,
+                                  Alloc> {};
+
+// Whether the values of an adapting range must be built with the container's
+// allocator `Alloc`: a default one does as well only if all of them are equal
+template <typename It, typename Alloc>
+inline constexpr bool adapts_using_allocator_v{
+    adapting_range<It>::value &&
+    !std::allocator_traits<Alloc>::is_always_equal::value};
+
+// Hands `consume` the values of [first, last), bound for a container with
+// allocator `alloc`, as ranges of iterators. An adapting range is adapted
+// `kAdaptBatch` at a time into a buffer on the stack, and handed over as move
+// iterators, if its adaptor has `adapt_n` or the values need `alloc`: they
+// are then built with `alloc` by the allocator-extended `adapt_n`, or one at
+// a time by `adapt_using_allocator` without one. `adapt_n` sources are read
+// in place from a pointer range and copied out first from any other. Any
+// other range is handed over whole.
+template <typename It, typename Alloc, typename Consume>
+void for_each_adapted_batch(It first,
+                            It last,
+                            Alloc const& alloc,
+                            Consume&& consume) {
+  constexpr bool kUsesAllocator = adapts_using_allocator_v<It, Alloc>;
+  if constexpr (!batch_adapting<It>::value && !kUsesAllocator) {
+    consume(std::move(first), std::move(last));
+  } else {
+    auto const from = adapting_range<It>::unwrap(first);
+    auto source = from.base();
+    auto const end = adapting_range<It>::unwrap(last).base();
+    auto& adaptor = from.adaptor();
+    using source_iterator = decltype(source);
+    using source_type =
+        typename std::iterator_traits<source_iterator>::value_type;
+    using target_type =
+        typename std::remove_reference_t<decltype(adaptor)>::target_type;
+    scratch_array<target_type, kAdaptBatch> targets;
+    auto consumeTargets = [&](std::size_t count) {
+      try {
+        consume(std::make_move_iterator(targets.values),
+                std::make_move_iterator(targets.values + count));
+      } catch (...) {
+        destroy_n(targets.values, count);
+        throw;
+      }
+      destroy_n(targets.values, count);
+    };
+    auto adaptTargets = [&](source_type const* in, std::size_t count) {
+      if constexpr (kUsesAllocator) {
+        adapt_n(adaptor, targets.values, in, count, alloc);
+      } else {
+        adapt_n(adaptor, targets.values, in, count);
+      }
+    };
+    if constexpr (kUsesAllocator &&
+                  !batch_adapting_using_allocator<It, Alloc>::value) {
+      while (source != end) {
+        std::size_t count = 0;
+        try {
+          for (; count < kAdaptBatch && source != end; ++count, ++source) {
+            adapt_using_allocator(adaptor, targets.values + count, *source,
+                                  alloc);
+          }
+        } catch (...) {
+          destroy_n(targets.values, count);
+          throw;
+        }
+        consumeTargets(count);
+      }
+    } else if constexpr (std::is_pointer_v<source_iterator>) {
+      while (source != end) {
+        auto const count =
+            std::min(static_cast<std::size_t>(end - source), kAdaptBatch);
+        adaptTargets(source, count);
+        source += count;
+        consumeTargets(count);
+      }
+    } else {
+      scratch_array<source_type, kAdaptBatch> sources;
+      while (source != end) {
+        std::size_t count = 0;
+        try {
+          for (; count < kAdaptBatch && source != end; ++count, ++source) {
+            ::new (static_cast<void*>(&sources.values[count]))
+                source_type(*source);
+          }
+          adaptTargets(sources.values, count);
+        } catch (...) {
+          destroy_n(sources.values, count);
+          throw;
+        }
+        destroy_n(sources.values, count);
+        consumeTargets(count);
+      }
+    }
+  }
+}
+
+// Range-inserts into `Container`: before its end if it has a positional
+// range `insert`, as sequences do, otherwise as a set or map would.
+template <typename Container, typename It, typename = void>
+struct has_positional_range_insert : std::false_type {};
+template <typename Container, typename It>
+struct has_positional_range_insert<
+    Container,
+    It,
+    std::void_t<decltype(std::declval<Container&>().insert(
+        std::declval<Container&>().end(),
+        std::declval<It>(),
+        std::declval<It>()))>> : std::true_type {};
+
+template <typename Container, typename It>
+void insert_range(Container& container, It first, It last) {
+  if constexpr (has_positional_range_insert<Container, It>::value) {
+    container.insert(container.end(), first, last);
+  } else {
+    container.insert(first, last);
+  }
+}
 }
 
 /**
- * Return value is an unspecified input iterator. You can usefully use
- * std::make_move_iterator on the parameter iterator and on the returned
- * iterator.
+ * Return value is an unspecified iterator of the same category as the
+ * parameter. You can usefully use std::make_move_iterator on the parameter
+ * iterator and on the returned iterator.
  */
-template <typename Adaptor,
-          typename Iterator,
-          typename Allocator = std::allocator<typename Adaptor::target_type>>
+template <typename Adaptor, typename Iterator>
 typename std::enable_if<
     !std::is_same_v<std::decay_t<typename Adaptor::target_type>,
-                    std::decay_t<typename Iterator::value_type>>,
-    detail::adapting_input_iterator<Adaptor, Iterator, Allocator>>::type
-adapt_input_iterator(Iterator&& iterator, Allocator&& allocator = {}) {
-  return detail::adapting_input_iterator<Adaptor, Iterator, Allocator>{
-      std::forward<Iterator>(iterator), std::forward<Allocator>(allocator)};
+                    typename std::iterator_traits<
+                        std::decay_t<Iterator>>::value_type>,
+    detail::adapting_input_iterator<Adaptor, std::decay_t<Iterator>>>::type
+adapt_input_iterator(Iterator&& iterator, Adaptor adaptor = {}) {
+  return detail::adapting_input_iterator<Adaptor, std::decay_t<Iterator>>{
+      std::move(adaptor), std::forward<Iterator>(iterator)};
 }
 
-template <typename Adaptor, typename Iterator, typename = void>
+template <typename Adaptor, typename Iterator>
 typename std::enable_if<
     std::is_same_v<std::decay_t<typename Adaptor::target_type>,
-                   std::decay_t<typename Iterator::value_type>>,
-    Iterator>::type
-adapt_input_iterator(Iterator&& iterator, ...) {
+                   typename std::iterator_traits<
+                       std::decay_t<Iterator>>::value_type>,
+    std::decay_t<Iterator>>::type
+adapt_input_iterator(Iterator&& iterator, Adaptor = {}) {
   return std::forward<Iterator>(iterator);
 }
 
 /**
  * Return value is an unspecified output iterator.
  */
-template <typename Adaptor,
-          typename Iterator,
-          typename Allocator = std::allocator<typename Adaptor::target_type>>
+template <typename Adaptor, typename Iterator>
 typename std::enable_if<
     !std::is_same_v<std::decay_t<typename Adaptor::target_type>,
-                    std::decay_t<typename Iterator::value_type>>,
-    detail::adapting_output_iterator<Adaptor, Iterator, Allocator>>::type
-adapt_output_iterator(Iterator&& iterator, Allocator&& allocator = {}) {
-  return detail::adapting_output_iterator<Adaptor, Iterator, Allocator>{
-      std::forward<Iterator>(iterator), std::forward<Allocator>(allocator)};
+                    typename std::iterator_traits<
+                        std::decay_t<Iterator>>::value_type>,
+    detail::adapting_output_iterator<Adaptor, std::decay_t<Iterator>>>::type
+adapt_output_iterator(Iterator&& iterator, Adaptor adaptor = {}) {
+  return detail::adapting_output_iterator<Adaptor, std::decay_t<Iterator>>{
+      std::move(adaptor), std::forward<Iterator>(iterator)};
 }
 
-template <typename Adaptor, typename Iterator, typename = void>
+template <typename Adaptor, typename Iterator>
 typename std::enable_if<
     std::is_same_v<std::decay_t<typename Adaptor::target_type>,
-                   std::decay_t<typename Iterator::value_type>>,
-    Iterator>::type
-adapt_output_iterator(Iterator&& iterator, ...) {
+                   typename std::iterator_traits<
+                       std::decay_t<Iterator>>::value_type>,
+    std::decay_t<Iterator>>::type
+adapt_output_iterator(Iterator&& iterator, Adaptor = {}) {
   return std::forward<Iterator>(iterator);
 }
 
+// Adapts values into a fixed buffer of `BatchSize` held in the object
+// itself, and moves each full buffer into `container` with one range
+// `insert`. Nothing is allocated beyond what the container itself does.
+// Values reach the container when the buffer fills, on `flush()` and on
+// destruction; call `flush()` to see any exception the container throws.
+//
+//   proposed::batch_inserter<proposed::string_adaptor, decltype(out)> batch{
+//       out};
+//   std::copy(views.begin(), views.end(), batch.inserter());
+template <typename Adaptor, typename Container, std::size_t BatchSize = 32>
+struct batch_inserter {
+  static_assert(BatchSize > 0, "Batches must hold at least one value");
+  using value_type = typename Adaptor::target_type;
+
+  explicit batch_inserter(Container& container, Adaptor adaptor = {})
+      : container_(container), adaptor_(std::move(adaptor)) {}
+  batch_inserter(batch_inserter const&) = delete;
+  batch_inserter& operator=(batch_inserter const&) = delete;
+  ~batch_inserter() {
+    try {
+      flush();
+    } catch (...) {
+      clear();
+    }
+  }
+
+  template <typename X>
+  typename std::enable_if<Adaptor::template adapts<std::decay_t<X>>>::type
+  push(X&& input) {
+    if (size_ == BatchSize) {
+      flush();
+    }
+    detail::invoke_adaptor(
+        adaptor_, &buffer_.values[size_], std::forward<X>(input));
+    ++size_;
+  }
+
+  void flush() {
+    if (size_ == 0) {
+      return;
+    }
+    try {
+      detail::insert_range(container_,
+                           std::make_move_iterator(buffer_.values),
+                           std::make_move_iterator(buffer_.values + size_));
+    } catch (...) {
+      clear();
+      throw;
+    }
+    clear();
+  }
+
+  // Output iterator pushing each value assigned through it
+  struct iterator {
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    iterator& operator*() { return *this; }
+    iterator& operator++() { return *this; }
+    iterator& operator++(int) { return *this; }
+    template <typename X>
+    typename std::enable_if<Adaptor::template adapts<std::decay_t<X>>,
+                            iterator&>::type
+    operator=(X&& input) {
+      owner_->push(std::forward<X>(input));
+      return *this;
+    }
+
+    batch_inserter* owner_;
+  };
+  iterator inserter() { return iterator{this}; }
+
+ private:
+  void clear() {
+    for (std::size_t i = 0; i < size_; ++i) {
+      buffer_.values[i].~value_type();
+    }
+    size_ = 0;
+  }
+
+  union buffer {
+    buffer() {}
+    ~buffer() {}
+    value_type values[BatchSize];
+  };
+
+  Container& container_;
+  Adaptor adaptor_;
+  std::size_t size_ = 0;
+  buffer buffer_;
+};
+
+namespace detail {
+// Helpers shared by the adaptor-aware containers
+
+template <typename T, typename = void>
+struct is_transparent : std::false_type {};
+template <typename T>
+struct is_transparent<T, std::void_t<typename T::is_transparent>>
+    : std::true_type {};
+}  // namespace detail
+
 // Utility class to check if class T defines an Adaptor type named adaptor_type
 // which can adapt type V.
 template <typename Adaptor>
@@ -404,6 +1162,53 @@ struct adaptor_traits {
  public:
   template <typename T>
   static constexpr bool adapts = testAdaptType<T>(0);
+  // Whether the adaptor has a batch `adapt_n` for sources of type `T`
+  template <typename T>
+  static constexpr bool adapts_n =
+      detail::has_adapt_n<Adaptor, std::decay_t<T>>::value;
 };
 
+namespace detail {
+// Whether a container keyed on `Key` should treat an argument of type
+// `AdaptableType` as something to adapt rather than as a key or an iterator.
+template <typename Key,
+          typename Iterator,
+          typename ConstIterator,
+          typename A,
+          typename AdaptableType>
+inline constexpr bool is_write_adaptable_v{
+    !std::is_same<std::decay_t<Key>, std::decay_t<AdaptableType>>::value &&
+    !std::is_same<std::decay_t<Iterator>, std::decay_t<AdaptableType>>::value &&
+    !std::is_same<std::decay_t<ConstIterator>,
+                  std::decay_t<AdaptableType>>::value &&
+    adaptor_traits<A>::template adapts<AdaptableType>};
+
+// Returns `adaptee` adapted to a `Target` by `adaptor`
+template <typename Target, typename A, typename AdaptableType>
+Target adapt_to(A& adaptor, AdaptableType&& adaptee) {
+  // Hack to avoid calling the default constructor
+  union X {
+    X() : x(0) {}
+    ~X() noexcept {}
+    char x;
+    Target result;
+  } x;
+  invoke_adaptor(adaptor, &x.result, std::forward<AdaptableType>(adaptee));
+  Target result{std::move(x.result)};
+  x.result.~Target();
+  return result;
+}
+
+// As above, building the result with `alloc` where the adaptor can
+template <typename Target, typename A, typename AdaptableType, typename Alloc>
+Target adapt_to(A& adaptor, AdaptableType&& adaptee, Alloc const& alloc) {
+  adaptor_scratch<Target> x;
+  adapt_using_allocator(
+      adaptor, &x.value, std::forward<AdaptableType>(adaptee), alloc);
+  Target result{std::move(x.value)};
+  x.value.~Target();
+  return result;
+}
+}  // namespace detail
+
 }  // namespace proposed
@@ -0,0 +1,91 @@
+#include <proposed/adaptor>
+#include <proposed/string>
+#include <proposed/unordered_set>
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Filling a container from a range of `string_view`s through
+// adapt_input_iterator, against filling it from a range of the
+// `std::string`s themselves.
+
+namespace {
+using SetType = proposed::unordered_set<std::string,
+                                        proposed::transparent_string_hash,
+                                        proposed::transparent_string_equal>;
+
+std::vector<std::string> const& strings(std::size_t count) {
+  static std::vector<std::string> result;
+  if (result.size() != count) {
+    result.clear();
+    char buffer[40];
+    for (std::size_t i = 0; i < count; ++i) {
+      std::snprintf(buffer, sizeof(buffer), "a-longish-key-%012zu", i);
+      result.emplace_back(buffer);
+    }
+  }
+  return result;
+}
+
+std::vector<std::string_view> views(std::size_t count) {
+  auto const& source = strings(count);
+  return {source.begin(), source.end()};
+}
+
+template <typename Iterator>
+auto adapted(Iterator iterator) {
+  return std::make_move_iterator(
+      proposed::adapt_input_iterator<proposed::string_adaptor>(iterator));
+}
+
+void BM_VectorFromStrings(benchmark::State& state) {
+  auto const& input = strings(state.range(0));
+  for (auto _ : state) {
+    std::vector<std::string> result(input.begin(), input.end());
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_VectorFromAdaptedViews(benchmark::State& state) {
+  auto const input = views(state.range(0));
+  for (auto _ : state) {
+    std::vector<std::string> result(adapted(input.begin()),
+                                    adapted(input.end()));
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SetFromStrings(benchmark::State& state) {
+  auto const& input = strings(state.range(0));
+  for (auto _ : state) {
+    SetType result(input.begin(), input.end());
+    benchmark::DoNotOptimize(&result);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SetFromAdaptedViews(benchmark::State& state) {
+  auto const input = views(state.range(0));
+  for (auto _ : state) {
+    SetType result(adapted(input.begin()), adapted(input.end()));
+    benchmark::DoNotOptimize(&result);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void counts(benchmark::internal::Benchmark* b) {
+  b->Arg(1 << 10)->Arg(1 << 16);
+}
+}  // namespace
+
+BENCHMARK(BM_VectorFromStrings)->Apply(counts);
+BENCHMARK(BM_VectorFromAdaptedViews)->Apply(counts);
+BENCHMARK(BM_SetFromStrings)->Apply(counts);
+BENCHMARK(BM_SetFromAdaptedViews)->Apply(counts);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,114 @@
+#include <proposed/adaptor>
+#include <proposed/flat_multiset>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+// Range-inserting through an adaptor whose conversion lives out of line (as
+// a library call would): one value at a time through adapt_input_iterator,
+// as before adapt_n, and a batch at a time through its adapt_n. Each is also
+// tried as the first link of a chain.
+
+namespace {
+// Fixed-point (1/1024ths) to double, one call per value or per batch
+[[gnu::noinline]] double fromFixed(std::int32_t value) {
+  return value / 1024.0;
+}
+[[gnu::noinline]] void fromFixed(double* out,
+                                 std::int32_t const* in,
+                                 std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = in[i] / 1024.0;
+  }
+}
+
+struct scalar_fixed_adaptor {
+  using target_type = double;
+  template <typename X>
+  static bool constexpr adapts{
+      std::is_same_v<std::decay_t<X>, std::int32_t>};
+
+  void operator()(target_type* pResult, std::int32_t input) {
+    ::new (static_cast<void*>(pResult)) target_type(fromFixed(input));
+  }
+};
+
+struct batch_fixed_adaptor : scalar_fixed_adaptor {
+  void adapt_n(target_type* out, std::int32_t const* in, std::size_t n) {
+    fromFixed(out, in, n);
+  }
+};
+
+template <typename First>
+using rounding_chain =
+    proposed::chain_adaptor<First, proposed::constructible_adaptor<float>>;
+
+std::vector<std::int32_t> makeInput(std::size_t count) {
+  std::vector<std::int32_t> result(count);
+  std::iota(result.begin(), result.end(), 0);
+  return result;
+}
+
+template <typename Adaptor>
+void intoVector(benchmark::State& state) {
+  auto const input = makeInput(state.range(0));
+  std::vector<typename Adaptor::target_type> out;
+  out.reserve(input.size());
+  for (auto _ : state) {
+    out.clear();
+    proposed::detail::for_each_adapted_batch(
+        proposed::adapt_input_iterator<Adaptor>(input.data()),
+        proposed::adapt_input_iterator<Adaptor>(input.data() + input.size()),
+        out.get_allocator(), [&](auto from, auto to) { out.insert(out.end(), from, to); });
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+template <typename Adaptor>
+void intoFlatMultiset(benchmark::State& state) {
+  auto const input = makeInput(state.range(0));
+  for (auto _ : state) {
+    proposed::flat_multiset<typename Adaptor::target_type> out;
+    out.reserve(input.size());
+    out.insert(
+        proposed::adapt_input_iterator<Adaptor>(input.data()),
+        proposed::adapt_input_iterator<Adaptor>(input.data() + input.size()));
+    benchmark::DoNotOptimize(out.size());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void BM_VectorScalar(benchmark::State& state) {
+  intoVector<scalar_fixed_adaptor>(state);
+}
+void BM_VectorBatch(benchmark::State& state) {
+  intoVector<batch_fixed_adaptor>(state);
+}
+void BM_VectorChainScalar(benchmark::State& state) {
+  intoVector<rounding_chain<scalar_fixed_adaptor>>(state);
+}
+void BM_VectorChainBatch(benchmark::State& state) {
+  intoVector<rounding_chain<batch_fixed_adaptor>>(state);
+}
+void BM_FlatMultisetScalar(benchmark::State& state) {
+  intoFlatMultiset<scalar_fixed_adaptor>(state);
+}
+void BM_FlatMultisetBatch(benchmark::State& state) {
+  intoFlatMultiset<batch_fixed_adaptor>(state);
+}
+
+void counts(benchmark::internal::Benchmark* b) {
+  b->Arg(1 << 10)->Arg(1 << 16);
+}
+}  // namespace
+
+BENCHMARK(BM_VectorScalar)->Apply(counts);
+BENCHMARK(BM_VectorBatch)->Apply(counts);
+BENCHMARK(BM_VectorChainScalar)->Apply(counts);
+BENCHMARK(BM_VectorChainBatch)->Apply(counts);
+BENCHMARK(BM_FlatMultisetScalar)->Apply(counts);
+BENCHMARK(BM_FlatMultisetBatch)->Apply(counts);
+
+BENCHMARK_MAIN();
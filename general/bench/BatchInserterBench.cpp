@@ -0,0 +1,110 @@
+#include <proposed/adaptor>
+#include <proposed/string>
+#include <proposed/unordered_set>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Streaming converted values into containers: a push loop, std::copy
+// through adapt_output_iterator, and std::copy through a batch_inserter.
+
+namespace {
+using SetType = proposed::unordered_set<std::string,
+                                        proposed::transparent_string_hash,
+                                        proposed::transparent_string_equal,
+                                        std::allocator<std::string>,
+                                        proposed::string_adaptor>;
+
+std::vector<std::string> const& strings() {
+  static auto const result = [] {
+    std::vector<std::string> keys;
+    char buffer[40];
+    for (std::size_t i = 0; i < 1 << 16; ++i) {
+      std::snprintf(buffer, sizeof(buffer), "a-longish-key-%012zu", i);
+      keys.emplace_back(buffer);
+    }
+    return keys;
+  }();
+  return result;
+}
+
+std::vector<std::string_view> views() {
+  return {strings().begin(), strings().end()};
+}
+
+void BM_VectorEmplaceLoop(benchmark::State& state) {
+  auto const input = views();
+  for (auto _ : state) {
+    std::vector<std::string> out;
+    for (auto view : input) {
+      out.emplace_back(view);
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void BM_VectorAdaptOutputIterator(benchmark::State& state) {
+  auto const input = views();
+  for (auto _ : state) {
+    std::vector<std::string> out;
+    std::copy(input.begin(), input.end(),
+              proposed::adapt_output_iterator<proposed::string_adaptor>(
+                  std::back_inserter(out)));
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void BM_VectorBatchInserter(benchmark::State& state) {
+  auto const input = views();
+  for (auto _ : state) {
+    std::vector<std::string> out;
+    {
+      proposed::batch_inserter<proposed::string_adaptor, decltype(out)> batch{
+          out};
+      std::copy(input.begin(), input.end(), batch.inserter());
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void BM_SetInsertLoop(benchmark::State& state) {
+  auto const input = views();
+  for (auto _ : state) {
+    SetType out;
+    for (auto view : input) {
+      out.insert(view);
+    }
+    benchmark::DoNotOptimize(&out);
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void BM_SetBatchInserter(benchmark::State& state) {
+  auto const input = views();
+  for (auto _ : state) {
+    SetType out;
+    {
+      proposed::batch_inserter<proposed::string_adaptor, SetType, 256> batch{
+          out};
+      std::copy(input.begin(), input.end(), batch.inserter());
+    }
+    benchmark::DoNotOptimize(&out);
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+}  // namespace
+
+BENCHMARK(BM_VectorEmplaceLoop);
+BENCHMARK(BM_VectorAdaptOutputIterator);
+BENCHMARK(BM_VectorBatchInserter);
+BENCHMARK(BM_SetInsertLoop);
+BENCHMARK(BM_SetBatchInserter);
+
+BENCHMARK_MAIN();
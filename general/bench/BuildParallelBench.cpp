@@ -0,0 +1,85 @@
+#include <proposed/build_parallel>
+#include <proposed/flat_set>
+#include <proposed/set>
+#include <proposed/string>
+#include <proposed/unordered_set>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Building containers of strings from string_view tokens, a quarter of them
+// distinct: serially through the range constructor, and with build_parallel
+// on 1 to 64 threads. Run on a machine with at least as many cores as the
+// largest thread count; past that the threads only take turns.
+
+namespace {
+std::vector<std::string> makeTokens(std::size_t count) {
+  std::vector<std::string> result;
+  result.reserve(count);
+  std::uint64_t seed = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    result.push_back("token-" + std::to_string((seed >> 33) % (count / 4)) +
+                     "-of-a-longer-line");
+  }
+  return result;
+}
+
+using hash_set = proposed::unordered_set<std::string,
+                                         proposed::transparent_string_hash,
+                                         proposed::transparent_string_equal,
+                                         std::allocator<std::string>,
+                                         proposed::string_adaptor>;
+using ordered_set = proposed::set<std::string,
+                                  std::less<>,
+                                  std::allocator<std::string>,
+                                  proposed::string_adaptor>;
+using flat_set = proposed::flat_set<std::string,
+                                    std::less<>,
+                                    std::allocator<std::string>,
+                                    proposed::string_adaptor>;
+
+template <typename Container>
+void BM_Serial(benchmark::State& state) {
+  auto const tokens = makeTokens(state.range(0));
+  std::vector<std::string_view> const views(tokens.begin(), tokens.end());
+  for (auto _ : state) {
+    Container result(views.begin(), views.end());
+    benchmark::DoNotOptimize(result.size());
+  }
+  state.SetItemsProcessed(state.iterations() * views.size());
+}
+
+template <typename Container>
+void BM_Parallel(benchmark::State& state) {
+  auto const tokens = makeTokens(state.range(0));
+  std::vector<std::string_view> const views(tokens.begin(), tokens.end());
+  proposed::execution::parallel_policy const policy{
+      static_cast<std::size_t>(state.range(1))};
+  for (auto _ : state) {
+    auto result =
+        proposed::build_parallel<Container>(policy, views.begin(), views.end());
+    benchmark::DoNotOptimize(result.size());
+  }
+  state.SetItemsProcessed(state.iterations() * views.size());
+}
+
+void threads(benchmark::internal::Benchmark* b) {
+  for (int threads = 1; threads <= 64; threads *= 2) {
+    b->Args({1 << 20, threads});
+  }
+  b->UseRealTime();
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Serial, hash_set)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Parallel, hash_set)->Apply(threads);
+BENCHMARK_TEMPLATE(BM_Serial, ordered_set)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Parallel, ordered_set)->Apply(threads);
+BENCHMARK_TEMPLATE(BM_Serial, flat_set)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Parallel, flat_set)->Apply(threads);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,117 @@
+#include <proposed/caching_adaptor>
+#include <proposed/map>
+#include <benchmark/benchmark.h>
+#include <cctype>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// An expensive adaptor (canonicalising URL-ish paths) called directly and
+// through caching_adaptor, over working sets smaller than, equal to and
+// larger than the cache, and keying a map that churns the same keys.
+
+namespace {
+// Lower-cases, collapses repeated slashes and drops a trailing slash
+struct canonical_path_adaptor {
+  using target_type = std::string;
+  template <typename X>
+  static bool constexpr adapts{std::is_same_v<X, std::string_view>};
+
+  void operator()(target_type* pResult, std::string_view input) {
+    auto* result = ::new (static_cast<void*>(pResult)) target_type();
+    result->reserve(input.size());
+    for (auto c : input) {
+      if (c == '/' && !result->empty() && result->back() == '/') {
+        continue;
+      }
+      result->push_back(
+          static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+    }
+    if (result->size() > 1 && result->back() == '/') {
+      result->pop_back();
+    }
+  }
+};
+
+using cached_adaptor = proposed::caching_adaptor<canonical_path_adaptor>;
+
+std::vector<std::string> makeSources(std::size_t count) {
+  std::vector<std::string> result;
+  char buffer[80];
+  for (std::size_t i = 0; i < count; ++i) {
+    std::snprintf(buffer, sizeof(buffer),
+                  "/Some//Longish/Path/To//A/Resource/Number-%012zu/", i);
+    result.emplace_back(buffer);
+  }
+  return result;
+}
+
+template <typename Adaptor>
+void adaptAll(benchmark::State& state, Adaptor& adaptor) {
+  auto const sources = makeSources(state.range(0));
+  std::size_t next = 0;
+  for (auto _ : state) {
+    proposed::detail::adaptor_scratch<std::string> scratch;
+    adaptor(&scratch.value, std::string_view{sources[next]});
+    benchmark::DoNotOptimize(scratch.value.data());
+    scratch.value.~basic_string();
+    next = next + 1 == sources.size() ? 0 : next + 1;
+  }
+}
+
+void BM_Direct(benchmark::State& state) {
+  canonical_path_adaptor adaptor;
+  adaptAll(state, adaptor);
+}
+
+void BM_Cached(benchmark::State& state) {
+  cached_adaptor adaptor;
+  adaptAll(state, adaptor);
+  state.counters["hit_rate"] = adaptor.hit_rate();
+}
+
+template <typename Adaptor>
+void churnMap(benchmark::State& state) {
+  proposed::map<std::string,
+                int,
+                std::less<>,
+                std::allocator<std::pair<const std::string, int>>,
+                Adaptor>
+      map;
+  auto const sources = makeSources(state.range(0));
+  canonical_path_adaptor canonicalise;
+  std::vector<std::string> canonical;
+  for (auto const& source : sources) {
+    canonical.push_back(proposed::detail::adapt_to<std::string>(
+        canonicalise, std::string_view{source}));
+  }
+  for (auto _ : state) {
+    for (auto const& source : sources) {
+      map.try_emplace(std::string_view{source}, 1);
+    }
+    for (auto const& key : canonical) {
+      map.erase(key);
+    }
+  }
+}
+
+void BM_MapDirect(benchmark::State& state) {
+  churnMap<canonical_path_adaptor>(state);
+}
+
+void BM_MapCached(benchmark::State& state) {
+  churnMap<cached_adaptor>(state);
+}
+
+void workingSets(benchmark::internal::Benchmark* b) {
+  b->Arg(16)->Arg(64)->Arg(256);
+}
+}  // namespace
+
+BENCHMARK(BM_Direct)->Apply(workingSets);
+BENCHMARK(BM_Cached)->Apply(workingSets);
+BENCHMARK(BM_MapDirect)->Apply(workingSets);
+BENCHMARK(BM_MapCached)->Apply(workingSets);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,59 @@
+#include <proposed/adaptor>
+#include <proposed/string>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// Adapting a `char const*` to a `std::string` directly, through a
+// `string_view` with chain_adaptor, and through a heap-allocated
+// intermediate as chain_adaptor used to.
+
+namespace {
+using direct_adaptor = proposed::constructible_adaptor<std::string>;
+using chained_adaptor =
+    proposed::chain_adaptor<proposed::constructible_adaptor<std::string_view>,
+                            proposed::string_adaptor>;
+
+struct heap_chained_adaptor {
+  using target_type = std::string;
+  template <typename X>
+  static bool constexpr adapts{std::is_convertible_v<X, std::string_view>};
+
+  void operator()(target_type* pResult, char const* input) {
+    using traits = std::allocator_traits<std::allocator<std::string_view>>;
+    auto* pIntermediate = traits::allocate(allocator_, 1);
+    first_(pIntermediate, input);
+    second_(pResult, std::move(*pIntermediate));
+    traits::deallocate(allocator_, pIntermediate, 1);
+  }
+
+  proposed::constructible_adaptor<std::string_view> first_;
+  proposed::string_adaptor second_;
+  std::allocator<std::string_view> allocator_;
+};
+
+template <typename Adaptor>
+void BM_Adapt(benchmark::State& state) {
+  std::string const input(state.range(0), 'x');
+  char const* cString = input.c_str();
+  Adaptor adaptor;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cString);
+    proposed::detail::adaptor_scratch<std::string> scratch;
+    adaptor(&scratch.value, cString);
+    benchmark::DoNotOptimize(scratch.value.data());
+    scratch.value.~basic_string();
+  }
+}
+
+void lengths(benchmark::internal::Benchmark* b) {
+  b->Arg(8)->Arg(64);
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Adapt, direct_adaptor)->Apply(lengths);
+BENCHMARK_TEMPLATE(BM_Adapt, chained_adaptor)->Apply(lengths);
+BENCHMARK_TEMPLATE(BM_Adapt, heap_chained_adaptor)->Apply(lengths);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,181 @@
+#include <proposed/from_chars>
+#include <proposed/map>
+#include <proposed/set>
+#include <benchmark/benchmark.h>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Parsing numeric keys from text: std::stoll/std::strtod on a std::string
+// copy, as call sites do today, against from_chars_adaptor alone, through
+// a range insert in batches, and keying a map on the fly.
+
+namespace {
+// Fixed-width, zero-padded ids, as found in logs and CSV exports
+std::vector<std::string> makeIds(std::size_t count, int width) {
+  std::vector<std::string> result;
+  char buffer[32];
+  std::uint64_t id = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    id = id * 6364136223846793005ull + 1442695040888963407ull;
+    std::snprintf(buffer, sizeof(buffer), "%0*llu", width,
+                  static_cast<unsigned long long>(
+                      id % (width >= 16 ? 10000000000000000ull : 100000000)));
+    result.emplace_back(buffer);
+  }
+  return result;
+}
+
+std::vector<std::string> makeDoubles(std::size_t count) {
+  std::vector<std::string> result;
+  char buffer[32];
+  for (std::size_t i = 0; i < count; ++i) {
+    std::snprintf(buffer, sizeof(buffer), "%.6f", i * 0.37);
+    result.emplace_back(buffer);
+  }
+  return result;
+}
+
+void BM_Stoll(benchmark::State& state) {
+  auto const text = makeIds(1024, state.range(0));
+  for (auto _ : state) {
+    for (auto const& id : text) {
+      std::string_view const view{id};
+      benchmark::DoNotOptimize(std::stoll(std::string{view}));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * text.size());
+}
+
+void BM_Adaptor(benchmark::State& state) {
+  auto const text = makeIds(1024, state.range(0));
+  proposed::decimal_adaptor<std::int64_t> adaptor;
+  for (auto _ : state) {
+    for (auto const& id : text) {
+      benchmark::DoNotOptimize(proposed::detail::adapt_to<std::int64_t>(
+          adaptor, std::string_view{id}));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * text.size());
+}
+
+void BM_FromChars(benchmark::State& state) {
+  auto const text = makeIds(1024, state.range(0));
+  for (auto _ : state) {
+    for (auto const& id : text) {
+      std::int64_t value;
+      std::from_chars(id.data(), id.data() + id.size(), value);
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * text.size());
+}
+
+void BM_Strtod(benchmark::State& state) {
+  auto const text = makeDoubles(1024);
+  for (auto _ : state) {
+    for (auto const& number : text) {
+      std::string_view const view{number};
+      benchmark::DoNotOptimize(
+          std::strtod(std::string{view}.c_str(), nullptr));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * text.size());
+}
+
+void BM_AdaptorDouble(benchmark::State& state) {
+  auto const text = makeDoubles(1024);
+  proposed::decimal_adaptor<double> adaptor;
+  for (auto _ : state) {
+    for (auto const& number : text) {
+      benchmark::DoNotOptimize(proposed::detail::adapt_to<double>(
+          adaptor, std::string_view{number}));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * text.size());
+}
+
+using id_set = proposed::set<std::int64_t,
+                             proposed::from_chars_less<std::int64_t>,
+                             std::allocator<std::int64_t>,
+                             proposed::decimal_adaptor<std::int64_t>>;
+
+void BM_SetStollLoad(benchmark::State& state) {
+  auto const text = makeIds(state.range(0), 16);
+  for (auto _ : state) {
+    id_set ids;
+    for (auto const& id : text) {
+      ids.insert(std::stoll(id));
+    }
+    benchmark::DoNotOptimize(ids.size());
+  }
+  state.SetItemsProcessed(state.iterations() * text.size());
+}
+
+void BM_SetBatchLoad(benchmark::State& state) {
+  auto const text = makeIds(state.range(0), 16);
+  using adaptor = proposed::decimal_adaptor<std::int64_t>;
+  for (auto _ : state) {
+    id_set ids;
+    ids.insert(proposed::adapt_input_iterator<adaptor>(text.data()),
+               proposed::adapt_input_iterator<adaptor>(text.data() +
+                                                       text.size()));
+    benchmark::DoNotOptimize(ids.size());
+  }
+  state.SetItemsProcessed(state.iterations() * text.size());
+}
+
+using id_map = proposed::map<std::int64_t,
+                             int,
+                             proposed::from_chars_less<std::int64_t>,
+                             std::allocator<std::pair<const std::int64_t, int>>,
+                             proposed::decimal_adaptor<std::int64_t>>;
+
+void BM_MapStollTryEmplace(benchmark::State& state) {
+  auto const text = makeIds(state.range(0), 16);
+  for (auto _ : state) {
+    id_map ids;
+    for (auto const& id : text) {
+      std::string_view const view{id};
+      ids.try_emplace(std::stoll(std::string{view}), 1);
+    }
+    benchmark::DoNotOptimize(ids.size());
+  }
+  state.SetItemsProcessed(state.iterations() * text.size());
+}
+
+void BM_MapAdaptedTryEmplace(benchmark::State& state) {
+  auto const text = makeIds(state.range(0), 16);
+  for (auto _ : state) {
+    id_map ids;
+    for (auto const& id : text) {
+      ids.try_emplace(std::string_view{id}, 1);
+    }
+    benchmark::DoNotOptimize(ids.size());
+  }
+  state.SetItemsProcessed(state.iterations() * text.size());
+}
+
+void widths(benchmark::internal::Benchmark* b) {
+  b->Arg(8)->Arg(16);
+}
+void counts(benchmark::internal::Benchmark* b) {
+  b->Arg(1 << 10)->Arg(1 << 16);
+}
+}  // namespace
+
+BENCHMARK(BM_Stoll)->Apply(widths);
+BENCHMARK(BM_FromChars)->Apply(widths);
+BENCHMARK(BM_Adaptor)->Apply(widths);
+BENCHMARK(BM_Strtod);
+BENCHMARK(BM_AdaptorDouble);
+BENCHMARK(BM_SetStollLoad)->Apply(counts);
+BENCHMARK(BM_SetBatchLoad)->Apply(counts);
+BENCHMARK(BM_MapStollTryEmplace)->Apply(counts);
+BENCHMARK(BM_MapAdaptedTryEmplace)->Apply(counts);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,36 @@
+#include <proposed/string>
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <random>
+
+namespace {
+std::string makeKey(std::size_t length) {
+  std::mt19937 rng{length};
+  std::uniform_int_distribution<int> chars{'a', 'z'};
+  std::string result(length, '\0');
+  for (auto& c : result) {
+    c = static_cast<char>(chars(rng));
+  }
+  return result;
+}
+
+template <typename Hash>
+void BM_HashStringView(benchmark::State& state) {
+  auto const key = makeKey(state.range(0));
+  std::string_view const view{key};
+  Hash hash{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hash(view));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_HashStringView, std::hash<std::string_view>)
+    ->RangeMultiplier(2)
+    ->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_HashStringView, proposed::transparent_string_hash)
+    ->RangeMultiplier(2)
+    ->Range(8, 4096);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+#include <proposed/adaptor>
+#include <proposed/string>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// union_adaptor dispatch: an adaptor called directly against the same
+// adaptor reached through a union, and the first-listed adaptor that
+// accepts a source against the cheapest one.
+
+namespace {
+struct copying_string_adaptor {
+  using target_type = std::string;
+  template <typename X>
+  static bool constexpr adapts{std::is_same_v<X, std::string>};
+  template <typename X>
+  static proposed::adaptation_cost constexpr cost{
+      proposed::adaptation_cost::copies};
+
+  void operator()(target_type* pResult, std::string const& input) {
+    ::new (static_cast<void*>(pResult)) target_type(input);
+  }
+};
+
+using wide_union =
+    proposed::union_adaptor<proposed::string_adaptor,
+                            copying_string_adaptor,
+                            proposed::constructible_adaptor<std::string>>;
+
+template <typename Adaptor, typename X>
+void adaptInto(Adaptor& adaptor, X&& input) {
+  proposed::detail::adaptor_scratch<std::string> scratch;
+  adaptor(&scratch.value, std::forward<X>(input));
+  benchmark::DoNotOptimize(scratch.value.data());
+  scratch.value.~basic_string();
+}
+
+void BM_DirectFromView(benchmark::State& state) {
+  proposed::string_adaptor adaptor;
+  std::string const source(state.range(0), 'x');
+  for (auto _ : state) {
+    adaptInto(adaptor, std::string_view{source});
+  }
+}
+
+void BM_UnionFromView(benchmark::State& state) {
+  wide_union adaptor;
+  std::string const source(state.range(0), 'x');
+  for (auto _ : state) {
+    adaptInto(adaptor, std::string_view{source});
+  }
+}
+
+// What picking the first adaptor that accepts a `std::string` did
+void BM_FirstFromTemporary(benchmark::State& state) {
+  copying_string_adaptor adaptor;
+  for (auto _ : state) {
+    adaptInto(adaptor, std::string(state.range(0), 'x'));
+  }
+}
+
+void BM_UnionFromTemporary(benchmark::State& state) {
+  wide_union adaptor;
+  for (auto _ : state) {
+    adaptInto(adaptor, std::string(state.range(0), 'x'));
+  }
+}
+
+void lengths(benchmark::internal::Benchmark* b) {
+  b->Arg(8)->Arg(64)->Arg(1024);
+}
+}  // namespace
+
+BENCHMARK(BM_DirectFromView)->Apply(lengths);
+BENCHMARK(BM_UnionFromView)->Apply(lengths);
+BENCHMARK(BM_FirstFromTemporary)->Apply(lengths);
+BENCHMARK(BM_UnionFromTemporary)->Apply(lengths);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,106 @@
+#include <proposed/utf>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <string_view>
+
+// Transcoding throughput, in bytes of input per second, for ASCII and for
+// mixed text (Cyrillic words among ASCII punctuation and digits), through
+// the adaptors and through the same decode/encode loop without the
+// block-at-a-time fast path.
+
+namespace {
+std::u32string makeText(std::size_t count, bool ascii) {
+  static constexpr char32_t kAscii[] = U"The quick brown fox, 1234. ";
+  static constexpr char32_t kMixed[] = U"Съешь же ещё этих булок, 1234. ";
+  std::u32string_view const sample = ascii ? kAscii : kMixed;
+  std::u32string result;
+  while (result.size() < count) {
+    result += sample;
+  }
+  result.resize(count);
+  return result;
+}
+
+template <typename CharT>
+std::basic_string<CharT> encodeText(std::size_t count, bool ascii) {
+  auto const text = makeText(count, ascii);
+  std::basic_string<CharT> result(
+      proposed::detail::utf_length<CharT>(text.data(), text.size()), CharT{});
+  proposed::detail::transcode_utf(result.data(), text.data(), text.size());
+  return result;
+}
+
+template <typename Adaptor, typename From>
+void adaptorThroughput(benchmark::State& state, bool ascii) {
+  auto const input = encodeText<From>(state.range(0), ascii);
+  std::basic_string_view<From> const view{input};
+  Adaptor adaptor;
+  for (auto _ : state) {
+    auto output =
+        proposed::detail::adapt_to<typename Adaptor::target_type>(adaptor,
+                                                                  view);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size() * sizeof(From));
+}
+
+template <typename To, typename From>
+void scalarThroughput(benchmark::State& state, bool ascii) {
+  auto const input = encodeText<From>(state.range(0), ascii);
+  for (auto _ : state) {
+    std::basic_string<To> output(
+        proposed::detail::utf_length<To>(input.data(), input.size()), To{});
+    auto* out = output.data();
+    for (std::size_t i = 0; i < input.size();) {
+      out = proposed::detail::encode_utf(
+          out, proposed::detail::decode_utf(input.data(), input.size(), i));
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size() * sizeof(From));
+}
+
+void BM_Utf8To16(benchmark::State& state, bool ascii) {
+  adaptorThroughput<proposed::utf16_adaptor, char>(state, ascii);
+}
+void BM_Utf8To16Scalar(benchmark::State& state, bool ascii) {
+  scalarThroughput<char16_t, char>(state, ascii);
+}
+void BM_Utf8To32(benchmark::State& state, bool ascii) {
+  adaptorThroughput<proposed::utf32_adaptor, char>(state, ascii);
+}
+void BM_Utf8To32Scalar(benchmark::State& state, bool ascii) {
+  scalarThroughput<char32_t, char>(state, ascii);
+}
+void BM_Utf16To8(benchmark::State& state, bool ascii) {
+  adaptorThroughput<proposed::utf8_adaptor, char16_t>(state, ascii);
+}
+void BM_Utf16To8Scalar(benchmark::State& state, bool ascii) {
+  scalarThroughput<char, char16_t>(state, ascii);
+}
+void BM_Utf32To8(benchmark::State& state, bool ascii) {
+  adaptorThroughput<proposed::utf8_adaptor, char32_t>(state, ascii);
+}
+void BM_Utf32To8Scalar(benchmark::State& state, bool ascii) {
+  scalarThroughput<char, char32_t>(state, ascii);
+}
+
+void lengths(benchmark::internal::Benchmark* b) {
+  b->Arg(64)->Arg(64 << 10);
+}
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_Utf8To16, ascii, true)->Apply(lengths);
+BENCHMARK_CAPTURE(BM_Utf8To16Scalar, ascii, true)->Apply(lengths);
+BENCHMARK_CAPTURE(BM_Utf8To16, mixed, false)->Apply(lengths);
+BENCHMARK_CAPTURE(BM_Utf8To16Scalar, mixed, false)->Apply(lengths);
+BENCHMARK_CAPTURE(BM_Utf8To32, ascii, true)->Apply(lengths);
+BENCHMARK_CAPTURE(BM_Utf8To32Scalar, ascii, true)->Apply(lengths);
+BENCHMARK_CAPTURE(BM_Utf16To8, ascii, true)->Apply(lengths);
+BENCHMARK_CAPTURE(BM_Utf16To8Scalar, ascii, true)->Apply(lengths);
+BENCHMARK_CAPTURE(BM_Utf16To8, mixed, false)->Apply(lengths);
+BENCHMARK_CAPTURE(BM_Utf16To8Scalar, mixed, false)->Apply(lengths);
+BENCHMARK_CAPTURE(BM_Utf32To8, ascii, true)->Apply(lengths);
+BENCHMARK_CAPTURE(BM_Utf32To8Scalar, ascii, true)->Apply(lengths);
+
+BENCHMARK_MAIN();
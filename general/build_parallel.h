@@ -0,0 +1,450 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <proposed/adaptor>
+
+namespace proposed {
+namespace execution {
+// How many threads `build_parallel` may use: `par` for one per hardware
+// thread, `seq` for just the caller's, or `parallel_policy{n}` for `n`.
+// These stand in for the `std::execution` policies, which libstdc++ only
+// runs in parallel when linked with TBB.
+struct parallel_policy {
+  // Zero means one per hardware thread
+  std::size_t threads{0};
+};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_policy seq{1};
+}  // namespace execution
+
+template <class Key, class Hash, class KeyEqual, class Allocator, class Adaptor>
+struct unordered_set;
+
+namespace detail {
+// The fewest sources worth giving a thread of their own; fewer than this
+// and starting the thread costs more than it saves
+inline constexpr std::size_t kParallelGrain = 2048;
+
+inline std::size_t parallel_workers(execution::parallel_policy policy,
+                                    std::size_t count) {
+  auto threads = policy.threads;
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  return std::max<std::size_t>(
+      1, std::min(threads, count / kParallelGrain));
+}
+
+// Runs `task(i)` for every `i` in [0, count): each on a thread of its own,
+// with the caller's thread taking `task(0)` and any that can't be started.
+// Once all are done, rethrows the first exception (by `i`) any of them threw.
+template <typename Task>
+void run_parallel(std::size_t count, Task&& task) {
+  std::vector<std::exception_ptr> errors(count);
+  auto guarded = [&](std::size_t i) {
+    try {
+      task(i);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  std::size_t started = 1;
+  try {
+    threads.reserve(count);
+    for (; started < count; ++started) {
+      threads.emplace_back(guarded, started);
+    }
+  } catch (std::system_error const&) {
+  } catch (std::bad_alloc const&) {
+  }
+  guarded(0);
+  for (auto i = started; i < count; ++i) {
+    guarded(i);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+// The first of `count` sources that worker `worker` of `workers` takes
+inline std::size_t partition_begin(std::size_t count,
+                                   std::size_t worker,
+                                   std::size_t workers) {
+  return count / workers * worker + std::min(worker, count % workers);
+}
+
+// The first of `Args` that is an adaptor
+template <typename... Args>
+struct first_adaptor {
+  using type = no_adaptor;
+};
+template <typename Arg, typename... Args>
+struct first_adaptor<Arg, Args...> {
+  using type = std::conditional_t<adaptor_traits<Arg>::is_adaptor,
+                                  Arg,
+                                  typename first_adaptor<Args...>::type>;
+};
+
+// The key adaptor a container was declared with: its first template argument
+// that is an adaptor, as it is for all the proposed containers (maps declare
+// their value adaptor after it)
+template <typename Container>
+struct container_adaptor {
+  using type = no_adaptor;
+};
+template <template <typename...> class Container, typename... Args>
+struct container_adaptor<Container<Args...>> {
+  using type = typename first_adaptor<Args...>::type;
+};
+template <typename Container>
+using container_adaptor_t = typename container_adaptor<Container>::type;
+
+// Builds a `Container` from `[first, last)` using `workers` threads. This,
+// for containers with nothing better, builds it on the caller's thread.
+// Containers that can do better specialise it.
+template <typename Container, typename = void>
+struct parallel_builder {
+  template <typename RandomIt, typename... Args>
+  static Container build(std::size_t,
+                         RandomIt first,
+                         RandomIt last,
+                         Args&&... args) {
+    return Container(first, last, std::forward<Args>(args)...);
+  }
+};
+
+// The comparison `Container(first, last, args...)` is built with: the first
+// of `args` that is one, or else a default-constructed one
+template <typename Compare>
+Compare compare_from() {
+  return Compare();
+}
+template <typename Compare, typename Arg, typename... Args>
+Compare compare_from(Arg const& arg, Args const&... args) {
+  if constexpr (std::is_convertible_v<Arg const&, Compare>) {
+    return arg;
+  } else {
+    return compare_from<Compare>(args...);
+  }
+}
+
+template <typename Container, typename = void>
+struct is_multi_container : std::false_type {};
+template <typename Container>
+struct is_multi_container<
+    Container,
+    std::enable_if_t<std::is_same_v<
+        decltype(std::declval<Container&>().insert(
+            std::declval<typename Container::value_type const&>())),
+        typename Container::iterator>>> : std::true_type {};
+
+// Whether `Adaptor` builds keys of type `Key` from the `first` of a `Source`
+template <typename Adaptor, typename Key, typename Source, typename = void>
+struct adapts_first : std::false_type {};
+template <typename Adaptor, typename Key, typename Source>
+struct adapts_first<Adaptor,
+                    Key,
+                    Source,
+                    std::void_t<decltype(std::declval<Source>().first)>> {
+ private:
+  using first_type = decltype(std::declval<Source>().first);
+
+ public:
+  static constexpr bool value =
+      !std::is_same_v<std::decay_t<first_type>, Key> &&
+      adaptor_traits<Adaptor>::template adapts<first_type> &&
+      std::is_same_v<typename Adaptor::target_type, Key>;
+};
+
+// Elements are made from sources as inserting them would: adapted where the
+// container's adaptor adapts them, and converted otherwise
+template <typename Container, typename = void>
+struct sort_element {
+  using type = typename Container::value_type;
+  static auto const& key(type const& element) { return element; }
+
+  template <typename Adaptor, typename Source>
+  static type make(Adaptor& adaptor, Source&& source) {
+    if constexpr (!std::is_same_v<std::decay_t<Source>, type> &&
+                  adaptor_traits<Adaptor>::template adapts<Source> &&
+                  std::is_same_v<typename Adaptor::target_type, type>) {
+      return detail::adapt_to<type>(adaptor, std::forward<Source>(source));
+    } else {
+      return type(std::forward<Source>(source));
+    }
+  }
+};
+// Map elements are sorted as pairs with a key that can be moved. Only the
+// key is adapted, by the map's key adaptor.
+template <typename Container>
+struct sort_element<Container, std::void_t<typename Container::mapped_type>> {
+  using key_type = typename Container::key_type;
+  using type = std::pair<key_type, typename Container::mapped_type>;
+  static auto const& key(type const& element) { return element.first; }
+
+  template <typename Adaptor, typename Source>
+  static type make(Adaptor& adaptor, Source&& source) {
+    if constexpr (adapts_first<Adaptor, key_type, Source>::value) {
+      return type(detail::adapt_to<key_type>(
+                      adaptor, std::forward<Source>(source).first),
+                  std::forward<Source>(source).second);
+    } else {
+      return type(std::forward<Source>(source));
+    }
+  }
+};
+
+// Ordered containers: each worker builds, sorts and (for unique keys)
+// deduplicates the elements of a slice of the input, and the sorted runs are
+// merged pairwise, the merges of each round in parallel, before the result
+// is built from the single sorted run. That last merge and the build itself
+// take linear time on one thread. Among equivalent elements, those earlier
+// in the input stay first and, for unique keys, are the ones kept, as when
+// inserting serially.
+template <typename Container>
+struct parallel_builder<Container,
+                        std::void_t<typename Container::key_compare>> {
+ private:
+  using element = sort_element<Container>;
+  using element_type = typename element::type;
+  using run_type = std::vector<element_type>;
+  using adaptor_type = container_adaptor_t<Container>;
+  static constexpr bool kUnique = !is_multi_container<Container>::value;
+
+  template <typename Compare>
+  static void merge_runs(run_type& lhs,
+                         run_type& rhs,
+                         run_type& out,
+                         Compare const& compare) {
+    out.reserve(lhs.size() + rhs.size());
+    auto left = lhs.begin(), right = rhs.begin();
+    while (left != lhs.end() && right != rhs.end()) {
+      if (compare(element::key(*right), element::key(*left))) {
+        out.push_back(std::move(*right++));
+        continue;
+      }
+      if constexpr (kUnique) {
+        if (!compare(element::key(*left), element::key(*right))) {
+          ++right;
+        }
+      }
+      out.push_back(std::move(*left++));
+    }
+    out.insert(out.end(), std::make_move_iterator(left),
+               std::make_move_iterator(lhs.end()));
+    out.insert(out.end(), std::make_move_iterator(right),
+               std::make_move_iterator(rhs.end()));
+    run_type().swap(lhs);
+    run_type().swap(rhs);
+  }
+
+ public:
+  template <typename RandomIt, typename... Args>
+  static Container build(std::size_t workers,
+                         RandomIt first,
+                         RandomIt last,
+                         Args&&... args) {
+    auto const compare =
+        compare_from<typename Container::key_compare>(args...);
+    auto byKey = [&compare](element_type const& lhs, element_type const& rhs) {
+      return compare(element::key(lhs), element::key(rhs));
+    };
+    auto const count = static_cast<std::size_t>(last - first);
+    std::vector<run_type> runs(workers);
+    run_parallel(workers, [&](std::size_t worker) {
+      auto const begin = partition_begin(count, worker, workers);
+      auto const end = partition_begin(count, worker + 1, workers);
+      // Adaptors with state of their own are copied per thread, and start
+      // afresh: the container's own isn't shared across threads
+      adaptor_type adaptor{};
+      auto& run = runs[worker];
+      run.reserve(end - begin);
+      for (auto i = begin; i < end; ++i) {
+        run.push_back(element::make(adaptor, first[i]));
+      }
+      std::stable_sort(run.begin(), run.end(), byKey);
+      if constexpr (kUnique) {
+        run.erase(std::unique(run.begin(), run.end(),
+                              [&byKey](auto const& lhs, auto const& rhs) {
+                                return !byKey(lhs, rhs);
+                              }),
+                  run.end());
+      }
+    });
+    while (runs.size() > 1) {
+      std::vector<run_type> merged((runs.size() + 1) / 2);
+      run_parallel(runs.size() / 2, [&](std::size_t pair) {
+        merge_runs(runs[2 * pair], runs[2 * pair + 1], merged[pair], compare);
+      });
+      if (runs.size() % 2 != 0) {
+        merged.back() = std::move(runs.back());
+      }
+      runs = std::move(merged);
+    }
+    return Container(std::make_move_iterator(runs.front().begin()),
+                     std::make_move_iterator(runs.front().end()),
+                     std::forward<Args>(args)...);
+  }
+};
+
+// `proposed::unordered_set`, which befriends this builder: the set is built
+// with its buckets split into one range per worker, in two passes. In the
+// first, each worker hashes a slice of the input and groups what it found by
+// the range of buckets it hashes into. In the second, each worker takes a
+// range of buckets and, from every slice in input order, inserts the sources
+// that hash into it, adapting those not already there. No bucket is touched
+// by two workers, so nothing is locked, and the first of equal sources is
+// the one kept, as when inserting serially.
+template <class Key, class Hash, class KeyEqual, class Allocator, class Adaptor>
+struct parallel_builder<
+    unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>> {
+ private:
+  using Set = unordered_set<Key, Hash, KeyEqual, Allocator, Adaptor>;
+  using aTraits = std::allocator_traits<Allocator>;
+
+  struct probe {
+    std::size_t bucketIndex;
+    std::size_t sourceIndex;
+  };
+  // What one worker found in its slice of the input
+  struct slice {
+    // Grouped by bucket range, with `ranges[r]` where range `r` starts
+    std::vector<probe> probes;
+    std::vector<std::size_t> ranges;
+  };
+
+  template <typename Source>
+  static void insert_into(Set& result,
+                          std::vector<Key*>& bucket,
+                          Allocator& alloc,
+                          Adaptor& adaptor,
+                          Source&& source) {
+    for (auto entry : bucket) {
+      if (result.equal_(*entry, source)) {
+        return;
+      }
+    }
+    // Room for the entry first, so that nothing throws once the key is built
+    bucket.emplace_back();
+    Key* newEntryPtr = nullptr;
+    try {
+      newEntryPtr = aTraits::allocate(alloc, 1);
+      if constexpr (Set::template is_write_adaptable<Source>()) {
+        detail::adapt_using_allocator(
+            adaptor, newEntryPtr, std::forward<Source>(source), alloc);
+      } else {
+        aTraits::construct(alloc, newEntryPtr, std::forward<Source>(source));
+      }
+    } catch (...) {
+      if (newEntryPtr) {
+        aTraits::deallocate(alloc, newEntryPtr, 1);
+      }
+      bucket.pop_back();
+      throw;
+    }
+    bucket.back() = newEntryPtr;
+  }
+
+ public:
+  template <typename RandomIt, typename... Args>
+  static Set build(std::size_t workers,
+                   RandomIt first,
+                   RandomIt last,
+                   Args&&... args) {
+    Set result(std::forward<Args>(args)...);
+    // Every worker allocates nodes, which an allocator with state of its
+    // own (a `pmr` one, say) needn't allow
+    if constexpr (!aTraits::is_always_equal::value) {
+      result.insert(first, last);
+      return result;
+    } else {
+      auto const count = static_cast<std::size_t>(last - first);
+      if (count > result.bucket_count() * result.max_load_factor()) {
+        result.reserve(count);
+      }
+      auto const bucketCount = result.bucket_count();
+      auto rangeOf = [&](std::size_t bucketIndex) {
+        return bucketIndex * workers / bucketCount;
+      };
+
+      std::vector<slice> slices(workers);
+      run_parallel(workers, [&](std::size_t worker) {
+        auto& mine = slices[worker];
+        auto const begin = partition_begin(count, worker, workers);
+        auto const end = partition_begin(count, worker + 1, workers);
+        std::vector<probe> found;
+        found.reserve(end - begin);
+        mine.ranges.assign(workers + 1, 0);
+        for (auto i = begin; i < end; ++i) {
+          auto const bucketIndex = result.hash_(first[i]) % bucketCount;
+          ++mine.ranges[rangeOf(bucketIndex) + 1];
+          found.push_back({bucketIndex, i});
+        }
+        for (std::size_t range = 0; range < workers; ++range) {
+          mine.ranges[range + 1] += mine.ranges[range];
+        }
+        auto next = mine.ranges;
+        mine.probes.resize(found.size());
+        for (auto const& p : found) {
+          mine.probes[next[rangeOf(p.bucketIndex)]++] = p;
+        }
+      });
+
+      run_parallel(workers, [&](std::size_t range) {
+        auto alloc = result.alloc_;
+        auto adaptor = result.keyAdaptor_;
+        for (auto& from : slices) {
+          for (auto i = from.ranges[range]; i < from.ranges[range + 1]; ++i) {
+            auto const& p = from.probes[i];
+            insert_into(result, result.buckets_[p.bucketIndex], alloc,
+                        adaptor, first[p.sourceIndex]);
+          }
+        }
+      });
+      return result;
+    }
+  }
+};
+}  // namespace detail
+
+// Returns `Container(first, last, args...)`, built using up to as many
+// threads as `policy` allows, where the input is large enough to be worth
+// it. Sources are adapted (or converted) to elements, and hashed or sorted,
+// on those threads: the containers each say how. Adaptors are copied for
+// each thread, and the comparison or hash function must be safe to call
+// from several at once. Input that isn't random access, and containers that
+// say nothing, are built on the caller's thread.
+template <typename Container, typename RandomIt, typename... Args>
+Container build_parallel(execution::parallel_policy policy,
+                         RandomIt first,
+                         RandomIt last,
+                         Args&&... args) {
+  using category = typename std::iterator_traits<RandomIt>::iterator_category;
+  if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                  category>) {
+    auto const workers = detail::parallel_workers(
+        policy, static_cast<std::size_t>(last - first));
+    if (workers > 1) {
+      return detail::parallel_builder<Container>::build(
+          workers, first, last, std::forward<Args>(args)...);
+    }
+  }
+  return Container(first, last, std::forward<Args>(args)...);
+}
+}  // namespace proposed
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <proposed/adaptor>
+#include <proposed/string>
+
+namespace proposed {
+// Wraps an expensive adaptor with a small cache of the targets it has
+// built, keyed on an owning copy (`Key`) of the source. A repeated source
+// is answered by copying the cached target instead of adapting it again.
+//
+// The cache holds up to `Capacity` entries and evicts by CLOCK: a hit sets
+// an entry's reference bit, and the hand clears bits until it finds an
+// entry without one. New entries start unreferenced, so a run of one-off
+// sources can't flush out the entries that are being reused. Lookups scan
+// an array of hashes, which is quick for the small capacities this is
+// meant for.
+//
+// Sources are probed without building a `Key` when `Hash` and `KeyEqual`
+// accept them. Sources that `Key` can't be built from are adapted directly.
+// A `caching_adaptor` is not thread-safe, so it is no use to the concurrent
+// containers.
+template <typename Inner,
+          std::size_t Capacity = 64,
+          typename Key = std::string,
+          typename Hash = transparent_string_hash,
+          typename KeyEqual = transparent_string_equal>
+struct caching_adaptor {
+  static_assert(Capacity > 0, "Capacity must not be zero");
+
+  using target_type = typename Inner::target_type;
+  template <typename X>
+  static bool constexpr adapts{Inner::template adapts<X>};
+
+  caching_adaptor() = default;
+  explicit caching_adaptor(Inner inner,
+                           Hash const& hash = Hash{},
+                           KeyEqual const& equal = KeyEqual{})
+      : inner_(std::move(inner)), hash_(hash), equal_(equal) {}
+
+  template <typename X>
+  void operator()(target_type* pResult, X&& input) {
+    if constexpr (caches<X>) {
+      ::new (static_cast<void*>(pResult))
+          target_type(lookup(std::forward<X>(input)));
+    } else {
+      detail::invoke_adaptor(inner_, pResult, std::forward<X>(input));
+    }
+  }
+  template <typename X>
+  void adapt(target_type* pResult, X&& input) {
+    (*this)(pResult, std::forward<X>(input));
+  }
+  // The cache keeps its own copy; the container's copy uses `alloc`
+  template <typename X, typename Alloc>
+  void operator()(target_type* pResult, X&& input, Alloc const& alloc) {
+    if constexpr (caches<X>) {
+      detail::construct_using_allocator(
+          pResult, alloc, lookup(std::forward<X>(input)));
+    } else {
+      detail::adapt_using_allocator(
+          inner_, pResult, std::forward<X>(input), alloc);
+    }
+  }
+  template <typename X, typename Alloc>
+  void adapt(target_type* pResult, X&& input, Alloc const& alloc) {
+    (*this)(pResult, std::forward<X>(input), alloc);
+  }
+
+  std::uint64_t hits() const noexcept { return hits_; }
+  std::uint64_t misses() const noexcept { return misses_; }
+  double hit_rate() const noexcept {
+    auto const lookups = hits_ + misses_;
+    return lookups == 0 ? 0.0 : static_cast<double>(hits_) / lookups;
+  }
+  std::size_t size() const noexcept {
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < used_; ++i) {
+      result += slots_[i].has_value();
+    }
+    return result;
+  }
+  void clear() noexcept {
+    for (std::size_t i = 0; i < used_; ++i) {
+      slots_[i].reset();
+    }
+    used_ = 0;
+    hand_ = 0;
+  }
+  void reset_counters() noexcept { hits_ = misses_ = 0; }
+
+ private:
+  template <typename X>
+  static bool constexpr caches{std::is_constructible_v<Key, X const&>};
+  template <typename X>
+  static bool constexpr probes{
+      std::is_invocable_v<Hash const&, X const&> &&
+      std::is_invocable_r_v<bool, KeyEqual const&, Key const&, X const&>};
+  static constexpr std::size_t kNone = Capacity;
+
+  struct entry {
+    Key key;
+    target_type value;
+  };
+
+  template <typename X>
+  target_type const& lookup(X&& input) {
+    if constexpr (probes<X>) {
+      auto const hash = hash_(std::as_const(input));
+      auto const found = find(input, hash);
+      if (found != kNone) {
+        return slots_[found]->value;
+      }
+      return fill(hash, Key(std::as_const(input)), std::forward<X>(input));
+    } else {
+      Key key(std::as_const(input));
+      auto const hash = hash_(std::as_const(key));
+      auto const found = find(key, hash);
+      if (found != kNone) {
+        return slots_[found]->value;
+      }
+      return fill(hash, std::move(key), std::forward<X>(input));
+    }
+  }
+
+  template <typename Probe>
+  std::size_t find(Probe const& probe, std::size_t hash) {
+    for (std::size_t i = 0; i < used_; ++i) {
+      if (hashes_[i] == hash && slots_[i] && equal_(slots_[i]->key, probe)) {
+        referenced_[i] = true;
+        ++hits_;
+        return i;
+      }
+    }
+    ++misses_;
+    return kNone;
+  }
+
+  // Adapts before evicting, so a throwing adaptor leaves the cache as it
+  // was
+  template <typename X>
+  target_type const& fill(std::size_t hash, Key&& key, X&& input) {
+    detail::adaptor_scratch<target_type> scratch;
+    detail::invoke_adaptor(inner_, &scratch.value, std::forward<X>(input));
+    auto const slot = victim();
+    slots_[slot].reset();
+    try {
+      slots_[slot].emplace(entry{std::move(key), std::move(scratch.value)});
+    } catch (...) {
+      scratch.value.~target_type();
+      throw;
+    }
+    scratch.value.~target_type();
+    hashes_[slot] = hash;
+    referenced_[slot] = false;
+    return slots_[slot]->value;
+  }
+
+  std::size_t victim() noexcept {
+    if (used_ < Capacity) {
+      return used_++;
+    }
+    for (;;) {
+      auto const slot = hand_;
+      hand_ = hand_ + 1 == Capacity ? 0 : hand_ + 1;
+      if (!slots_[slot] || !referenced_[slot]) {
+        return slot;
+      }
+      referenced_[slot] = false;
+    }
+  }
+
+  Inner inner_;
+  Hash hash_;
+  KeyEqual equal_;
+  std::size_t hashes_[Capacity] = {};
+  bool referenced_[Capacity] = {};
+  std::optional<entry> slots_[Capacity];
+  std::size_t used_ = 0;
+  std::size_t hand_ = 0;
+  std::uint64_t hits_ = 0;
+  std::uint64_t misses_ = 0;
+};
+}  // namespace proposed
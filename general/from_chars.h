@@ -0,0 +1,204 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <proposed/adaptor>
+
+namespace proposed {
+namespace detail {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+inline constexpr bool kSwarDigits = true;
+#else
+inline constexpr bool kSwarDigits = false;
+#endif
+
+// Whether the eight bytes of `block` are all ASCII digits
+inline bool eight_digits(std::uint64_t block) noexcept {
+  return ((block & 0xF0F0F0F0F0F0F0F0ull) |
+          (((block + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+         0x3333333333333333ull;
+}
+
+// The value of the eight digits in `block`, loaded little-endian so that
+// the first digit is in the lowest byte. Pairs of digits are combined, then
+// pairs of pairs, with two multiplies in all.
+inline std::uint32_t parse_eight_digits(std::uint64_t block) noexcept {
+  constexpr std::uint64_t kMask = 0x000000FF000000FFull;
+  constexpr std::uint64_t kHundreds = 100 + (1000000ull << 32);
+  constexpr std::uint64_t kUnits = 1 + (10000ull << 32);
+  block -= 0x3030303030303030ull;
+  block = (block * 10) + (block >> 8);
+  return static_cast<std::uint32_t>(
+      (((block & kMask) * kHundreds) + (((block >> 16) & kMask) * kUnits)) >>
+      32);
+}
+
+// The fast path for decimal integers: an optional '-' (for signed `T`) and
+// up to 19 digits, taken eight at a time. Returns false, leaving `result`
+// alone, for anything else, including values that don't fit.
+template <typename T>
+bool parse_decimal_digits(std::string_view text, T& result) noexcept {
+  std::size_t i = 0;
+  bool negative = false;
+  if constexpr (std::is_signed_v<T>) {
+    negative = !text.empty() && text[0] == '-';
+    i = negative;
+  }
+  auto const digits = text.size() - i;
+  if (digits == 0 || digits > 19) {
+    return false;
+  }
+  std::uint64_t value = 0;
+  for (; text.size() - i >= 8; i += 8) {
+    std::uint64_t block;
+    std::memcpy(&block, text.data() + i, sizeof(block));
+    if (!eight_digits(block)) {
+      return false;
+    }
+    value = value * 100000000 + parse_eight_digits(block);
+  }
+  for (; i < text.size(); ++i) {
+    auto const digit = static_cast<unsigned char>(text[i]) - unsigned{'0'};
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  std::uint64_t const limit =
+      static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + negative;
+  if (value > limit) {
+    return false;
+  }
+  using unsigned_type = std::make_unsigned_t<T>;
+  auto const magnitude = static_cast<unsigned_type>(value);
+  result = static_cast<T>(negative ? unsigned_type{0} - magnitude : magnitude);
+  return true;
+}
+
+// Parses the whole of `text` as a `T` in `Base`, throwing as `std::stoll`
+// does when it can't: `std::invalid_argument` if it isn't a number (or has
+// anything after one) and `std::out_of_range` if it doesn't fit
+template <typename T, int Base>
+T parse_number(std::string_view text) {
+  T result;
+  if constexpr (std::is_integral_v<T> && Base == 10 && kSwarDigits) {
+    if (parse_decimal_digits(text, result)) {
+      return result;
+    }
+  }
+  auto const* const last = text.data() + text.size();
+  std::from_chars_result parsed;
+  if constexpr (std::is_floating_point_v<T>) {
+    parsed = std::from_chars(text.data(), last, result,
+                             Base == 16 ? std::chars_format::hex
+                                        : std::chars_format::general);
+  } else {
+    parsed = std::from_chars(text.data(), last, result, Base);
+  }
+  if (parsed.ec == std::errc::result_out_of_range) {
+    throw std::out_of_range{"Number out of range"};
+  }
+  if (parsed.ec != std::errc{} || parsed.ptr != last) {
+    throw std::invalid_argument{"Not a number"};
+  }
+  return result;
+}
+}  // namespace detail
+
+// Adaptor to an arithmetic `T` from text: anything that converts to a
+// `std::string_view`, parsed whole in `Base` with `std::from_chars`, so
+// there is no allocation and no locale. Decimal integers of up to 19 digits
+// take a faster path still, eight digits at a time. Text that isn't a number
+// throws `std::invalid_argument`, and a number that doesn't fit throws
+// `std::out_of_range`, as `std::stoll` does. Floating-point `T` takes
+// `Base` 10 or 16 (the `std::chars_format::hex` form, with no "0x").
+//
+// The containers compare a source with their keys before adapting it, so
+// use `from_chars_less` (or `from_chars_hash` and `from_chars_equal`) with
+// this.
+template <typename T, int Base = 10>
+struct from_chars_adaptor {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                "`from_chars_adaptor` parses integers and floating point");
+  static_assert(std::is_integral_v<T> ? Base >= 2 && Base <= 36
+                                      : Base == 10 || Base == 16,
+                "`Base` must be one `std::from_chars` supports");
+
+  using target_type = T;
+  template <typename X>
+  static bool constexpr adapts{std::is_convertible_v<X, std::string_view>};
+  template <typename X>
+  static adaptation_cost constexpr cost{adaptation_cost::copies};
+
+  void operator()(target_type* pResult, std::string_view input) {
+    ::new (static_cast<void*>(pResult))
+        target_type(detail::parse_number<T, Base>(input));
+  }
+  // Parses a batch of sources, for bulk loads through range insertion. The
+  // targets need no destruction, so a throw leaves nothing to clean up.
+  template <typename X>
+  std::enable_if_t<adapts<X const&>> adapt_n(target_type* out,
+                                             X const* in,
+                                             std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = detail::parse_number<T, Base>(std::string_view{in[i]});
+    }
+  }
+};
+
+template <typename T>
+using decimal_adaptor = from_chars_adaptor<T, 10>;
+template <typename T>
+using hex_adaptor = from_chars_adaptor<T, 16>;
+
+// Transparent ordering of `T`s that also accepts text, parsed as
+// `from_chars_adaptor<T, Base>` would at each comparison, so that a
+// container keyed by numbers can take their text for lookup and insertion
+template <typename T, int Base = 10>
+struct from_chars_less {
+  using is_transparent = void;
+
+  bool operator()(T lhs, T rhs) const noexcept { return lhs < rhs; }
+  bool operator()(std::string_view lhs, T rhs) const {
+    return detail::parse_number<T, Base>(lhs) < rhs;
+  }
+  bool operator()(T lhs, std::string_view rhs) const {
+    return lhs < detail::parse_number<T, Base>(rhs);
+  }
+};
+
+// Transparent hash of `T`s that also accepts text, matching
+// `from_chars_equal`
+template <typename T, int Base = 10>
+struct from_chars_hash {
+  using is_transparent = void;
+
+  std::size_t operator()(T value) const noexcept {
+    return std::hash<T>{}(value);
+  }
+  std::size_t operator()(std::string_view text) const {
+    return (*this)(detail::parse_number<T, Base>(text));
+  }
+};
+
+template <typename T, int Base = 10>
+struct from_chars_equal {
+  using is_transparent = void;
+
+  bool operator()(T lhs, T rhs) const noexcept { return lhs == rhs; }
+  bool operator()(std::string_view lhs, T rhs) const {
+    return detail::parse_number<T, Base>(lhs) == rhs;
+  }
+  bool operator()(T lhs, std::string_view rhs) const {
+    return lhs == detail::parse_number<T, Base>(rhs);
+  }
+};
+}  // namespace proposed
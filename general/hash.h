@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace proposed {
+namespace detail {
+// Primitives of the wyhash family (https://github.com/wangyi-fudan/wyhash).
+// The 64x64->128 bit multiply does the mixing; long inputs are consumed
+// 48 bytes at a time through three independent multiply chains so that the
+// CPU can keep several multipliers busy at once.
+inline constexpr std::uint64_t kWySecret[4] = {
+    0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull,
+    0x589965cc75374cc3ull};
+
+inline void wymum(std::uint64_t* a, std::uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = *a;
+  r *= *b;
+  *a = static_cast<std::uint64_t>(r);
+  *b = static_cast<std::uint64_t>(r >> 64);
+#else
+  std::uint64_t ha = *a >> 32, hb = *b >> 32;
+  std::uint64_t la = static_cast<std::uint32_t>(*a);
+  std::uint64_t lb = static_cast<std::uint32_t>(*b);
+  std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  std::uint64_t t = rl + (rm0 << 32);
+  std::uint64_t c = t < rl;
+  std::uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  *a = lo;
+  *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline std::uint64_t wymix(std::uint64_t a, std::uint64_t b) {
+  wymum(&a, &b);
+  return a ^ b;
+}
+
+inline std::uint64_t wyr8(unsigned char const* p) {
+  std::uint64_t v;
+  std::memcpy(&v, p, 8);
+  return v;
+}
+
+inline std::uint64_t wyr4(unsigned char const* p) {
+  std::uint32_t v;
+  std::memcpy(&v, p, 4);
+  return v;
+}
+
+inline std::uint64_t wyr3(unsigned char const* p, std::size_t k) {
+  return (std::uint64_t{p[0]} << 16) | (std::uint64_t{p[k >> 1]} << 8) |
+         p[k - 1];
+}
+}  // namespace detail
+
+// Hashes `len` bytes starting at `key`. The result is well distributed in all
+// 64 bits, so it may be reduced to a bucket index by either masking or modulo.
+// Results are not guaranteed to be stable across platforms or releases.
+inline std::uint64_t hash_bytes(void const* key,
+                                std::size_t len,
+                                std::uint64_t seed = 0) {
+  using detail::kWySecret;
+  using detail::wymix;
+  using detail::wyr3;
+  using detail::wyr4;
+  using detail::wyr8;
+  auto p = static_cast<unsigned char const*>(key);
+  seed ^= wymix(seed ^ kWySecret[0], kWySecret[1]);
+  std::uint64_t a, b;
+  if (len <= 16) {
+    if (len >= 4) {
+      a = (wyr4(p) << 32) | wyr4(p + ((len >> 3) << 2));
+      b = (wyr4(p + len - 4) << 32) | wyr4(p + len - 4 - ((len >> 3) << 2));
+    } else if (len > 0) {
+      a = wyr3(p, len);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    std::size_t i = len;
+    if (i > 48) {
+      std::uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = wymix(wyr8(p) ^ kWySecret[1], wyr8(p + 8) ^ seed);
+        see1 = wymix(wyr8(p + 16) ^ kWySecret[2], wyr8(p + 24) ^ see1);
+        see2 = wymix(wyr8(p + 32) ^ kWySecret[3], wyr8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = wymix(wyr8(p) ^ kWySecret[1], wyr8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = wyr8(p + i - 16);
+    b = wyr8(p + i - 8);
+  }
+  a ^= kWySecret[1];
+  b ^= seed;
+  detail::wymum(&a, &b);
+  return wymix(a ^ kWySecret[0] ^ len, b ^ kWySecret[1]);
+}
+}  // namespace proposed
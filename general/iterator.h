@@ -0,0 +1,16 @@
+#pragma once
+
+#include <memory>
+
+namespace proposed {
+namespace detail {
+// `operator->` for iterators whose `reference` is a proxy object (such as a
+// pair of references) rather than a real reference: holds the proxy so that
+// `it->member` has something to point at.
+template <typename Reference>
+struct arrow_proxy {
+  Reference reference;
+  Reference* operator->() { return std::addressof(reference); }
+};
+}  // namespace detail
+}  // namespace proposed
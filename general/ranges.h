@@ -0,0 +1,129 @@
+#pragma once
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+// Everything here needs C++20 ranges; without them this header is empty
+#if defined(__cpp_lib_ranges)
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <proposed/adaptor>
+
+namespace proposed {
+namespace detail {
+// The function `views::adapt` transforms by: adapts whatever the source
+// range yields, moving from it if it yields rvalues
+template <typename Adaptor>
+struct adapting {
+  using target_type = typename Adaptor::target_type;
+
+  template <typename X>
+    requires(Adaptor::template adapts<std::remove_cvref_t<X>>)
+  target_type operator()(X&& input) const {
+    return detail::adapt_to<target_type>(adaptor, std::forward<X>(input));
+  }
+
+  // Adaptors may keep state (`caching_adaptor` does), but adapting is not
+  // part of the view's observable state, so it may happen through a const
+  // view
+  [[no_unique_address]] mutable Adaptor adaptor;
+};
+
+// Whether the iterators of `R` are also pre-C++20 input iterators, as the
+// containers' iterator-pair members expect
+template <typename R>
+concept legacy_input_range = requires {
+  typename std::iterator_traits<
+      std::ranges::iterator_t<R>>::iterator_category;
+  requires std::derived_from<
+      typename std::iterator_traits<
+          std::ranges::iterator_t<R>>::iterator_category,
+      std::input_iterator_tag>;
+};
+
+template <typename Adaptor>
+struct adapt_closure {
+  template <std::ranges::viewable_range R>
+  auto operator()(R&& range, Adaptor adaptor = {}) const {
+    return std::ranges::transform_view(std::views::all(std::forward<R>(range)),
+                                       adapting<Adaptor>{std::move(adaptor)});
+  }
+  template <std::ranges::viewable_range R>
+  friend auto operator|(R&& range, adapt_closure const& self) {
+    return self(std::forward<R>(range));
+  }
+};
+}  // namespace detail
+
+// A view of `V` with each element adapted by `Adaptor` as it is read. The
+// elements are `Adaptor::target_type` prvalues: nothing is kept between
+// reads, and nothing is adapted that isn't read. The view is sized, and
+// random access, when `V` is.
+template <std::ranges::input_range V, typename Adaptor>
+  requires std::ranges::view<V>
+using adapt_view = std::ranges::transform_view<V, detail::adapting<Adaptor>>;
+
+namespace views {
+// `range | views::adapt<Adaptor>`, or `views::adapt<Adaptor>(range)`, is an
+// `adapt_view` of `range`. It composes with the standard views: filter or
+// transform what it yields, or adapt what they yield. A range of rvalues
+// (of move iterators, say) is moved from as it is read.
+template <typename Adaptor>
+inline constexpr detail::adapt_closure<Adaptor> adapt{};
+}  // namespace views
+
+namespace ranges {
+// Inserts the elements of `range` into `container`, first reserving room
+// for them if the range knows its size and the container can reserve, so
+// that a hash or flat container rehashes or reallocates at most once
+template <typename Container, std::ranges::input_range R>
+void insert_range(Container& container, R&& range) {
+  if constexpr (std::ranges::sized_range<R> &&
+                requires { container.reserve(std::size_t{}); }) {
+    container.reserve(container.size() +
+                      static_cast<std::size_t>(std::ranges::size(range)));
+  }
+  if constexpr (detail::legacy_input_range<R>) {
+    if constexpr (std::ranges::common_range<R>) {
+      detail::insert_range(
+          container, std::ranges::begin(range), std::ranges::end(range));
+    } else {
+      auto common = std::views::common(std::forward<R>(range));
+      detail::insert_range(container, common.begin(), common.end());
+    }
+  } else {
+    // Only C++20 iterators (such as an `adapt_view` of move iterators), so
+    // one element at a time
+    for (auto&& element : range) {
+      if constexpr (requires {
+                      container.insert(container.end(),
+                                       std::forward<decltype(element)>(
+                                           element));
+                    }) {
+        container.insert(container.end(),
+                         std::forward<decltype(element)>(element));
+      } else {
+        container.insert(std::forward<decltype(element)>(element));
+      }
+    }
+  }
+}
+
+// Builds a `Container` from `args` and inserts `range` into it, as
+// `std::ranges::to` does from C++23
+template <typename Container, std::ranges::input_range R, typename... Args>
+Container to(R&& range, Args&&... args) {
+  Container result(std::forward<Args>(args)...);
+  insert_range(result, std::forward<R>(range));
+  return result;
+}
+}  // namespace ranges
+}  // namespace proposed
+
+#endif
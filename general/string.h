@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <proposed/adaptor>
+#include <proposed/hash>
 
 namespace proposed {
 
@@ -18,10 +23,94 @@ struct basic_string_adaptor {
              std::basic_string_view<CharT, Traits> const& input) {
     ::new (static_cast<void*>(pResult)) target_type(input);
   }
+  void operator()(target_type* pResult,
+                  std::basic_string_view<CharT, Traits> const& input) {
+    adapt(pResult, input);
+  }
+  // Builds the string with the container's allocator, so a `pmr` container's
+  // keys come from its memory resource
+  template <typename Alloc>
+  void adapt(target_type* pResult,
+             std::basic_string_view<CharT, Traits> const& input,
+             Alloc const& alloc) {
+    detail::construct_using_allocator(pResult, alloc, input);
+  }
+  template <typename Alloc>
+  void operator()(target_type* pResult,
+                  std::basic_string_view<CharT, Traits> const& input,
+                  Alloc const& alloc) {
+    adapt(pResult, input, alloc);
+  }
+  void adapt_n(target_type* out,
+               std::basic_string_view<CharT, Traits> const* in,
+               std::size_t n) {
+    std::uninitialized_copy_n(in, n, out);
+  }
+  template <typename Alloc>
+  void adapt_n(target_type* out,
+               std::basic_string_view<CharT, Traits> const* in,
+               std::size_t n,
+               Alloc const& alloc) {
+    detail::construct_n_using_allocator(out, in, n, alloc);
+  }
 };
 
 using string_adaptor = basic_string_adaptor<char>;
 using wstring_adaptor = basic_string_adaptor<wchar_t>;
 using u16string_adaptor = basic_string_adaptor<char16_t>;
 using u32string_adaptor = basic_string_adaptor<char32_t>;
+
+namespace pmr {
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+using basic_string_adaptor =
+    proposed::basic_string_adaptor<CharT,
+                                   Traits,
+                                   std::pmr::polymorphic_allocator<CharT>>;
+using string_adaptor = basic_string_adaptor<char>;
+using wstring_adaptor = basic_string_adaptor<wchar_t>;
+using u16string_adaptor = basic_string_adaptor<char16_t>;
+using u32string_adaptor = basic_string_adaptor<char32_t>;
+}  // namespace pmr
+
+// Transparent hash for string keys: `std::basic_string`, `std::basic_string_view`
+// and null-terminated `CharT const*` with the same contents hash identically,
+// so a container keyed on strings can be queried with any of them.
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+struct basic_transparent_string_hash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::basic_string_view<CharT, Traits> input) const
+      noexcept {
+    return static_cast<std::size_t>(
+        hash_bytes(input.data(), input.size() * sizeof(CharT)));
+  }
+  template <typename Allocator>
+  std::size_t operator()(
+      std::basic_string<CharT, Traits, Allocator> const& input) const noexcept {
+    return operator()(std::basic_string_view<CharT, Traits>{input});
+  }
+  std::size_t operator()(CharT const* input) const noexcept {
+    return operator()(std::basic_string_view<CharT, Traits>{input});
+  }
+};
+
+// Transparent equality matching `basic_transparent_string_hash`
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+struct basic_transparent_string_equal {
+  using is_transparent = void;
+
+  bool operator()(std::basic_string_view<CharT, Traits> lhs,
+                  std::basic_string_view<CharT, Traits> rhs) const noexcept {
+    return lhs == rhs;
+  }
+};
+
+using transparent_string_hash = basic_transparent_string_hash<char>;
+using transparent_wstring_hash = basic_transparent_string_hash<wchar_t>;
+using transparent_u16string_hash = basic_transparent_string_hash<char16_t>;
+using transparent_u32string_hash = basic_transparent_string_hash<char32_t>;
+using transparent_string_equal = basic_transparent_string_equal<char>;
+using transparent_wstring_equal = basic_transparent_string_equal<wchar_t>;
+using transparent_u16string_equal = basic_transparent_string_equal<char16_t>;
+using transparent_u32string_equal = basic_transparent_string_equal<char32_t>;
 }  // namespace proposed
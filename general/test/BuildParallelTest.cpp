@@ -0,0 +1,205 @@
+#include <proposed/build_parallel>
+#include <proposed/flat_set>
+#include <proposed/frozen_set>
+#include <proposed/map>
+#include <proposed/multiset>
+#include <proposed/set>
+#include <proposed/string>
+#include <proposed/unordered_set>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace std::literals;
+
+namespace {
+// Enough for several workers, with every word repeated
+std::vector<std::string> makeWords(std::size_t count, std::size_t distinct) {
+  std::vector<std::string> result;
+  result.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    result.push_back("word-" + std::to_string(i * 7919 % distinct));
+  }
+  return result;
+}
+
+std::vector<std::string> const kWords = makeWords(20000, 5000);
+std::vector<std::string_view> const kViews(kWords.begin(), kWords.end());
+
+auto const kFour = proposed::execution::parallel_policy{4};
+
+// Throws on one word, to see that an exception on a worker reaches the caller
+struct throwing_adaptor {
+  using target_type = std::string;
+  template <typename X>
+  static bool constexpr adapts{std::is_same_v<X, std::string_view>};
+
+  void operator()(target_type* pResult, std::string_view input) {
+    if (input == "word-1234") {
+      throw std::runtime_error{"bad word"};
+    }
+    ::new (static_cast<void*>(pResult)) target_type(input);
+  }
+};
+
+// Counts the keys it builds, across all threads
+std::atomic<std::size_t> adaptedKeys{0};
+struct counting_adaptor {
+  using target_type = std::string;
+  template <typename X>
+  static bool constexpr adapts{std::is_same_v<X, std::string_view>};
+
+  void operator()(target_type* pResult, std::string_view input) {
+    ++adaptedKeys;
+    ::new (static_cast<void*>(pResult)) target_type(input);
+  }
+};
+
+template <typename Adaptor>
+using string_set = proposed::unordered_set<std::string,
+                                           proposed::transparent_string_hash,
+                                           proposed::transparent_string_equal,
+                                           std::allocator<std::string>,
+                                           Adaptor>;
+}  // namespace
+
+TEST(ProposedBuildParallel, UnorderedSetMatchesSerial) {
+  using set = string_set<proposed::string_adaptor>;
+  auto const serial = set(kViews.begin(), kViews.end());
+  auto const parallel =
+      proposed::build_parallel<set>(kFour, kViews.begin(), kViews.end());
+  EXPECT_EQ(5000U, parallel.size());
+  EXPECT_EQ(serial, parallel);
+
+  // Sources that convert to keys, with the container's constructor arguments
+  std::vector<char const*> pointers;
+  for (auto const& word : kWords) {
+    pointers.push_back(word.c_str());
+  }
+  using plain = proposed::unordered_set<std::string>;
+  auto const converted = proposed::build_parallel<plain>(
+      kFour, pointers.begin(), pointers.end(), std::size_t{64});
+  EXPECT_EQ(5000U, converted.size());
+  EXPECT_EQ(1U, converted.count("word-4999"s));
+  EXPECT_LE(5000U, converted.bucket_count());
+}
+
+TEST(ProposedBuildParallel, UnorderedSetMovesFromRvalueSources) {
+  auto words = kWords;
+  auto const parallel =
+      proposed::build_parallel<string_set<proposed::no_adaptor>>(
+          kFour, std::make_move_iterator(words.begin()),
+          std::make_move_iterator(words.end()));
+  EXPECT_EQ(5000U, parallel.size());
+  std::size_t moved = 0;
+  for (auto const& word : words) {
+    moved += word.empty();
+  }
+  EXPECT_EQ(5000U, moved);
+}
+
+TEST(ProposedBuildParallel, OrderedMatchesSerial) {
+  using set = proposed::set<std::string, std::less<>,
+                            std::allocator<std::string>,
+                            proposed::string_adaptor>;
+  auto const parallel =
+      proposed::build_parallel<set>(kFour, kViews.begin(), kViews.end());
+  EXPECT_EQ(set(kViews.begin(), kViews.end()), parallel);
+
+  using multiset = proposed::multiset<std::string>;
+  auto const all =
+      proposed::build_parallel<multiset>(kFour, kWords.begin(), kWords.end());
+  EXPECT_EQ(multiset(kWords.begin(), kWords.end()), all);
+
+  using flat = proposed::flat_set<std::string>;
+  auto const sorted =
+      proposed::build_parallel<flat>(kFour, kWords.begin(), kWords.end());
+  EXPECT_EQ(flat(kWords.begin(), kWords.end()), sorted);
+
+  using frozen = proposed::frozen_set<std::string>;
+  auto const fixed = proposed::build_parallel<frozen>(
+      proposed::execution::par, kWords.begin(), kWords.end());
+  EXPECT_EQ(frozen(kWords.begin(), kWords.end()), fixed);
+}
+
+TEST(ProposedBuildParallel, OrderedUsesGivenComparison) {
+  // Only the comparison passed in knows which way round to sort
+  struct by_direction {
+    bool descending{false};
+    bool operator()(int lhs, int rhs) const {
+      return descending ? rhs < lhs : lhs < rhs;
+    }
+  };
+  std::vector<int> numbers;
+  for (int i = 0; i < 10000; ++i) {
+    numbers.push_back(i * 7919 % 5000);
+  }
+  using set = proposed::set<int, by_direction>;
+  auto const parallel = proposed::build_parallel<set>(
+      kFour, numbers.begin(), numbers.end(), by_direction{true});
+  EXPECT_EQ(set(numbers.begin(), numbers.end(), by_direction{true}), parallel);
+  EXPECT_EQ(4999, *parallel.begin());
+}
+
+TEST(ProposedBuildParallel, MapKeepsFirstOfEqualKeys) {
+  std::vector<std::pair<std::string_view, int>> entries;
+  for (std::size_t i = 0; i < kViews.size(); ++i) {
+    entries.emplace_back(kViews[i], static_cast<int>(i));
+  }
+  using map = proposed::map<std::string, int>;
+  auto const parallel =
+      proposed::build_parallel<map>(kFour, entries.begin(), entries.end());
+  EXPECT_EQ(map(entries.begin(), entries.end()), parallel);
+  EXPECT_EQ(0, parallel.at("word-0"));
+}
+
+TEST(ProposedBuildParallel, MapAdaptsKeys) {
+  std::vector<std::pair<std::string_view, int>> entries;
+  for (std::size_t i = 0; i < kViews.size(); ++i) {
+    entries.emplace_back(kViews[i], static_cast<int>(i));
+  }
+  using map =
+      proposed::map<std::string, int, std::less<>,
+                    std::allocator<std::pair<const std::string, int>>,
+                    counting_adaptor>;
+  adaptedKeys = 0;
+  auto const parallel =
+      proposed::build_parallel<map>(kFour, entries.begin(), entries.end());
+  EXPECT_EQ(entries.size(), adaptedKeys);
+  EXPECT_EQ(5000U, parallel.size());
+  EXPECT_EQ(0, parallel.at("word-0"sv));
+}
+
+TEST(ProposedBuildParallel, PropagatesExceptions) {
+  EXPECT_THROW(proposed::build_parallel<string_set<throwing_adaptor>>(
+                   kFour, kViews.begin(), kViews.end()),
+               std::runtime_error);
+  using set = proposed::set<std::string, std::less<>,
+                            std::allocator<std::string>, throwing_adaptor>;
+  EXPECT_THROW(
+      proposed::build_parallel<set>(kFour, kViews.begin(), kViews.end()),
+      std::runtime_error);
+}
+
+TEST(ProposedBuildParallel, BuildsSeriallyWhenItMust) {
+  // A `pmr` allocator isn't shared across threads
+  using pmr_set = proposed::pmr::unordered_set<
+      std::pmr::string, proposed::transparent_string_hash,
+      proposed::transparent_string_equal,
+      proposed::pmr::string_adaptor>;
+  std::pmr::monotonic_buffer_resource resource;
+  auto const pooled = proposed::build_parallel<pmr_set>(
+      kFour, kViews.begin(), kViews.end(), std::size_t{32}, &resource);
+  EXPECT_EQ(5000U, pooled.size());
+
+  using set = string_set<proposed::string_adaptor>;
+  auto const small = proposed::build_parallel<set>(
+      proposed::execution::par, kViews.begin(), kViews.begin() + 100);
+  EXPECT_EQ(100U, small.size());
+}
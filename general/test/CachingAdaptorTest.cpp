@@ -0,0 +1,91 @@
+#include <proposed/caching_adaptor>
+#include <proposed/map>
+#include <gtest/gtest.h>
+#include <cctype>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace std::literals;
+
+namespace {
+// Upper-cases its input, counting how often it is asked to
+struct counting_upper {
+  using target_type = std::string;
+  template <typename X>
+  static bool constexpr adapts{
+      std::is_convertible_v<X, std::string_view> &&
+      !std::is_same_v<std::decay_t<X>, std::string>};
+
+  void operator()(target_type* pResult, std::string_view input) {
+    ++calls;
+    if (input == "throw") {
+      throw std::invalid_argument{"throw"};
+    }
+    ::new (static_cast<void*>(pResult)) target_type(input);
+    for (auto& c : *pResult) {
+      c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+  }
+  static inline int calls = 0;
+};
+}  // namespace
+
+TEST(ProposedCachingAdaptor, CountsHits) {
+  counting_upper::calls = 0;
+  proposed::caching_adaptor<counting_upper, 4> adaptor;
+  static_assert(decltype(adaptor)::adapts<std::string_view>);
+  static_assert(!decltype(adaptor)::adapts<std::string>);
+  EXPECT_EQ("HELLO"s, proposed::detail::adapt_to<std::string>(
+                          adaptor, "hello"sv));
+  EXPECT_EQ("HELLO"s, proposed::detail::adapt_to<std::string>(
+                          adaptor, "hello"sv));
+  EXPECT_EQ("HELLO"s,
+            proposed::detail::adapt_to<std::string>(adaptor, "hello"));
+  EXPECT_EQ(1, counting_upper::calls);
+  EXPECT_EQ(2U, adaptor.hits());
+  EXPECT_EQ(1U, adaptor.misses());
+  EXPECT_DOUBLE_EQ(2.0 / 3.0, adaptor.hit_rate());
+  EXPECT_THROW(proposed::detail::adapt_to<std::string>(adaptor, "throw"sv),
+               std::invalid_argument);
+  EXPECT_EQ(1U, adaptor.size());
+  adaptor.clear();
+  EXPECT_EQ(0U, adaptor.size());
+  EXPECT_EQ("HELLO"s, proposed::detail::adapt_to<std::string>(
+                          adaptor, "hello"sv));
+  EXPECT_EQ(3, counting_upper::calls);
+}
+
+TEST(ProposedCachingAdaptor, EvictsUnreferencedFirst) {
+  counting_upper::calls = 0;
+  proposed::caching_adaptor<counting_upper, 2> adaptor;
+  auto adapt = [&](std::string_view input) {
+    return proposed::detail::adapt_to<std::string>(adaptor, input);
+  };
+  adapt("a");
+  adapt("b");
+  adapt("a");  // "a" is now referenced, so "b" goes first
+  adapt("c");
+  EXPECT_EQ(3, counting_upper::calls);
+  adapt("a");
+  EXPECT_EQ(3, counting_upper::calls);
+  adapt("b");
+  EXPECT_EQ(4, counting_upper::calls);
+  EXPECT_EQ(2U, adaptor.size());
+}
+
+TEST(ProposedCachingAdaptor, KeysAContainer) {
+  counting_upper::calls = 0;
+  proposed::map<std::string,
+                int,
+                std::less<>,
+                std::allocator<std::pair<const std::string, int>>,
+                proposed::caching_adaptor<counting_upper>>
+      testMap;
+  for (int round = 0; round < 3; ++round) {
+    testMap.try_emplace("one"sv, round);
+    testMap.erase("ONE"sv);
+  }
+  EXPECT_EQ(1, counting_upper::calls);
+  EXPECT_TRUE(testMap.empty());
+}
@@ -0,0 +1,110 @@
+#include <proposed/from_chars>
+#include <proposed/map>
+#include <proposed/set>
+#include <proposed/unordered_set>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::literals;
+
+namespace {
+template <typename Adaptor>
+typename Adaptor::target_type parse(std::string_view text) {
+  Adaptor adaptor;
+  return proposed::detail::adapt_to<typename Adaptor::target_type>(adaptor,
+                                                                   text);
+}
+}  // namespace
+
+TEST(ProposedFromCharsAdaptor, ParsesIntegers) {
+  using int64_adaptor = proposed::decimal_adaptor<std::int64_t>;
+  EXPECT_EQ(0, parse<int64_adaptor>("0"));
+  EXPECT_EQ(12345, parse<int64_adaptor>("12345"));
+  EXPECT_EQ(-12345678, parse<int64_adaptor>("-12345678"));
+  EXPECT_EQ(1234567890123456789, parse<int64_adaptor>("1234567890123456789"));
+  EXPECT_EQ(std::numeric_limits<std::int64_t>::min(),
+            parse<int64_adaptor>("-9223372036854775808"));
+  EXPECT_EQ(std::numeric_limits<std::int64_t>::max(),
+            parse<int64_adaptor>("0009223372036854775807"));
+  EXPECT_THROW(parse<int64_adaptor>("9223372036854775808"), std::out_of_range);
+  EXPECT_THROW(parse<int64_adaptor>("99999999999999999999"),
+               std::out_of_range);
+  EXPECT_THROW(parse<int64_adaptor>(""), std::invalid_argument);
+  EXPECT_THROW(parse<int64_adaptor>("-"), std::invalid_argument);
+  EXPECT_THROW(parse<int64_adaptor>("+1"), std::invalid_argument);
+  EXPECT_THROW(parse<int64_adaptor>("1234567a"), std::invalid_argument);
+  EXPECT_THROW(parse<int64_adaptor>("12345678 "), std::invalid_argument);
+  EXPECT_THROW(parse<int64_adaptor>("12:45678"), std::invalid_argument);
+
+  EXPECT_EQ(18446744073709551615u,
+            parse<proposed::decimal_adaptor<std::uint64_t>>(
+                "18446744073709551615"));
+  EXPECT_THROW(parse<proposed::decimal_adaptor<std::uint32_t>>("-1"),
+               std::invalid_argument);
+  EXPECT_EQ(-128, parse<proposed::decimal_adaptor<std::int8_t>>("-128"));
+  EXPECT_THROW(parse<proposed::decimal_adaptor<std::int8_t>>("128"),
+               std::out_of_range);
+  EXPECT_EQ(0xdeadbeefu,
+            parse<proposed::hex_adaptor<std::uint32_t>>("DeadBeef"));
+}
+
+TEST(ProposedFromCharsAdaptor, ParsesFloatingPoint) {
+  EXPECT_EQ(1500.0, parse<proposed::decimal_adaptor<double>>("1.5e3"));
+  EXPECT_EQ(-0.25, parse<proposed::decimal_adaptor<double>>("-0.25"));
+  EXPECT_EQ(3.0, parse<proposed::hex_adaptor<double>>("1.8p1"));
+  EXPECT_THROW(parse<proposed::decimal_adaptor<double>>("1.5x"),
+               std::invalid_argument);
+  EXPECT_THROW(parse<proposed::decimal_adaptor<float>>("1e100"),
+               std::out_of_range);
+}
+
+TEST(ProposedFromCharsAdaptor, KeysContainers) {
+  proposed::map<std::int64_t,
+                std::string,
+                proposed::from_chars_less<std::int64_t>,
+                std::allocator<std::pair<const std::int64_t, std::string>>,
+                proposed::decimal_adaptor<std::int64_t>>
+      testMap;
+  EXPECT_TRUE(testMap.try_emplace("12345"sv, "first").second);
+  EXPECT_FALSE(testMap.try_emplace("012345"sv, "second").second);
+  EXPECT_TRUE(testMap.try_emplace(-7, "third").second);
+  EXPECT_EQ("first"s, testMap.at(12345));
+  EXPECT_EQ("third"s, testMap.at("-7"sv));
+  EXPECT_THROW(testMap.try_emplace("twelve"sv, "fourth"),
+               std::invalid_argument);
+  EXPECT_EQ(2U, testMap.size());
+
+  proposed::set<double,
+                proposed::from_chars_less<double>,
+                std::allocator<double>,
+                proposed::decimal_adaptor<double>>
+      testSet;
+  testSet.insert("2.5"sv);
+  testSet.insert("0.25e1"sv);
+  testSet.insert("-1"sv);
+  EXPECT_EQ((std::vector<double>{-1.0, 2.5}),
+            std::vector<double>(testSet.begin(), testSet.end()));
+}
+
+TEST(ProposedFromCharsAdaptor, BulkLoads) {
+  std::vector<std::string> const text{"3", "1", "4", "1", "5", "9", "2", "6"};
+  using int_adaptor = proposed::decimal_adaptor<int>;
+  static_assert(
+      proposed::adaptor_traits<int_adaptor>::adapts_n<std::string>);
+  proposed::unordered_set<int,
+                          proposed::from_chars_hash<int>,
+                          proposed::from_chars_equal<int>,
+                          std::allocator<int>,
+                          int_adaptor>
+      testSet;
+  testSet.insert(proposed::adapt_input_iterator<int_adaptor>(text.begin()),
+                 proposed::adapt_input_iterator<int_adaptor>(text.end()));
+  EXPECT_EQ(7U, testSet.size());
+  EXPECT_EQ(1U, testSet.count("9"sv));
+  EXPECT_EQ(0U, testSet.count(7));
+}
@@ -0,0 +1,242 @@
+#include <proposed/btree_map>
+#include <proposed/concurrent_map>
+#include <proposed/flat_set>
+#include <proposed/map>
+#include <proposed/persistent_map>
+#include <proposed/set>
+#include <proposed/string>
+#include <proposed/string_interner>
+#include <proposed/unordered_set>
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::literals;
+
+namespace {
+// A fixed arena with nothing behind it, and with the default resource made
+// to fail too: any allocation that doesn't come from the container's own
+// allocator throws, and any that does can be seen to land in `buffer`
+struct arena {
+  arena() : previous(std::pmr::set_default_resource(
+                std::pmr::null_memory_resource())) {}
+  ~arena() { std::pmr::set_default_resource(previous); }
+
+  bool holds(void const* p) const {
+    auto const* byte = static_cast<std::byte const*>(p);
+    return byte >= buffer && byte < buffer + sizeof(buffer);
+  }
+
+  std::pmr::memory_resource* previous;
+  alignas(std::max_align_t) std::byte buffer[1 << 18];
+  std::pmr::monotonic_buffer_resource resource{
+      buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+};
+
+// Long enough not to fit in a small string
+std::string key(int i) {
+  return "a-longish-key-" + std::to_string(1000000 + i);
+}
+
+using c_string_adaptor = proposed::chain_adaptor<
+    proposed::constructible_adaptor<std::string_view>,
+    proposed::pmr::string_adaptor>;
+
+using string_allocator = std::pmr::polymorphic_allocator<std::pmr::string>;
+static_assert(proposed::detail::has_adapt_n_using_allocator<
+              proposed::pmr::string_adaptor,
+              std::string_view,
+              string_allocator>::value);
+static_assert(proposed::detail::has_adapt_n_using_allocator<
+              c_string_adaptor,
+              char const*,
+              string_allocator>::value);
+
+// Records the size of each batch it builds with an allocator
+struct batch_string_adaptor : proposed::pmr::string_adaptor {
+  template <typename Alloc>
+  void adapt_n(target_type* out,
+               std::string_view const* in,
+               std::size_t n,
+               Alloc const& alloc) {
+    batches.push_back(n);
+    proposed::pmr::string_adaptor::adapt_n(out, in, n, alloc);
+  }
+  static inline std::vector<std::size_t> batches;
+};
+}  // namespace
+
+TEST(ProposedPmr, SetKeys) {
+  arena memory;
+  proposed::pmr::
+      set<std::pmr::string, std::less<>, proposed::pmr::string_adaptor>
+          testSet{&memory.resource};
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(testSet.insert(std::string_view{key(i)}).second);
+  }
+  EXPECT_FALSE(testSet.insert(std::string_view{key(0)}).second);
+  for (auto const& element : testSet) {
+    EXPECT_TRUE(memory.holds(element.data()));
+  }
+}
+
+TEST(ProposedPmr, MapKeysAndValues) {
+  arena memory;
+  proposed::pmr::map<std::pmr::string,
+                     std::pmr::string,
+                     std::less<>,
+                     proposed::pmr::string_adaptor>
+      testMap{&memory.resource};
+  for (int i = 0; i < 100; ++i) {
+    testMap.try_emplace(std::string_view{key(i)}, "a-longish-mapped-value");
+  }
+  EXPECT_EQ(100U, testMap.size());
+  for (auto const& element : testMap) {
+    EXPECT_TRUE(memory.holds(element.first.data()));
+    EXPECT_TRUE(memory.holds(element.second.data()));
+  }
+}
+
+TEST(ProposedPmr, FlatAndBtree) {
+  arena memory;
+  proposed::pmr::
+      flat_set<std::pmr::string, std::less<>, proposed::pmr::string_adaptor>
+          flatSet{&memory.resource};
+  proposed::pmr::btree_map<std::pmr::string, int, std::less<>, c_string_adaptor>
+      btreeMap{&memory.resource};
+  for (int i = 0; i < 100; ++i) {
+    auto const text = key(i);
+    flatSet.insert(std::string_view{text});
+    btreeMap.try_emplace(text.c_str(), i);
+  }
+  for (auto const& element : flatSet) {
+    EXPECT_TRUE(memory.holds(element.data()));
+  }
+  for (auto const& element : btreeMap) {
+    EXPECT_TRUE(memory.holds(element.first.data()));
+  }
+  EXPECT_EQ(42, btreeMap.at(std::string_view{key(42)}));
+}
+
+TEST(ProposedPmr, UnorderedSet) {
+  arena memory;
+  proposed::pmr::unordered_set<std::pmr::string,
+                               proposed::transparent_string_hash,
+                               proposed::transparent_string_equal,
+                               proposed::pmr::string_adaptor>
+      testSet{&memory.resource};
+  for (int i = 0; i < 100; ++i) {
+    testSet.insert(std::string_view{key(i)});
+  }
+  EXPECT_EQ(1U, testSet.count(std::string_view{key(99)}));
+  for (auto const& element : testSet) {
+    EXPECT_TRUE(memory.holds(element.data()));
+  }
+}
+
+TEST(ProposedPmr, RangeInsertAdapted) {
+  std::vector<std::string> texts;
+  for (int i = 0; i < 40; ++i) {
+    texts.push_back(key(i));
+  }
+  std::vector<std::string_view> const views(texts.begin(), texts.end());
+  std::vector<char const*> pointers;
+  for (auto const& text : texts) {
+    pointers.push_back(text.c_str());
+  }
+  auto adapted = [](auto it) {
+    return proposed::adapt_input_iterator<proposed::pmr::string_adaptor>(it);
+  };
+
+  arena memory;
+  auto inArena = [&memory](auto const& container) {
+    EXPECT_EQ(40U, container.size());
+    for (auto const& element : container) {
+      EXPECT_TRUE(memory.holds(element.data()));
+    }
+  };
+  proposed::pmr::
+      set<std::pmr::string, std::less<>, proposed::pmr::string_adaptor>
+          testSet{&memory.resource};
+  testSet.insert(adapted(views.begin()), adapted(views.end()));
+  inArena(testSet);
+  proposed::pmr::
+      flat_set<std::pmr::string, std::less<>, proposed::pmr::string_adaptor>
+          flatSet{&memory.resource};
+  flatSet.insert(std::make_move_iterator(adapted(views.data())),
+                 std::make_move_iterator(adapted(views.data() + 40)));
+  inArena(flatSet);
+  proposed::pmr::unordered_set<std::pmr::string,
+                               proposed::transparent_string_hash,
+                               proposed::transparent_string_equal,
+                               proposed::pmr::string_adaptor>
+      unorderedSet{&memory.resource};
+  unorderedSet.insert(adapted(views.begin()), adapted(views.end()));
+  inArena(unorderedSet);
+  // Through a chain, whose last link alone gets the allocator
+  proposed::pmr::set<std::pmr::string, std::less<>, c_string_adaptor>
+      chainedSet{&memory.resource};
+  chainedSet.insert(
+      proposed::adapt_input_iterator<c_string_adaptor>(pointers.begin()),
+      proposed::adapt_input_iterator<c_string_adaptor>(pointers.end()));
+  inArena(chainedSet);
+}
+
+TEST(ProposedPmr, RangeInsertAdaptedInBatches) {
+  std::vector<std::string> texts;
+  for (int i = 0; i < 40; ++i) {
+    texts.push_back(key(i));
+  }
+  std::vector<std::string_view> const views(texts.begin(), texts.end());
+
+  arena memory;
+  batch_string_adaptor::batches.clear();
+  proposed::pmr::set<std::pmr::string, std::less<>, batch_string_adaptor>
+      testSet{&memory.resource};
+  testSet.insert(
+      proposed::adapt_input_iterator<batch_string_adaptor>(views.data()),
+      proposed::adapt_input_iterator<batch_string_adaptor>(views.data() + 40));
+  EXPECT_EQ((std::vector<std::size_t>{32, 8}), batch_string_adaptor::batches);
+  EXPECT_EQ(40U, testSet.size());
+  for (auto const& element : testSet) {
+    EXPECT_TRUE(memory.holds(element.data()));
+  }
+}
+
+TEST(ProposedPmr, ConcurrentAndPersistentMaps) {
+  arena memory;
+  proposed::pmr::concurrent_map<std::pmr::string,
+                                int,
+                                std::less<>,
+                                proposed::pmr::string_adaptor>
+      concurrentMap{&memory.resource};
+  proposed::pmr::persistent_map<std::pmr::string,
+                                int,
+                                std::less<>,
+                                proposed::pmr::string_adaptor>
+      persistentMap{&memory.resource};
+  for (int i = 0; i < 100; ++i) {
+    auto const text = key(i);
+    concurrentMap.try_emplace(std::string_view{text}, i);
+    persistentMap = persistentMap.try_emplace(std::string_view{text}, i);
+  }
+  for (auto const& element : concurrentMap) {
+    EXPECT_TRUE(memory.holds(element.first.data()));
+  }
+  for (auto const& element : persistentMap) {
+    EXPECT_TRUE(memory.holds(element.first.data()));
+  }
+  EXPECT_EQ(7, persistentMap.at(std::string_view{key(7)}));
+}
+
+TEST(ProposedPmr, StringInterner) {
+  arena memory;
+  proposed::pmr::string_interner<4> interner{
+      proposed::transparent_string_hash{}, &memory.resource};
+  auto const hello = interner.intern(key(1));
+  EXPECT_EQ(hello, interner.intern(key(1)));
+  EXPECT_TRUE(memory.holds(interner.view(hello).data()));
+}
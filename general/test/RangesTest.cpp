@@ -0,0 +1,97 @@
+#include <proposed/flat_set>
+#include <proposed/ranges>
+#include <proposed/set>
+#include <proposed/string>
+#include <proposed/unordered_set>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::literals;
+
+namespace {
+// Counts the strings it builds
+struct counting_string_adaptor {
+  using target_type = std::string;
+  template <typename X>
+  static bool constexpr adapts{std::is_same_v<X, std::string_view>};
+
+  void operator()(target_type* pResult, std::string_view input) {
+    ++built;
+    ::new (static_cast<void*>(pResult)) target_type(input);
+  }
+  static inline int built = 0;
+};
+
+using moving_adaptor =
+    proposed::union_adaptor<proposed::constructible_adaptor<std::string>>;
+
+std::vector<std::string_view> const kWords{"one", "two", "three", "four",
+                                           "five"};
+}  // namespace
+
+TEST(ProposedRanges, AdaptsLazily) {
+  counting_string_adaptor::built = 0;
+  auto adapted = kWords | proposed::views::adapt<counting_string_adaptor>;
+  static_assert(std::ranges::random_access_range<decltype(adapted)>);
+  static_assert(std::ranges::sized_range<decltype(adapted)>);
+  static_assert(std::is_same_v<std::string,
+                               std::ranges::range_reference_t<
+                                   decltype(adapted)>>);
+  EXPECT_EQ(0, counting_string_adaptor::built);
+  EXPECT_EQ(5U, adapted.size());
+  EXPECT_EQ("three"s, adapted[2]);
+  EXPECT_EQ(1, counting_string_adaptor::built);
+}
+
+TEST(ProposedRanges, ComposesWithStandardViews) {
+  auto longWords =
+      kWords | std::views::filter([](auto word) { return word.size() > 3; }) |
+      proposed::views::adapt<proposed::string_adaptor> |
+      std::views::transform([](std::string word) { return word + "!"; });
+  std::vector<std::string> result(longWords.begin(), longWords.end());
+  EXPECT_EQ((std::vector<std::string>{"three!", "four!", "five!"}), result);
+
+  auto lengths =
+      proposed::views::adapt<proposed::string_adaptor>(kWords) |
+      std::views::transform([](std::string word) { return word.size(); });
+  EXPECT_EQ(19U, std::accumulate(lengths.begin(), lengths.end(),
+                                 std::size_t{0}));
+}
+
+TEST(ProposedRanges, MovesFromRvalueSources) {
+  std::vector<std::string> sources(3, std::string(100, 'x'));
+  auto moved = std::ranges::subrange(std::make_move_iterator(sources.begin()),
+                                     std::make_move_iterator(sources.end())) |
+               proposed::views::adapt<moving_adaptor>;
+  auto result = proposed::ranges::to<std::vector<std::string>>(moved);
+  EXPECT_EQ(std::string(100, 'x'), result[2]);
+  for (auto const& source : sources) {
+    EXPECT_TRUE(source.empty());
+  }
+}
+
+TEST(ProposedRanges, BuildsContainers) {
+  auto adapted = kWords | proposed::views::adapt<proposed::string_adaptor>;
+  auto unordered = proposed::ranges::to<
+      proposed::unordered_set<std::string, proposed::transparent_string_hash,
+                              proposed::transparent_string_equal>>(adapted);
+  EXPECT_EQ(5U, unordered.size());
+  EXPECT_EQ(1U, unordered.count("four"sv));
+
+  auto flat = proposed::ranges::to<proposed::flat_set<std::string>>(adapted);
+  EXPECT_EQ("five"s, *flat.begin());
+  // Sized up front, where inserting input iterators alone would have grown
+  // it geometrically
+  EXPECT_EQ(5U, flat.capacity());
+
+  proposed::set<std::string> ordered;
+  proposed::ranges::insert_range(
+      ordered, kWords | std::views::reverse |
+                   proposed::views::adapt<proposed::string_adaptor>);
+  EXPECT_EQ(5U, ordered.size());
+}
@@ -0,0 +1,70 @@
+#include <proposed/string>
+#include <proposed/unordered_set>
+#include <gtest/gtest.h>
+#include <set>
+
+using namespace std::literals;
+
+TEST(TransparentStringHash, AllSpellingsHashEqually) {
+  proposed::transparent_string_hash hash{};
+  char const* kHello = "Hello";
+  EXPECT_EQ(hash("Hello"s), hash("Hello"sv));
+  EXPECT_EQ(hash("Hello"s), hash(kHello));
+  EXPECT_EQ(hash(""s), hash(""sv));
+  EXPECT_NE(hash("Hello"sv), hash("hello"sv));
+}
+
+TEST(TransparentStringHash, EveryLength) {
+  // Exercise each of the short, medium and 48-byte-block code paths, and check
+  // that no length collides with its neighbour.
+  proposed::transparent_string_hash hash{};
+  std::string input;
+  std::set<std::size_t> seen;
+  for (std::size_t length = 0; length <= 200; ++length) {
+    EXPECT_EQ(hash(input), hash(std::string_view{input}));
+    EXPECT_TRUE(seen.insert(hash(input)).second) << "length " << length;
+    input.push_back(static_cast<char>('a' + length % 26));
+  }
+}
+
+TEST(TransparentStringHash, SingleBitSensitivity) {
+  proposed::transparent_string_hash hash{};
+  for (std::size_t length : {1U, 3U, 4U, 8U, 16U, 17U, 48U, 49U, 4096U}) {
+    std::string input(length, 'x');
+    auto const base = hash(input);
+    for (std::size_t position = 0; position < length;
+         position += 1 + length / 16) {
+      auto flipped = input;
+      flipped[position] ^= 1;
+      EXPECT_NE(base, hash(flipped)) << length << "@" << position;
+    }
+  }
+}
+
+TEST(TransparentStringHash, WideCharacters) {
+  proposed::transparent_u16string_hash hash{};
+  EXPECT_EQ(hash(u"Hello"s), hash(u"Hello"sv));
+  EXPECT_EQ(hash(u"Hello"s), hash(u"Hello"));
+  EXPECT_NE(hash(u"Hello"sv), hash(u"Hellp"sv));
+}
+
+TEST(TransparentStringEqual, MixedOperands) {
+  proposed::transparent_string_equal equal{};
+  EXPECT_TRUE(equal("Hello"s, "Hello"sv));
+  EXPECT_TRUE(equal("Hello", "Hello"s));
+  EXPECT_FALSE(equal("Hello"sv, "World"));
+}
+
+TEST(TransparentStringHash, InUnorderedSet) {
+  proposed::unordered_set<std::string,
+                          proposed::transparent_string_hash,
+                          proposed::transparent_string_equal,
+                          std::allocator<std::string>,
+                          proposed::string_adaptor>
+      testSet{};
+  testSet.insert("Hello"sv);
+  testSet.insert("World"s);
+  EXPECT_EQ(1U, testSet.count("Hello"));
+  EXPECT_EQ(1U, testSet.count("World"sv));
+  EXPECT_EQ(0U, testSet.count("Set"s));
+}
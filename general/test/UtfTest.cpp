@@ -0,0 +1,142 @@
+#include <proposed/map>
+#include <proposed/string>
+#include <proposed/unordered_set>
+#include <proposed/utf>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace std::literals;
+
+namespace {
+template <typename Adaptor, typename X>
+typename Adaptor::target_type transcode(X const& input) {
+  Adaptor adaptor;
+  return proposed::detail::adapt_to<typename Adaptor::target_type>(adaptor,
+                                                                   input);
+}
+
+// ASCII long enough to take the fast path, then a character from each
+// range of UTF-8 lengths, then ASCII again
+std::u32string mixed32() {
+  std::u32string result(40, U'a');
+  result += U"éЖ€中\U0001F600\U0010FFFF";
+  result += std::u32string(20, U'z');
+  return result;
+}
+std::u16string mixed16() {
+  std::u16string result(40, u'a');
+  result += u"éЖ€中\U0001F600\U0010FFFF";
+  result += std::u16string(20, u'z');
+  return result;
+}
+std::string mixed8() {
+  std::string result(40, 'a');
+  result += "\xc3\xa9\xd0\x96\xe2\x82\xac\xe4\xb8\xad\xf0\x9f\x98\x80"
+            "\xf4\x8f\xbf\xbf";
+  result += std::string(20, 'z');
+  return result;
+}
+}  // namespace
+
+static_assert(proposed::utf16_adaptor::adapts<std::string_view>);
+static_assert(proposed::utf16_adaptor::adapts<std::u32string_view>);
+static_assert(!proposed::utf16_adaptor::adapts<std::u16string_view>);
+static_assert(!proposed::utf16_adaptor::adapts<std::string>);
+static_assert(!proposed::utf8_adaptor::adapts<char const*>);
+
+TEST(ProposedUtfAdaptor, RoundTrips) {
+  EXPECT_EQ(mixed16(), transcode<proposed::utf16_adaptor>(
+                           std::string_view{mixed8()}));
+  EXPECT_EQ(mixed32(), transcode<proposed::utf32_adaptor>(
+                           std::string_view{mixed8()}));
+  EXPECT_EQ(mixed8(), transcode<proposed::utf8_adaptor>(
+                          std::u16string_view{mixed16()}));
+  EXPECT_EQ(mixed8(), transcode<proposed::utf8_adaptor>(
+                          std::u32string_view{mixed32()}));
+  EXPECT_EQ(mixed32(), transcode<proposed::utf32_adaptor>(
+                           std::u16string_view{mixed16()}));
+  EXPECT_EQ(mixed16(), transcode<proposed::utf16_adaptor>(
+                           std::u32string_view{mixed32()}));
+  EXPECT_EQ(u""s, transcode<proposed::utf16_adaptor>(""sv));
+  // Sized exactly, with no room left over
+  auto const exact =
+      transcode<proposed::utf16_adaptor>(std::string_view{mixed8()});
+  EXPECT_EQ(mixed16().size(), exact.size());
+}
+
+TEST(ProposedUtfAdaptor, RejectsInvalidInput) {
+  auto const invalid8 = {
+      "\x80"sv,              // continuation byte with no lead
+      "\xc0\xaf"sv,          // overlong '/'
+      "\xe0\x80\xaf"sv,      // overlong '/'
+      "\xed\xa0\x80"sv,      // a surrogate
+      "\xf4\x90\x80\x80"sv,  // past U+10FFFF
+      "\xe2\x82"sv,          // truncated
+      "\xe2\x82z"sv,         // truncated
+      "\xff"sv,
+  };
+  for (auto input : invalid8) {
+    std::string const padded = std::string(32, 'a') + std::string(input);
+    EXPECT_THROW(transcode<proposed::utf16_adaptor>(input), std::range_error);
+    EXPECT_THROW(transcode<proposed::utf32_adaptor>(std::string_view{padded}),
+                 std::range_error);
+  }
+  EXPECT_THROW(transcode<proposed::utf8_adaptor>(u"a\xd800"sv),
+               std::range_error);
+  EXPECT_THROW(transcode<proposed::utf8_adaptor>(u"\xdc00z"sv),
+               std::range_error);
+  EXPECT_THROW(transcode<proposed::utf32_adaptor>(u"\xd800\xd800"sv),
+               std::range_error);
+  EXPECT_THROW(transcode<proposed::utf8_adaptor>(U"\xd800"sv),
+               std::range_error);
+  EXPECT_THROW(transcode<proposed::utf16_adaptor>(U"\x110000"sv),
+               std::range_error);
+}
+
+TEST(ProposedUtfAdaptor, KeysContainers) {
+  proposed::unordered_set<std::u16string,
+                          proposed::utf16_hash,
+                          proposed::utf16_equal,
+                          std::allocator<std::u16string>,
+                          proposed::utf16_adaptor>
+      testSet;
+  EXPECT_TRUE(testSet.insert("caf\xc3\xa9"sv).second);
+  EXPECT_FALSE(testSet.insert(u"café"s).second);
+  EXPECT_EQ(1U, testSet.count(u"café"sv));
+  EXPECT_EQ(1U, testSet.count(U"café"sv));
+  EXPECT_THROW(testSet.insert("\xc0\xaf"sv), std::range_error);
+  EXPECT_EQ(1U, testSet.size());
+
+  // Views in the key's own encoding are copied rather than transcoded
+  proposed::map<std::u32string,
+                int,
+                proposed::utf32_less,
+                std::allocator<std::pair<const std::u32string, int>>,
+                proposed::union_adaptor<proposed::u32string_adaptor,
+                                        proposed::utf32_adaptor>>
+      testMap;
+  testMap.try_emplace("\xe4\xb8\xad"sv, 1);
+  testMap.try_emplace(u"中"sv, 2);
+  testMap.try_emplace(U"文"sv, 3);
+  EXPECT_EQ(2U, testMap.size());
+  EXPECT_EQ(1, testMap.at(U"中"sv));
+  EXPECT_EQ(3, testMap.at("\xe6\x96\x87"sv));
+}
+
+TEST(ProposedUtfAdaptor, UsesContainerAllocator) {
+  alignas(std::max_align_t) std::byte buffer[4096];
+  std::pmr::monotonic_buffer_resource resource{
+      buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+  proposed::pmr::unordered_set<std::pmr::u16string,
+                               proposed::utf16_hash,
+                               proposed::utf16_equal,
+                               proposed::pmr::utf16_adaptor>
+      testSet{&resource};
+  testSet.insert(std::string_view{mixed8()});
+  auto const* data =
+      reinterpret_cast<std::byte const*>(testSet.begin()->data());
+  EXPECT_TRUE(data >= buffer && data < buffer + sizeof(buffer));
+}
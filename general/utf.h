@@ -0,0 +1,496 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <proposed/adaptor>
+#include <proposed/string>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace proposed {
+namespace detail {
+// Character types are taken to hold UTF-8, UTF-16 or UTF-32 by their size,
+// so `wchar_t` is UTF-16 or UTF-32 as the platform has it
+template <typename C>
+inline constexpr bool is_utf_unit_v{
+    std::is_same_v<C, char> || std::is_same_v<C, wchar_t> ||
+#if defined(__cpp_char8_t)
+    std::is_same_v<C, char8_t> ||
+#endif
+    std::is_same_v<C, char16_t> || std::is_same_v<C, char32_t>};
+
+// Whether a `basic_string_view` `X` can be transcoded to UTF-`To`
+template <typename To, typename X>
+struct transcodes_to : std::false_type {};
+template <typename To, typename From, typename Traits>
+struct transcodes_to<To, std::basic_string_view<From, Traits>>
+    : std::bool_constant<is_utf_unit_v<To> && is_utf_unit_v<From> &&
+                         sizeof(To) != sizeof(From)> {};
+
+template <typename C>
+std::uint32_t utf_unit(C c) noexcept {
+  return static_cast<std::make_unsigned_t<C>>(c);
+}
+
+template <typename C>
+[[noreturn]] void invalid_utf() {
+  if constexpr (sizeof(C) == 1) {
+    throw std::range_error{"Invalid UTF-8"};
+  } else if constexpr (sizeof(C) == 2) {
+    throw std::range_error{"Invalid UTF-16"};
+  } else {
+    throw std::range_error{"Invalid UTF-32"};
+  }
+}
+
+// How many units at a time the portable fast paths test
+inline constexpr std::size_t kUtfBlock = 8;
+
+// Whether the `kUtfBlock` units at `in` all mean the same in both
+// encodings: ASCII, or for UTF-16 and UTF-32 everything below the
+// surrogates
+template <typename To, typename From>
+bool unchanged_block(From const* in) noexcept {
+  if constexpr (sizeof(From) == 1) {
+    std::uint64_t block;
+    std::memcpy(&block, in, sizeof(block));
+    return (block & 0x8080808080808080ull) == 0;
+  } else {
+    constexpr std::uint32_t kLimit = sizeof(To) == 1 ? 0x80 : 0xD800;
+    std::uint32_t highest = 0;
+    for (std::size_t k = 0; k < kUtfBlock; ++k) {
+      highest |= utf_unit(in[k]);
+    }
+    // Or-ing can only overstate the highest unit
+    return highest < kLimit;
+  }
+}
+
+// What the unit `c` adds to the length in `To` of valid input
+template <typename To, typename From>
+std::size_t utf_units_for(From c) noexcept {
+  auto const u = utf_unit(c);
+  if constexpr (sizeof(From) == 1) {
+    // Lead bytes count, continuation bytes don't; four-byte sequences need
+    // a surrogate pair in UTF-16
+    return ((u & 0xC0) != 0x80) + (sizeof(To) == 2 && u >= 0xF0);
+  } else if constexpr (sizeof(From) == 2) {
+    bool const surrogate = u >= 0xD800 && u <= 0xDFFF;
+    if constexpr (sizeof(To) == 1) {
+      // A surrogate pair is four bytes, two for each half
+      return 1 + (u >= 0x80) + (u >= 0x800) - surrogate;
+    } else {
+      return !(surrogate && u >= 0xDC00);
+    }
+  } else if constexpr (sizeof(To) == 1) {
+    return 1 + (u >= 0x80) + (u >= 0x800) + (u >= 0x10000);
+  } else {
+    return 1 + (u >= 0x10000);
+  }
+}
+
+// The number of `To` units the `n` units at `in` transcode to, if they are
+// valid. Invalid input may count high or low, but never lower than what
+// `transcode_utf` writes before it finds the error.
+template <typename To, typename From>
+std::size_t utf_length(From const* in, std::size_t n) noexcept {
+  std::size_t length = 0;
+  std::size_t i = 0;
+  for (; n - i >= kUtfBlock; i += kUtfBlock) {
+    if (unchanged_block<To>(in + i)) {
+      length += kUtfBlock;
+    } else {
+      for (std::size_t k = 0; k < kUtfBlock; ++k) {
+        length += utf_units_for<To>(in[i + k]);
+      }
+    }
+  }
+  for (; i < n; ++i) {
+    length += utf_units_for<To>(in[i]);
+  }
+  return length;
+}
+
+// Decodes and validates the code point at `in[i]`, moving `i` past it
+template <typename From>
+char32_t decode_utf(From const* in, std::size_t n, std::size_t& i) {
+  auto const lead = utf_unit(in[i]);
+  if constexpr (sizeof(From) == 1) {
+    if (lead < 0x80) {
+      ++i;
+      return lead;
+    }
+    // The range allowed for the second byte rules out overlong forms,
+    // surrogates and anything past U+10FFFF
+    std::size_t length;
+    std::uint32_t low = 0x80;
+    std::uint32_t high = 0xBF;
+    std::uint32_t result;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+      length = 2;
+      result = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+      length = 3;
+      result = lead & 0x0F;
+      low = lead == 0xE0 ? 0xA0 : low;
+      high = lead == 0xED ? 0x9F : high;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+      length = 4;
+      result = lead & 0x07;
+      low = lead == 0xF0 ? 0x90 : low;
+      high = lead == 0xF4 ? 0x8F : high;
+    } else {
+      invalid_utf<From>();
+    }
+    if (n - i < length) {
+      invalid_utf<From>();
+    }
+    for (std::size_t k = 1; k < length; ++k) {
+      auto const next = utf_unit(in[i + k]);
+      if (next < low || next > high) {
+        invalid_utf<From>();
+      }
+      low = 0x80;
+      high = 0xBF;
+      result = (result << 6) | (next & 0x3F);
+    }
+    i += length;
+    return result;
+  } else if constexpr (sizeof(From) == 2) {
+    if (lead < 0xD800 || lead > 0xDFFF) {
+      ++i;
+      return lead;
+    }
+    if (lead > 0xDBFF || n - i < 2) {
+      invalid_utf<From>();
+    }
+    auto const trail = utf_unit(in[i + 1]);
+    if (trail < 0xDC00 || trail > 0xDFFF) {
+      invalid_utf<From>();
+    }
+    i += 2;
+    return 0x10000 + ((lead - 0xD800) << 10) + (trail - 0xDC00);
+  } else {
+    if (lead > 0x10FFFF || (lead >= 0xD800 && lead <= 0xDFFF)) {
+      invalid_utf<From>();
+    }
+    ++i;
+    return lead;
+  }
+}
+
+// Encodes the valid code point `c` at `out`, returning the end of it
+template <typename To>
+To* encode_utf(To* out, char32_t c) noexcept {
+  if constexpr (sizeof(To) == 1) {
+    if (c < 0x80) {
+      *out++ = static_cast<To>(c);
+    } else if (c < 0x800) {
+      *out++ = static_cast<To>(0xC0 | (c >> 6));
+      *out++ = static_cast<To>(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+      *out++ = static_cast<To>(0xE0 | (c >> 12));
+      *out++ = static_cast<To>(0x80 | ((c >> 6) & 0x3F));
+      *out++ = static_cast<To>(0x80 | (c & 0x3F));
+    } else {
+      *out++ = static_cast<To>(0xF0 | (c >> 18));
+      *out++ = static_cast<To>(0x80 | ((c >> 12) & 0x3F));
+      *out++ = static_cast<To>(0x80 | ((c >> 6) & 0x3F));
+      *out++ = static_cast<To>(0x80 | (c & 0x3F));
+    }
+  } else if constexpr (sizeof(To) == 2) {
+    if (c < 0x10000) {
+      *out++ = static_cast<To>(c);
+    } else {
+      *out++ = static_cast<To>(0xD800 + ((c - 0x10000) >> 10));
+      *out++ = static_cast<To>(0xDC00 + ((c - 0x10000) & 0x3FF));
+    }
+  } else {
+    *out++ = static_cast<To>(c);
+  }
+  return out;
+}
+
+// Copies the run of units at the front of `in` that mean the same in both
+// encodings, a whole block at a time, returning how many it copied. This is
+// the fast path: SSE2 where there is one, `unchanged_block` elsewhere.
+template <typename To, typename From>
+std::size_t copy_unchanged(To* out, From const* in, std::size_t n) noexcept {
+  std::size_t i = 0;
+#if defined(__SSE2__)
+  if constexpr (sizeof(From) == 1) {
+    auto const zero = _mm_setzero_si128();
+    for (; n - i >= 16; i += 16) {
+      auto const bytes =
+          _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+      if (_mm_movemask_epi8(bytes) != 0) {
+        break;
+      }
+      auto const low = _mm_unpacklo_epi8(bytes, zero);
+      auto const high = _mm_unpackhi_epi8(bytes, zero);
+      auto* const store = reinterpret_cast<__m128i*>(out + i);
+      if constexpr (sizeof(To) == 2) {
+        _mm_storeu_si128(store, low);
+        _mm_storeu_si128(store + 1, high);
+      } else {
+        _mm_storeu_si128(store, _mm_unpacklo_epi16(low, zero));
+        _mm_storeu_si128(store + 1, _mm_unpackhi_epi16(low, zero));
+        _mm_storeu_si128(store + 2, _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128(store + 3, _mm_unpackhi_epi16(high, zero));
+      }
+    }
+  } else if constexpr (sizeof(From) == 2 && sizeof(To) == 1) {
+    auto const zero = _mm_setzero_si128();
+    auto const nonAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+    for (; n - i >= 16; i += 16) {
+      auto const* const load = reinterpret_cast<__m128i const*>(in + i);
+      auto const low = _mm_loadu_si128(load);
+      auto const high = _mm_loadu_si128(load + 1);
+      auto const wide = _mm_and_si128(_mm_or_si128(low, high), nonAscii);
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(wide, zero)) != 0xFFFF) {
+        break;
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                       _mm_packus_epi16(low, high));
+    }
+  }
+#endif
+  for (; n - i >= kUtfBlock && unchanged_block<To>(in + i); i += kUtfBlock) {
+    for (std::size_t k = 0; k < kUtfBlock; ++k) {
+      out[i + k] = static_cast<To>(in[i + k]);
+    }
+  }
+  return i;
+}
+
+// Transcodes the `n` units at `in` to the `utf_length<To>(in, n)` units at
+// `out`, throwing `std::range_error` if they are not valid
+template <typename To, typename From>
+void transcode_utf(To* out, From const* in, std::size_t n) {
+  std::size_t i = 0;
+  while (i < n) {
+    auto const copied = copy_unchanged(out, in + i, n - i);
+    out += copied;
+    i += copied;
+    // The rest of a block that didn't qualify goes one code point at a time
+    for (auto const stop = std::min(n, i + 16); i < stop;) {
+      out = encode_utf(out, decode_utf(in, n, i));
+    }
+  }
+}
+
+// Compares `lhs` with `rhs` transcoded to `CharT`, unit by unit as
+// `std::char_traits` would, transcoding only as far as the first
+// difference
+template <typename CharT, typename From>
+int compare_utf(CharT const* lhs,
+                std::size_t lhsSize,
+                From const* rhs,
+                std::size_t rhsSize) {
+  std::size_t i = 0;
+  std::size_t j = 0;
+  CharT units[4 / sizeof(CharT)];
+  while (j < rhsSize) {
+    auto const* const end = encode_utf(units, decode_utf(rhs, rhsSize, j));
+    for (auto const* unit = units; unit != end; ++unit, ++i) {
+      if (i == lhsSize) {
+        return -1;
+      }
+      auto const l = utf_unit(lhs[i]);
+      auto const r = utf_unit(*unit);
+      if (l != r) {
+        return l < r ? -1 : 1;
+      }
+    }
+  }
+  return i == lhsSize ? 0 : 1;
+}
+}  // namespace detail
+
+// Adaptor to a string in one of the UTF encodings from a `basic_string_view`
+// in any of the others, so that (say) a `std::string_view` of UTF-8 can be
+// inserted straight into a container keyed by `std::u16string`. The
+// encoding is taken from the size of the character type: `char` (and
+// `char8_t`) is UTF-8, `char16_t` UTF-16 and `char32_t` UTF-32. Input is
+// validated as it is transcoded; overlong forms, unpaired surrogates and
+// anything past U+10FFFF throw `std::range_error`, as `std::wstring_convert`
+// did. Views in the target's own encoding are left to
+// `basic_string_adaptor`, which can be combined with this by
+// `union_adaptor`. Containers look a source up before adapting it, so they
+// need `basic_utf_hash` and `basic_utf_equal`, or `basic_utf_less`, too.
+template <typename CharT,
+          typename Traits = std::char_traits<CharT>,
+          typename Allocator = std::allocator<CharT>>
+struct basic_utf_adaptor {
+  using target_type = std::basic_string<CharT, Traits, Allocator>;
+  template <typename X>
+  static bool constexpr adapts{
+      detail::transcodes_to<CharT, std::decay_t<X>>::value};
+
+  template <typename From, typename FromTraits>
+  std::enable_if_t<adapts<std::basic_string_view<From, FromTraits>>> adapt(
+      target_type* pResult,
+      std::basic_string_view<From, FromTraits> const& input) {
+    ::new (static_cast<void*>(pResult)) target_type();
+    fill(pResult, input);
+  }
+  template <typename From, typename FromTraits>
+  std::enable_if_t<adapts<std::basic_string_view<From, FromTraits>>>
+  operator()(target_type* pResult,
+             std::basic_string_view<From, FromTraits> const& input) {
+    adapt(pResult, input);
+  }
+  template <typename From, typename FromTraits, typename Alloc>
+  std::enable_if_t<adapts<std::basic_string_view<From, FromTraits>>> adapt(
+      target_type* pResult,
+      std::basic_string_view<From, FromTraits> const& input,
+      Alloc const& alloc) {
+    detail::construct_using_allocator(pResult, alloc);
+    fill(pResult, input);
+  }
+  template <typename From, typename FromTraits, typename Alloc>
+  std::enable_if_t<adapts<std::basic_string_view<From, FromTraits>>>
+  operator()(target_type* pResult,
+             std::basic_string_view<From, FromTraits> const& input,
+             Alloc const& alloc) {
+    adapt(pResult, input, alloc);
+  }
+
+ private:
+  // Sizes the string exactly, then transcodes into it
+  template <typename From, typename FromTraits>
+  static void fill(target_type* pResult,
+                   std::basic_string_view<From, FromTraits> const& input) {
+    try {
+      pResult->resize(detail::utf_length<CharT>(input.data(), input.size()));
+      detail::transcode_utf(pResult->data(), input.data(), input.size());
+    } catch (...) {
+      pResult->~target_type();
+      throw;
+    }
+  }
+};
+
+// Transparent hash for strings of `CharT` that also accepts views in the
+// other UTF encodings, hashing them as their transcoding to `CharT`. With
+// `basic_utf_equal` or `basic_utf_less`, it lets a container keyed by one
+// encoding be queried in another, and so `basic_utf_adaptor` be used for
+// insertion. Invalid input throws `std::range_error`.
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+struct basic_utf_hash : basic_transparent_string_hash<CharT, Traits> {
+  using basic_transparent_string_hash<CharT, Traits>::operator();
+
+  template <typename From, typename FromTraits>
+  std::enable_if_t<
+      detail::transcodes_to<CharT, std::basic_string_view<From, FromTraits>>::
+          value,
+      std::size_t>
+  operator()(std::basic_string_view<From, FromTraits> input) const {
+    auto const length = detail::utf_length<CharT>(input.data(), input.size());
+    if (length <= kOnStack) {
+      CharT buffer[kOnStack];
+      detail::transcode_utf(buffer, input.data(), input.size());
+      return (*this)(std::basic_string_view<CharT, Traits>{buffer, length});
+    }
+    std::basic_string<CharT, Traits> buffer(length, CharT{});
+    detail::transcode_utf(buffer.data(), input.data(), input.size());
+    return (*this)(std::basic_string_view<CharT, Traits>{buffer});
+  }
+
+ private:
+  static constexpr std::size_t kOnStack = 256;
+};
+
+// Transparent equality matching `basic_utf_hash`
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+struct basic_utf_equal : basic_transparent_string_equal<CharT, Traits> {
+  using basic_transparent_string_equal<CharT, Traits>::operator();
+
+  template <typename From, typename FromTraits>
+  std::enable_if_t<
+      detail::transcodes_to<CharT, std::basic_string_view<From, FromTraits>>::
+          value,
+      bool>
+  operator()(std::basic_string_view<CharT, Traits> lhs,
+             std::basic_string_view<From, FromTraits> rhs) const {
+    return detail::compare_utf(lhs.data(), lhs.size(), rhs.data(),
+                               rhs.size()) == 0;
+  }
+  template <typename From, typename FromTraits>
+  std::enable_if_t<
+      detail::transcodes_to<CharT, std::basic_string_view<From, FromTraits>>::
+          value,
+      bool>
+  operator()(std::basic_string_view<From, FromTraits> lhs,
+             std::basic_string_view<CharT, Traits> rhs) const {
+    return (*this)(rhs, lhs);
+  }
+};
+
+// Transparent ordering of strings of `CharT` by code unit, as `std::less<>`
+// orders them, that also accepts views in the other UTF encodings
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+struct basic_utf_less {
+  using is_transparent = void;
+
+  bool operator()(std::basic_string_view<CharT, Traits> lhs,
+                  std::basic_string_view<CharT, Traits> rhs) const noexcept {
+    return lhs < rhs;
+  }
+  template <typename From, typename FromTraits>
+  std::enable_if_t<
+      detail::transcodes_to<CharT, std::basic_string_view<From, FromTraits>>::
+          value,
+      bool>
+  operator()(std::basic_string_view<CharT, Traits> lhs,
+             std::basic_string_view<From, FromTraits> rhs) const {
+    return detail::compare_utf(lhs.data(), lhs.size(), rhs.data(),
+                               rhs.size()) < 0;
+  }
+  template <typename From, typename FromTraits>
+  std::enable_if_t<
+      detail::transcodes_to<CharT, std::basic_string_view<From, FromTraits>>::
+          value,
+      bool>
+  operator()(std::basic_string_view<From, FromTraits> lhs,
+             std::basic_string_view<CharT, Traits> rhs) const {
+    return detail::compare_utf(rhs.data(), rhs.size(), lhs.data(),
+                               lhs.size()) > 0;
+  }
+};
+
+using utf8_adaptor = basic_utf_adaptor<char>;
+using utf16_adaptor = basic_utf_adaptor<char16_t>;
+using utf32_adaptor = basic_utf_adaptor<char32_t>;
+using wide_utf_adaptor = basic_utf_adaptor<wchar_t>;
+using utf8_hash = basic_utf_hash<char>;
+using utf16_hash = basic_utf_hash<char16_t>;
+using utf32_hash = basic_utf_hash<char32_t>;
+using utf8_equal = basic_utf_equal<char>;
+using utf16_equal = basic_utf_equal<char16_t>;
+using utf32_equal = basic_utf_equal<char32_t>;
+using utf8_less = basic_utf_less<char>;
+using utf16_less = basic_utf_less<char16_t>;
+using utf32_less = basic_utf_less<char32_t>;
+
+namespace pmr {
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+using basic_utf_adaptor =
+    proposed::basic_utf_adaptor<CharT,
+                                Traits,
+                                std::pmr::polymorphic_allocator<CharT>>;
+using utf8_adaptor = basic_utf_adaptor<char>;
+using utf16_adaptor = basic_utf_adaptor<char16_t>;
+using utf32_adaptor = basic_utf_adaptor<char32_t>;
+using wide_utf_adaptor = basic_utf_adaptor<wchar_t>;
+}  // namespace pmr
+}  // namespace proposed
@@ -0,0 +1,136 @@
+#include <proposed/map>
+#include <proposed/persistent_map>
+#include <proposed/string>
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Publishing a new version of a map after each update, as a service
+// handing out consistent snapshots of its configuration would. The
+// baseline copies a proposed::map per version; the persistent map returns
+// one from the update.
+
+namespace {
+using Map = proposed::map<std::string,
+                          std::uint64_t,
+                          std::less<>,
+                          std::allocator<std::pair<const std::string,
+                                                   std::uint64_t>>,
+                          proposed::string_adaptor>;
+using PersistentMap = proposed::persistent_map<
+    std::string,
+    std::uint64_t,
+    std::less<>,
+    std::allocator<std::pair<const std::string, std::uint64_t>>,
+    proposed::string_adaptor>;
+
+std::vector<std::string> makeKeys(std::size_t count) {
+  std::vector<std::string> result;
+  char buffer[40];
+  for (std::size_t i = 0; i < count; ++i) {
+    std::snprintf(buffer, sizeof(buffer), "a-longish-key-%012zu",
+                  (i * 2654435761U) % count);
+    result.emplace_back(buffer);
+  }
+  return result;
+}
+
+void BM_MapCopyPerVersion(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  Map current;
+  for (auto const& key : keys) {
+    current.try_emplace(std::string_view{key}, 0);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    Map next = current;
+    next.insert_or_assign(std::string_view{keys[i++ % keys.size()]}, i);
+    current = std::move(next);
+    benchmark::DoNotOptimize(current);
+  }
+}
+
+void BM_PersistentMapPerVersion(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  PersistentMap current;
+  for (auto const& key : keys) {
+    current = current.try_emplace(std::string_view{key}, 0);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    current =
+        current.insert_or_assign(std::string_view{keys[i++ % keys.size()]}, i);
+    benchmark::DoNotOptimize(current);
+  }
+}
+
+void BM_MapFind(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  Map map;
+  for (auto const& key : keys) {
+    map.try_emplace(std::string_view{key}, 0);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        map.find(std::string_view{keys[(i += 7919) % keys.size()]}));
+  }
+}
+
+void BM_PersistentMapFind(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  PersistentMap map;
+  for (auto const& key : keys) {
+    map = map.try_emplace(std::string_view{key}, 0);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        map.count(std::string_view{keys[(i += 7919) % keys.size()]}));
+  }
+}
+
+void BM_PersistentMapLowerBound(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  PersistentMap map;
+  for (auto const& key : keys) {
+    map = map.try_emplace(std::string_view{key}, 0);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        map.lower_bound(std::string_view{keys[(i += 7919) % keys.size()]}));
+  }
+}
+
+void BM_PersistentMapIterate(benchmark::State& state) {
+  auto const keys = makeKeys(state.range(0));
+  PersistentMap map;
+  for (auto const& key : keys) {
+    map = map.try_emplace(std::string_view{key}, 1);
+  }
+  for (auto _ : state) {
+    std::uint64_t total = 0;
+    for (auto const& element : map) {
+      total += element.second;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+void keyCounts(benchmark::internal::Benchmark* b) {
+  b->Arg(1 << 10)->Arg(1 << 15)->Arg(1 << 18);
+}
+}  // namespace
+
+BENCHMARK(BM_MapCopyPerVersion)->Apply(keyCounts);
+BENCHMARK(BM_PersistentMapPerVersion)->Apply(keyCounts);
+BENCHMARK(BM_MapFind)->Apply(keyCounts);
+BENCHMARK(BM_PersistentMapFind)->Apply(keyCounts);
+BENCHMARK(BM_PersistentMapLowerBound)->Apply(keyCounts);
+BENCHMARK(BM_PersistentMapIterate)->Apply(keyCounts);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,742 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <proposed/adaptor>
+#include <proposed/iterator>
+
+namespace proposed {
+// An immutable ordered map. Copies are snapshots and cost O(1); "updates"
+// (`try_emplace`, `insert_or_assign`, `erase`) leave the map alone and
+// return a new version, sharing all but O(log n) of its structure with the
+// old one. Versions may be read, copied and destroyed from any number of
+// threads at once.
+//
+// It is an AVL tree updated by path copying. Keys and mapped values each
+// live in their own counted cell, so copying a path copies pointers, and
+// replacing a value shares the key it had: a key is only built, by copying
+// or adapting, for an element that is new. Dereferencing an iterator gives
+// a pair of references into the two cells.
+template <class Key,
+          class T,
+          class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>,
+          class KeyAdaptor = no_adaptor>
+struct persistent_map {
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using reference = std::pair<Key const&, T const&>;
+  using const_reference = reference;
+
+ private:
+  using key_adaptor = KeyAdaptor;
+
+  template <typename V>
+  struct cell {
+    cell() {}
+    ~cell() {}
+    mutable std::atomic<std::size_t> refs{1};
+    union {
+      V value;
+    };
+  };
+  using key_cell = cell<Key>;
+  using mapped_cell = cell<T>;
+
+  struct element {
+    key_cell const* key;
+    mapped_cell const* mapped;
+  };
+
+  struct node {
+    mutable std::atomic<std::size_t> refs{1};
+    node const* left;
+    node const* right;
+    element item;
+    int height;
+  };
+
+  // An AVL tree of n nodes is less than 1.45 log2(n + 2) high, and fewer
+  // than 2^59 nodes fit in memory
+  static constexpr int kMaxHeight = 88;
+
+  template <typename V>
+  using cell_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<cell<V>>;
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+ public:
+  // A forward iterator. Without parent pointers, it keeps the turns taken
+  // on the way down to its node, one bit per level, and the few deepest
+  // ancestors still to be visited. Stepping up to an ancestor takes the
+  // deepest of those; once they run out, it walks down again from the root
+  // along the turns, comparing no keys.
+  struct const_iterator {
+    using difference_type = std::ptrdiff_t;
+    using value_type = typename persistent_map::value_type;
+    using reference = typename persistent_map::reference;
+    using pointer = detail::arrow_proxy<reference>;
+    using iterator_category = std::forward_iterator_tag;
+
+    const_iterator() = default;
+
+    reference operator*() const {
+      return {node_->item.key->value, node_->item.mapped->value};
+    }
+    pointer operator->() const { return {**this}; }
+
+    const_iterator& operator++() {
+      if (node_->right) {
+        step(true);
+        step_leftmost();
+      } else if (lefts_ == 0) {
+        node_ = nullptr;
+      } else {
+        // Up to the nearest ancestor we went left at
+        --lefts_;
+        if (pendingCount_ > 0) {
+          --pendingCount_;
+          --pendingTop_;
+          node_ = pending_[pendingTop_ % kPending];
+          depth_ = pendingDepth_[pendingTop_ % kPending];
+        } else {
+          int depth = depth_ - 1;
+          while (went_right(depth)) {
+            --depth;
+          }
+          node_ = root_;
+          for (depth_ = 0; depth_ < depth; ++depth_) {
+            if (went_right(depth_)) {
+              node_ = node_->right;
+            } else {
+              push();
+              node_ = node_->left;
+            }
+          }
+        }
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto result = *this;
+      ++*this;
+      return result;
+    }
+
+    friend bool operator==(const_iterator const& lhs,
+                           const_iterator const& rhs) {
+      return lhs.node_ == rhs.node_;
+    }
+    friend bool operator!=(const_iterator const& lhs,
+                           const_iterator const& rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    friend struct persistent_map;
+
+    explicit const_iterator(node const* root) : root_(root), node_(root) {}
+
+    bool went_right(int level) const {
+      return (turns_[level / 64] >> (level % 64)) & 1;
+    }
+    // Down to a child of the current node, which may be null
+    void step(bool right) {
+      auto const bit = std::uint64_t{1} << (depth_ % 64);
+      if (right) {
+        turns_[depth_ / 64] |= bit;
+        node_ = node_->right;
+      } else {
+        turns_[depth_ / 64] &= ~bit;
+        push();
+        ++lefts_;
+        node_ = node_->left;
+      }
+      ++depth_;
+    }
+    void step_leftmost() {
+      while (node_->left) {
+        step(false);
+      }
+    }
+    // `pending_` is a ring keeping the deepest of the ancestors we went
+    // left at, with their depths in `pendingDepth_`
+    void push() {
+      pending_[pendingTop_ % kPending] = node_;
+      pendingDepth_[pendingTop_ % kPending] = depth_;
+      ++pendingTop_;
+      if (pendingCount_ < kPending) {
+        ++pendingCount_;
+      }
+    }
+
+    static constexpr unsigned kPending = 8;
+    static_assert(kMaxHeight <= 128 && 256 % kPending == 0,
+                  "The turns fit in two words, and `pendingTop_` may wrap");
+    node const* root_ = nullptr;
+    node const* node_ = nullptr;
+    // Bit `i` is set if the path went right at depth `i`
+    std::uint64_t turns_[2] = {};
+    // The depth of `node_`, the root's being 0, and how many times the path
+    // to it went left
+    unsigned char depth_ = 0;
+    unsigned char lefts_ = 0;
+    unsigned char pendingTop_ = 0;
+    unsigned char pendingCount_ = 0;
+    unsigned char pendingDepth_[kPending] = {};
+    node const* pending_[kPending] = {};
+  };
+  using iterator = const_iterator;
+
+  persistent_map() : persistent_map(Compare{}) {}
+  explicit persistent_map(Compare const& compare,
+                          Allocator const& alloc = Allocator{})
+      : compare_(compare), alloc_(alloc) {}
+  explicit persistent_map(Allocator const& alloc)
+      : persistent_map(Compare{}, alloc) {}
+  persistent_map(std::initializer_list<value_type> ilist,
+                 Compare const& compare = Compare{},
+                 Allocator const& alloc = Allocator{})
+      : persistent_map(compare, alloc) {
+    for (auto const& value : ilist) {
+      *this = insert_or_assign(value.first, value.second);
+    }
+  }
+
+  persistent_map(persistent_map const& other)
+      : root_(retain(other.root_)),
+        size_(other.size_),
+        compare_(other.compare_),
+        alloc_(other.alloc_),
+        keyAdaptor_(other.keyAdaptor_) {}
+  persistent_map(persistent_map&& other) noexcept
+      : root_(std::exchange(other.root_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        compare_(other.compare_),
+        alloc_(other.alloc_),
+        keyAdaptor_(other.keyAdaptor_) {}
+  persistent_map& operator=(persistent_map other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~persistent_map() { release(root_); }
+
+  void swap(persistent_map& other) noexcept {
+    using std::swap;
+    swap(root_, other.root_);
+    swap(size_, other.size_);
+    swap(compare_, other.compare_);
+    // Versions share nodes, so they must share an allocator too: one that
+    // doesn't propagate must already be equal
+    if constexpr (std::allocator_traits<
+                      Allocator>::propagate_on_container_swap::value) {
+      swap(alloc_, other.alloc_);
+    }
+    swap(keyAdaptor_, other.keyAdaptor_);
+  }
+
+  const_iterator begin() const noexcept {
+    const_iterator result{root_};
+    if (root_) {
+      result.step_leftmost();
+    }
+    return result;
+  }
+  const_iterator end() const noexcept { return {}; }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  key_compare key_comp() const { return compare_; }
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+  const_iterator find(key_type const& key) const { return find_impl(key); }
+  template <typename K,
+            typename C = Compare,
+            typename = std::enable_if_t<detail::is_transparent<C>::value>>
+  const_iterator find(K const& key) const {
+    return find_impl(key);
+  }
+
+  const_iterator lower_bound(key_type const& key) const {
+    return lower_bound_impl(key);
+  }
+  template <typename K,
+            typename C = Compare,
+            typename = std::enable_if_t<detail::is_transparent<C>::value>>
+  const_iterator lower_bound(K const& key) const {
+    return lower_bound_impl(key);
+  }
+
+  size_type count(key_type const& key) const { return find_node(key) ? 1 : 0; }
+  template <typename K,
+            typename C = Compare,
+            typename = std::enable_if_t<detail::is_transparent<C>::value>>
+  size_type count(K const& key) const {
+    return find_node(key) ? 1 : 0;
+  }
+
+  T const& at(key_type const& key) const { return at_impl(key); }
+  template <typename K,
+            typename C = Compare,
+            typename = std::enable_if_t<detail::is_transparent<C>::value>>
+  T const& at(K const& key) const {
+    return at_impl(key);
+  }
+
+  // Versions with `key` mapped to a value built from `args`, or this
+  // version if `key` is already present
+  template <class... Args>
+  [[nodiscard]] persistent_map try_emplace(key_type const& key,
+                                           Args&&... args) const {
+    return with(key, false, construct_key(key), std::forward<Args>(args)...);
+  }
+  template <class... Args>
+  [[nodiscard]] persistent_map try_emplace(key_type&& key,
+                                           Args&&... args) const {
+    return with(key, false, construct_key(std::move(key)),
+                std::forward<Args>(args)...);
+  }
+
+  // Versions with `key` mapped to `obj`, whether or not it was present
+  template <class M>
+  [[nodiscard]] persistent_map insert_or_assign(key_type const& key,
+                                                M&& obj) const {
+    return with(key, true, construct_key(key), std::forward<M>(obj));
+  }
+  template <class M>
+  [[nodiscard]] persistent_map insert_or_assign(key_type&& key,
+                                                M&& obj) const {
+    return with(key, true, construct_key(std::move(key)),
+                std::forward<M>(obj));
+  }
+
+  // The version without `key`
+  [[nodiscard]] persistent_map erase(key_type const& key) const {
+    return without(key);
+  }
+  template <typename K,
+            typename C = Compare,
+            typename = std::enable_if_t<detail::is_transparent<C>::value>>
+  [[nodiscard]] persistent_map erase(K const& key) const {
+    return without(key);
+  }
+
+ private:
+  template <typename AdaptableType>
+  static bool constexpr is_write_adaptable() {
+    return detail::is_write_adaptable_v<Key, iterator, const_iterator,
+                                        key_adaptor, AdaptableType>;
+  }
+
+  // Owns one reference to a node
+  struct node_ref {
+    node_ref(persistent_map const& owner, node const* n) noexcept
+        : owner_(owner), n_(n) {}
+    node_ref(node_ref const&) = delete;
+    node_ref& operator=(node_ref const&) = delete;
+    ~node_ref() { owner_.release(n_); }
+    node const* get() const noexcept { return n_; }
+    node const* release() noexcept { return std::exchange(n_, nullptr); }
+
+   private:
+    persistent_map const& owner_;
+    node const* n_;
+  };
+
+  template <typename KT>
+  auto construct_key(KT&& key) const {
+    return [this, &key](key_type* p) {
+      detail::construct_using_allocator(p, alloc_, std::forward<KT>(key));
+    };
+  }
+
+  static node const* retain(node const* n) noexcept {
+    if (n) {
+      n->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    return n;
+  }
+  template <typename V>
+  static cell<V> const* retain(cell<V> const* c) noexcept {
+    c->refs.fetch_add(1, std::memory_order_relaxed);
+    return c;
+  }
+  static element retain(element e) noexcept {
+    return {retain(e.key), retain(e.mapped)};
+  }
+
+  template <typename V>
+  void release(cell<V> const* c) const noexcept {
+    if (c->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      auto* mutableCell = const_cast<cell<V>*>(c);
+      mutableCell->value.~V();
+      mutableCell->~cell();
+      cell_allocator<V> alloc{alloc_};
+      std::allocator_traits<cell_allocator<V>>::deallocate(alloc, mutableCell,
+                                                           1);
+    }
+  }
+  void release(element e) const noexcept {
+    release(e.key);
+    release(e.mapped);
+  }
+
+  void release(node const* n) const noexcept {
+    // Iterative along the left spine, recursive (so O(log n) deep) to the
+    // right
+    while (n && n->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      auto const* left = n->left;
+      release(n->right);
+      release(n->item);
+      auto* mutableNode = const_cast<node*>(n);
+      mutableNode->~node();
+      node_allocator alloc{alloc_};
+      node_traits::deallocate(alloc, mutableNode, 1);
+      n = left;
+    }
+  }
+
+  static int height(node const* n) noexcept { return n ? n->height : 0; }
+
+  // A new node over borrowed children and item, which it retains
+  node const* make_node(node const* left,
+                        element item,
+                        node const* right) const {
+    node_allocator alloc{alloc_};
+    auto* n = node_traits::allocate(alloc, 1);
+    ::new (static_cast<void*>(n)) node{};
+    n->left = retain(left);
+    n->right = retain(right);
+    n->item = retain(item);
+    n->height = 1 + std::max(height(left), height(right));
+    return n;
+  }
+
+  // As `make_node`, but taking over the caller's references to `item`
+  node const* adopt_element(node const* left,
+                            element item,
+                            node const* right) const {
+    try {
+      auto const* result = make_node(left, item, right);
+      release(item);
+      return result;
+    } catch (...) {
+      release(item);
+      throw;
+    }
+  }
+
+  node_ref owned(node const* n) const noexcept { return {*this, n}; }
+
+  // As `make_node`, rebalancing if one side is two higher than the other,
+  // which is as far apart as an update can leave them
+  node const* balance(node const* left,
+                      element item,
+                      node const* right) const {
+    int const hl = height(left);
+    int const hr = height(right);
+    if (hl > hr + 1) {
+      if (height(left->left) >= height(left->right)) {
+        auto newRight = owned(make_node(left->right, item, right));
+        return make_node(left->left, left->item, newRight.get());
+      }
+      auto const* pivot = left->right;
+      auto newLeft = owned(make_node(left->left, left->item, pivot->left));
+      auto newRight = owned(make_node(pivot->right, item, right));
+      return make_node(newLeft.get(), pivot->item, newRight.get());
+    }
+    if (hr > hl + 1) {
+      if (height(right->right) >= height(right->left)) {
+        auto newLeft = owned(make_node(left, item, right->left));
+        return make_node(newLeft.get(), right->item, right->right);
+      }
+      auto const* pivot = right->left;
+      auto newLeft = owned(make_node(left, item, pivot->left));
+      auto newRight = owned(make_node(pivot->right, right->item, right->right));
+      return make_node(newLeft.get(), pivot->item, newRight.get());
+    }
+    return make_node(left, item, right);
+  }
+
+  // A new cell, owned by the caller, whose value is built by `make`
+  template <typename V, typename Make>
+  cell<V> const* make_cell(Make&& make) const {
+    cell_allocator<V> alloc{alloc_};
+    using traits = std::allocator_traits<cell_allocator<V>>;
+    auto* c = traits::allocate(alloc, 1);
+    ::new (static_cast<void*>(c)) cell<V>{};
+    try {
+      make(std::addressof(c->value));
+    } catch (...) {
+      c->~cell();
+      traits::deallocate(alloc, c, 1);
+      throw;
+    }
+    return c;
+  }
+
+  template <typename... Args>
+  mapped_cell const* make_mapped(Args&&... args) const {
+    return make_cell<T>([&](T* p) {
+      detail::construct_using_allocator(p, alloc_, std::forward<Args>(args)...);
+    });
+  }
+
+  // A new element, owned by the caller, whose key is built by `make_key`
+  template <typename MakeKey, typename... Args>
+  element make_element(MakeKey& make_key, Args&&... args) const {
+    auto const* key = make_cell<Key>(make_key);
+    try {
+      return {key, make_mapped(std::forward<Args>(args)...)};
+    } catch (...) {
+      release(key);
+      throw;
+    }
+  }
+
+  template <typename K>
+  node const* find_node(K const& key) const {
+    auto const* n = root_;
+    while (n) {
+      if (compare_(key, n->item.key->value)) {
+        n = n->left;
+      } else if (compare_(n->item.key->value, key)) {
+        n = n->right;
+      } else {
+        return n;
+      }
+    }
+    return nullptr;
+  }
+
+  template <typename K>
+  const_iterator lower_bound_impl(K const& key) const {
+    const_iterator result{root_};
+    // The last node we went left at is the lower bound, and the turns on
+    // the way to it are already recorded
+    node const* bound = nullptr;
+    unsigned char boundDepth = 0;
+    while (result.node_) {
+      if (compare_(result.node_->item.key->value, key)) {
+        result.step(true);
+      } else {
+        bound = result.node_;
+        boundDepth = result.depth_;
+        result.step(false);
+      }
+    }
+    if (bound) {
+      // The last step left made the bound itself pending
+      --result.lefts_;
+      --result.pendingCount_;
+      --result.pendingTop_;
+    }
+    result.node_ = bound;
+    result.depth_ = boundDepth;
+    return result;
+  }
+
+  template <typename K>
+  const_iterator find_impl(K const& key) const {
+    auto result = lower_bound_impl(key);
+    if (result == end() || compare_(key, result->first)) {
+      return end();
+    }
+    return result;
+  }
+
+  template <typename K>
+  T const& at_impl(K const& key) const {
+    auto const* n = find_node(key);
+    if (!n) {
+      throw std::out_of_range{"No such key in map"};
+    }
+    return n->item.mapped->value;
+  }
+
+  // The subtree `n` with `key` added, using a new element built from
+  // `make_key` and `args`, or if `assign` with its value replaced by one
+  // built from `args`; nullptr if unchanged
+  template <typename K, typename MakeKey, typename... Args>
+  node const* insert_rec(node const* n,
+                         K const& key,
+                         bool assign,
+                         bool& added,
+                         MakeKey& make_key,
+                         Args&&... args) const {
+    if (!n) {
+      added = true;
+      return adopt_element(
+          nullptr, make_element(make_key, std::forward<Args>(args)...),
+          nullptr);
+    }
+    auto const& nodeKey = n->item.key->value;
+    if (compare_(key, nodeKey)) {
+      auto left = owned(insert_rec(n->left, key, assign, added, make_key,
+                                   std::forward<Args>(args)...));
+      return left.get() ? balance(left.get(), n->item, n->right) : nullptr;
+    }
+    if (compare_(nodeKey, key)) {
+      auto right = owned(insert_rec(n->right, key, assign, added, make_key,
+                                    std::forward<Args>(args)...));
+      return right.get() ? balance(n->left, n->item, right.get()) : nullptr;
+    }
+    if (!assign) {
+      return nullptr;
+    }
+    // The old value belongs to other versions too, so it gets a new cell;
+    // the key's cell is shared with them
+    auto const* mapped = make_mapped(std::forward<Args>(args)...);
+    return adopt_element(n->left, {retain(n->item.key), mapped}, n->right);
+  }
+
+  template <typename K, typename MakeKey, typename... Args>
+  persistent_map with(K const& key,
+                      bool assign,
+                      MakeKey&& make_key,
+                      Args&&... args) const {
+    bool added = false;
+    auto root = owned(insert_rec(root_, key, assign, added, make_key,
+                                 std::forward<Args>(args)...));
+    if (!root.get()) {
+      return *this;
+    }
+    return persistent_map{*this, root.release(), size_ + added};
+  }
+
+  // The subtree `n` without its leftmost node, whose element goes to `min`
+  node const* remove_min(node const* n, element& min) const {
+    if (!n->left) {
+      min = n->item;
+      return retain(n->right);
+    }
+    auto left = owned(remove_min(n->left, min));
+    return balance(left.get(), n->item, n->right);
+  }
+
+  // The subtree `n` without `key`; `n` itself, retained, if unchanged
+  template <typename K>
+  node const* erase_rec(node const* n, K const& key, bool& removed) const {
+    if (!n) {
+      return nullptr;
+    }
+    auto const& nodeKey = n->item.key->value;
+    if (compare_(key, nodeKey)) {
+      auto left = owned(erase_rec(n->left, key, removed));
+      return removed ? balance(left.get(), n->item, n->right) : retain(n);
+    }
+    if (compare_(nodeKey, key)) {
+      auto right = owned(erase_rec(n->right, key, removed));
+      return removed ? balance(n->left, n->item, right.get()) : retain(n);
+    }
+    removed = true;
+    if (!n->right) {
+      return retain(n->left);
+    }
+    element successor{};
+    auto right = owned(remove_min(n->right, successor));
+    return balance(n->left, successor, right.get());
+  }
+
+  template <typename K>
+  persistent_map without(K const& key) const {
+    bool removed = false;
+    auto root = owned(erase_rec(root_, key, removed));
+    if (!removed) {
+      return *this;
+    }
+    return persistent_map{*this, root.release(), size_ - 1};
+  }
+
+  // A version like `other` but with the given tree, whose reference it takes
+  persistent_map(persistent_map const& other, node const* root, size_type size)
+      : root_(root),
+        size_(size),
+        compare_(other.compare_),
+        alloc_(other.alloc_),
+        keyAdaptor_(other.keyAdaptor_) {}
+
+  node const* root_ = nullptr;
+  size_type size_ = 0;
+  Compare compare_;
+  Allocator alloc_;
+  key_adaptor keyAdaptor_;
+  static_assert(!adaptor_traits<key_adaptor>::is_adaptor ||
+                std::is_same_v<key_type, typename key_adaptor::target_type>);
+
+ public:
+  template <typename AdaptableType, typename... Args>
+  [[nodiscard]] typename std::enable_if<is_write_adaptable<AdaptableType>(),
+                                        persistent_map>::type
+  try_emplace(AdaptableType&& key, Args&&... args) const {
+    return with(key, false, adapt_key(std::forward<AdaptableType>(key)),
+                std::forward<Args>(args)...);
+  }
+
+  template <typename AdaptableType, typename M>
+  [[nodiscard]] typename std::enable_if<is_write_adaptable<AdaptableType>(),
+                                        persistent_map>::type
+  insert_or_assign(AdaptableType&& key, M&& obj) const {
+    return with(key, true, adapt_key(std::forward<AdaptableType>(key)),
+                std::forward<M>(obj));
+  }
+
+ private:
+  template <typename AdaptableType>
+  auto adapt_key(AdaptableType&& key) const {
+    return [this, &key](key_type* p) {
+      detail::adapt_using_allocator(const_cast<key_adaptor&>(keyAdaptor_),
+                                    p,
+                                    std::forward<AdaptableType>(key),
+                                    alloc_);
+    };
+  }
+};
+
+template <class Key, class T, class Compare, class Allocator, class KeyAdaptor>
+bool operator==(
+    persistent_map<Key, T, Compare, Allocator, KeyAdaptor> const& lhs,
+    persistent_map<Key, T, Compare, Allocator, KeyAdaptor> const& rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+template <class Key, class T, class Compare, class Allocator, class KeyAdaptor>
+bool operator!=(
+    persistent_map<Key, T, Compare, Allocator, KeyAdaptor> const& lhs,
+    persistent_map<Key, T, Compare, Allocator, KeyAdaptor> const& rhs) {
+  return !(lhs == rhs);
+}
+
+namespace pmr {
+template <class Key,
+          class T,
+          class Compare = std::less<Key>,
+          class KeyAdaptor = no_adaptor>
+using persistent_map = proposed::persistent_map<
+    Key,
+    T,
+    Compare,
+    std::pmr::polymorphic_allocator<std::pair<const Key, T>>,
+    KeyAdaptor>;
+}  // namespace pmr
+}  // namespace proposed
@@ -0,0 +1,166 @@
+#include <proposed/persistent_map>
+#include <proposed/string>
+#include <gtest/gtest.h>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using MapType =
+    proposed::persistent_map<std::string,
+                             int,
+                             std::less<>,
+                             std::allocator<std::pair<const std::string, int>>,
+                             proposed::string_adaptor>;
+
+using namespace std::literals;
+
+// Iterators are copied by every lookup, so they stay small
+static_assert(sizeof(MapType::const_iterator) <= 16 * sizeof(void*));
+
+namespace {
+struct counting_adaptor : proposed::string_adaptor {
+  void adapt(target_type* pResult, std::string_view const& input) {
+    ++adapted;
+    proposed::string_adaptor::adapt(pResult, input);
+  }
+  static inline int adapted = 0;
+};
+
+template <typename Map>
+std::vector<std::pair<std::string, int>> contents(Map const& map) {
+  return {map.begin(), map.end()};
+}
+}  // namespace
+
+TEST(ProposedPersistentMap, Basics) {
+  MapType const empty{};
+  auto testMap = empty.try_emplace("Hello"s, 1)
+                     .try_emplace("World"sv, 2)
+                     .try_emplace("Hello"sv, 3)
+                     .insert_or_assign("Adios"sv, 5);
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(3U, testMap.size());
+  EXPECT_EQ(1, testMap.at("Hello"sv));
+  EXPECT_EQ(1U, testMap.count("World"sv));
+  EXPECT_EQ(0U, testMap.count("Goodbye"sv));
+  EXPECT_EQ(testMap.end(), testMap.find("Goodbye"sv));
+  EXPECT_EQ("Hello", testMap.lower_bound("B"sv)->first);
+  EXPECT_EQ(testMap.end(), testMap.lower_bound("Z"sv));
+  EXPECT_THROW(testMap.at("Goodbye"sv), std::out_of_range);
+  testMap = testMap.insert_or_assign("Hello"sv, 4).erase("World"sv);
+  EXPECT_EQ((std::vector<std::pair<std::string, int>>{{"Adios", 5},
+                                                     {"Hello", 4}}),
+            contents(testMap));
+}
+
+TEST(ProposedPersistentMap, Snapshots) {
+  MapType testMap{{"a", 1}, {"b", 2}, {"c", 3}};
+  auto const snapshot = testMap;
+  testMap = testMap.insert_or_assign("b"sv, 20).erase("c"sv).try_emplace(
+      "d"sv, 4);
+  EXPECT_EQ((std::vector<std::pair<std::string, int>>{
+                {"a", 1}, {"b", 2}, {"c", 3}}),
+            contents(snapshot));
+  EXPECT_EQ((std::vector<std::pair<std::string, int>>{
+                {"a", 1}, {"b", 20}, {"d", 4}}),
+            contents(testMap));
+  EXPECT_NE(snapshot, testMap);
+  EXPECT_EQ(snapshot, snapshot.erase("z"sv));
+}
+
+TEST(ProposedPersistentMap, AdaptsOnlyNewKeys) {
+  proposed::persistent_map<std::string,
+                           int,
+                           std::less<>,
+                           std::allocator<std::pair<const std::string, int>>,
+                           counting_adaptor>
+      testMap{};
+  for (int round = 0; round < 3; ++round) {
+    for (auto key : {"one"sv, "two"sv, "three"sv}) {
+      testMap = testMap.try_emplace(key, round);
+    }
+  }
+  EXPECT_EQ(3, counting_adaptor::adapted);
+  EXPECT_EQ(0, testMap.at("three"sv));
+  // Replacing a value shares the existing key rather than adapting again
+  auto const before = testMap;
+  testMap = testMap.insert_or_assign("two"sv, 9);
+  EXPECT_EQ(3, counting_adaptor::adapted);
+  EXPECT_EQ(9, testMap.at("two"sv));
+  EXPECT_EQ(0, before.at("two"sv));
+  EXPECT_EQ(&before.find("two"sv)->first, &testMap.find("two"sv)->first);
+  EXPECT_EQ(4U, testMap.insert_or_assign("four"sv, 4).size());
+  EXPECT_EQ(4, counting_adaptor::adapted);
+}
+
+TEST(ProposedPersistentMap, MatchesStdMap) {
+  std::mt19937 rng{7};
+  std::map<std::string, int, std::less<>> expected;
+  MapType testMap{};
+  std::vector<MapType> versions;
+  std::vector<std::map<std::string, int, std::less<>>> expectedVersions;
+  for (int i = 0; i < 4000; ++i) {
+    auto key = std::to_string(rng() % 1000);
+    switch (rng() % 3) {
+      case 0:
+        testMap = testMap.try_emplace(std::string_view{key}, i);
+        expected.try_emplace(key, i);
+        break;
+      case 1:
+        testMap = testMap.insert_or_assign(std::string_view{key}, i);
+        expected.insert_or_assign(key, i);
+        break;
+      default:
+        testMap = testMap.erase(std::string_view{key});
+        expected.erase(key);
+        break;
+    }
+    if (i % 500 == 0) {
+      versions.push_back(testMap);
+      expectedVersions.push_back(expected);
+    }
+  }
+  ASSERT_EQ(expected.size(), testMap.size());
+  EXPECT_EQ(contents(expected), contents(testMap));
+  for (size_t v = 0; v < versions.size(); ++v) {
+    EXPECT_EQ(contents(expectedVersions[v]), contents(versions[v]));
+  }
+  // Iterating on from a lookup, rather than from begin()
+  for (int i = 0; i < 50; ++i) {
+    auto const key = std::to_string(rng() % 1000);
+    std::vector<std::pair<std::string, int>> const expectedTail(
+        expected.lower_bound(key), expected.end());
+    std::vector<std::pair<std::string, int>> const tail(
+        testMap.lower_bound(std::string_view{key}), testMap.end());
+    EXPECT_EQ(expectedTail, tail);
+  }
+}
+
+TEST(ProposedPersistentMap, SharedBetweenThreads) {
+  MapType base{};
+  for (int i = 0; i < 1000; ++i) {
+    base = base.try_emplace(std::to_string(i), i);
+  }
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([base, t] {
+      auto mine = base;
+      for (int i = 0; i < 1000; i += 4) {
+        mine = mine.insert_or_assign(std::to_string(i + t), -1);
+      }
+      int changed = 0;
+      for (auto const& entry : mine) {
+        changed += entry.second == -1;
+      }
+      EXPECT_EQ(250, changed);
+      EXPECT_EQ(1000U, base.size());
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(999, base.at("999"sv));
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <new>
+#include <type_traits>
+
+namespace test_utils {
+// Neither copyable nor movable, so it can only be built where it will live
+struct Pinned {
+  explicit Pinned(int v) : value(v) {}
+  Pinned(Pinned const&) = delete;
+  Pinned& operator=(Pinned const&) = delete;
+  int value;
+};
+inline bool operator<(Pinned const& lhs, Pinned const& rhs) {
+  return lhs.value < rhs.value;
+}
+inline bool operator<(Pinned const& lhs, int rhs) {
+  return lhs.value < rhs;
+}
+inline bool operator<(int lhs, Pinned const& rhs) {
+  return lhs < rhs.value;
+}
+
+// Builds a `Pinned` in place from an int
+struct pinned_adaptor {
+  using target_type = Pinned;
+  template <typename X>
+  static bool constexpr adapts{std::is_same_v<X, int>};
+
+  void adapt(target_type* pResult, int input) {
+    ::new (static_cast<void*>(pResult)) target_type(input);
+  }
+};
+}  // namespace test_utils